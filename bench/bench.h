@@ -0,0 +1,39 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_BENCH_H
+#define TRADING_COMMON_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace trading::bench {
+
+    using clock_type = std::chrono::steady_clock;
+
+    // Runs fn once and returns the elapsed wall time in seconds.
+    template<typename F>
+    double measure(F &&fn) {
+        auto start = clock_type::now();
+        fn();
+        auto end = clock_type::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    inline void report(const std::string &name, size_t operations, double seconds) {
+        std::printf("%-48s %12zu ops %10.3f ms %12.1f ns/op %10.2f Mops/s\n",
+                    name.c_str(), operations, seconds * 1e3, seconds * 1e9 / (double) operations,
+                    (double) operations / seconds / 1e6);
+    }
+
+    // Keeps the optimizer from discarding a computed value.
+    template<typename T>
+    void do_not_optimize(const T &value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+}
+
+#endif //TRADING_COMMON_BENCH_H
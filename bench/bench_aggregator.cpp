@@ -0,0 +1,51 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Feeds random trades of many symbols through one BarAggregator per symbol at 1s/1m/5m/1h.
+//
+// usage: bench_aggregator [ticks] [symbols]
+
+#include <random>
+#include <vector>
+#include <trading_common/aggregator.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t ticks = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    size_t symbols = argc > 2 ? std::stoul(argv[2]) : 5'000;
+
+    std::vector<BarAggregator> aggregators;
+    aggregators.reserve(symbols);
+    size_t bars = 0;
+    for (size_t s = 0; s < symbols; ++s) {
+        aggregators.emplace_back(symbol_t("SYM" + std::to_string(s)));
+        aggregators.back().on_bar([&bars](timestamp_t, const BarAggregator::Bar &) { ++bars; });
+    }
+
+    // generated up front so only the aggregation is timed
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, symbols - 1);
+    std::normal_distribution<double> move(0, 0.01);
+    std::vector<uint32_t> symbol_of(ticks);
+    std::vector<Tick> stream(ticks);
+    timestamp_t timestamp = 1704495600;
+    double price = 100;
+    for (size_t i = 0; i < ticks; ++i) {
+        if (i % 1000 == 0) ++timestamp;
+        price += move(rng);
+        symbol_of[i] = (uint32_t) pick(rng);
+        stream[i] = {timestamp, price, 1 + i % 7};
+    }
+
+    double seconds = measure([&] {
+        for (size_t i = 0; i < ticks; ++i) {
+            aggregators[symbol_of[i]].add(stream[i]);
+        }
+    });
+    report("BarAggregator::add, " + std::to_string(symbols) + " symbols", ticks, seconds);
+    std::printf("completed bars: %zu\n", bars);
+    return 0;
+}
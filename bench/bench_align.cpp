@@ -0,0 +1,98 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Aligns a universe of minute series with gaps on one forward-filled grid: by find() probes into every
+// SeriesOHLCV map, with AlignedSeries from the maps and from columnar series, and with an AlignmentCursor.
+//
+// usage: bench_align [series] [bars per series] [threads]
+
+#include <trading_common/align.h>
+#include <random>
+#include <set>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 300;
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 10'000;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+
+    std::mt19937 rng(42);
+    std::bernoulli_distribution present(0.9);
+    std::vector<SeriesOHLCV> maps(count);
+    std::vector<ColumnarSeriesOHLCV> columnar;
+    size_t total = 0;
+    for (size_t s = 0; s < count; ++s) {
+        symbol_t symbol("S" + std::to_string(s));
+        ColumnarSeriesOHLCV series(symbol);
+        for (size_t i = 0; i < bars; ++i) {
+            if (i == 0 || present(rng)) {
+                double close = 100 + static_cast<double>(i % 97);
+                OHLCV bar(symbol, 1'700'000'000 + i * 60, close, close + 1, close - 1, close, i);
+                maps[s].insert(bar);
+                series.insert(bar);
+                ++total;
+            }
+        }
+        columnar.push_back(std::move(series));
+    }
+    std::vector<const SeriesOHLCV *> map_pointers;
+    std::vector<const ColumnarSeriesOHLCV *> columnar_pointers;
+    std::vector<ColumnsOHLCV> inputs;
+    for (size_t s = 0; s < count; ++s) {
+        map_pointers.push_back(&maps[s]);
+        columnar_pointers.push_back(&columnar[s]);
+        inputs.push_back(columnar[s].columns());
+    }
+
+    double checksum = 0;
+    double seconds = measure([&] {
+        std::set<timestamp_t> grid;
+        for (auto &series: maps) {
+            for (auto it = series.begin(); it != series.end(); ++it) {
+                grid.insert((*it).first);
+            }
+        }
+        std::vector<double> last(count);
+        for (timestamp_t t: grid) {
+            for (size_t s = 0; s < count; ++s) {
+                if (auto bar = maps[s].find(t)) {
+                    last[s] = bar->close;
+                }
+                checksum += last[s];
+            }
+        }
+    });
+    report("map probes", total, seconds);
+
+    seconds = measure([&] {
+        AlignedSeries aligned(map_pointers, AlignPolicy::FORWARD_FILL, 1);
+        checksum += aligned.columns(count - 1).close.back();
+    });
+    report("AlignedSeries from maps", total, seconds);
+
+    seconds = measure([&] {
+        AlignedSeries aligned(columnar_pointers, AlignPolicy::FORWARD_FILL, 1);
+        checksum += aligned.columns(count - 1).close.back();
+    });
+    report("AlignedSeries from columns", total, seconds);
+
+    seconds = measure([&] {
+        AlignedSeries aligned(columnar_pointers, AlignPolicy::FORWARD_FILL, threads);
+        checksum += aligned.columns(count - 1).close.back();
+    });
+    report("AlignedSeries from columns, threads", total, seconds);
+
+    seconds = measure([&] {
+        AlignmentCursor cursor(inputs);
+        while (cursor.next()) {
+            checksum += cursor.bars().back().close;
+        }
+    });
+    report("AlignmentCursor", total, seconds);
+
+    do_not_optimize(checksum);
+    return 0;
+}
@@ -0,0 +1,57 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Cold start of a series from JSON versus a memory-mapped binary file, and a full close scan over each.
+//
+// usage: bench_binary_series [bars]
+
+#include <filesystem>
+#include <fstream>
+#include <trading_common/binary_series.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 2'000'000;
+    auto dir = std::filesystem::temp_directory_path();
+    auto json_path = (dir / "bench_series.json").string();
+    auto binary_path = (dir / "bench_series.bin").string();
+
+    {
+        ColumnarSeriesOHLCV series(std::make_shared<std::string>("BENCH"));
+        series.reserve(bars);
+        for (size_t i = 0; i < bars; ++i) {
+            double base = 100.0 + (double) (i % 97) * 0.01;
+            series.insert(ColumnarSeriesOHLCV::Bar{1577836800 + i * 60, base, base + 0.5, base - 0.5, base, i});
+        }
+        std::ofstream(json_path) << series.to_json().dump();
+        write_binary(binary_path, series);
+    }
+
+    double sum = 0;
+    double seconds = measure([&] {
+        std::ifstream in(json_path);
+        ColumnarSeriesOHLCV series(json::parse(in));
+        for (double close: series.close()) sum += close;
+    });
+    report("JSON load + close scan", bars, seconds);
+
+    seconds = measure([&] {
+        MappedSeriesOHLCV series(binary_path);
+        do_not_optimize(series.size());
+    });
+    report("mmap open", bars, seconds);
+
+    seconds = measure([&] {
+        MappedSeriesOHLCV series(binary_path);
+        for (double close: series.columns().close) sum += close;
+    });
+    report("mmap open + close scan", bars, seconds);
+    do_not_optimize(sum);
+
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(binary_path);
+    return 0;
+}
@@ -0,0 +1,72 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Formats and parses the dates of a year of minute bars, against the localtime/ostringstream and
+// get_time/mktime code the library used before, and times Timestamp construction.
+//
+// usage: bench_calendar [bars]
+
+#include <trading_common/calendar.h>
+#include <trading_common/ohlc.h>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 525'600;
+    const timestamp_t first = 1704067200;
+
+    size_t total = 0;
+    double seconds = measure([&] {
+        for (size_t i = 0; i < bars; ++i) {
+            auto time = static_cast<std::time_t>(first + i * 60);
+            std::ostringstream oss;
+            oss << std::put_time(std::localtime(&time), "%Y-%m-%d");
+            total += oss.str().size();
+        }
+    });
+    report("localtime + put_time", bars, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < bars; ++i) {
+            total += format_date(first + i * 60).size();
+        }
+    });
+    report("format_date local", bars, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < bars; ++i) {
+            Timestamp timestamp(first + i * 60);
+            do_not_optimize(timestamp);
+        }
+    });
+    report("Timestamp(timestamp_t)", bars, seconds);
+
+    std::vector<std::string> dates;
+    for (size_t d = 0; d < 365; ++d) {
+        dates.push_back(format_date(first + d * 86400));
+    }
+    size_t parses = bars / 4;
+    seconds = measure([&] {
+        for (size_t i = 0; i < parses; ++i) {
+            std::istringstream ss{dates[i % dates.size()]};
+            std::tm tm{};
+            ss >> std::get_time(&tm, "%Y-%m-%d");
+            total += static_cast<size_t>(std::mktime(&tm));
+        }
+    });
+    report("get_time + mktime", parses, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < parses; ++i) {
+            total += date_string_to_epoch(dates[i % dates.size()]);
+        }
+    });
+    report("date_string_to_epoch", parses, seconds);
+    do_not_optimize(total);
+    return 0;
+}
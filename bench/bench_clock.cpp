@@ -0,0 +1,50 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Reads of each clock source, and default-constructed orders, whose timestamp comes from the current
+// source, under each of them.
+//
+// usage: bench_clock [reads]
+
+#include <trading_common/clock.h>
+#include <trading_common/order.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    const std::pair<ClockSource, const char *> sources[] = {
+            {ClockSource::SYSTEM,    "system"},
+            {ClockSource::COARSE,    "coarse"},
+            {ClockSource::TSC,       "TSC"},
+            {ClockSource::SIMULATED, "simulated"}
+    };
+
+    int64_t checksum = 0;
+    for (const auto &[source, name]: sources) {
+        set_clock_source(source);
+        // the first read of the TSC clock calibrates it
+        checksum += now_ns();
+        double seconds = measure([&] {
+            for (size_t i = 0; i < count; ++i) {
+                checksum += now_ns();
+            }
+        });
+        report(std::string("now_ns() ") + name, count, seconds);
+    }
+
+    for (const auto &[source, name]: sources) {
+        set_clock_source(source);
+        double seconds = measure([&] {
+            for (size_t i = 0; i < count; ++i) {
+                trading::order::Order order;
+                checksum += static_cast<int64_t>(order.timestamp);
+            }
+        });
+        report(std::string("Order() ") + name, count, seconds);
+    }
+    do_not_optimize(checksum);
+    return 0;
+}
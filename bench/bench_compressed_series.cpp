@@ -0,0 +1,74 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Compresses years of minute bars on a tick grid with session gaps, then measures the memory per bar against
+// ColumnarSeriesOHLCV and SeriesOHLCV, sequential block decoding and random lookups.
+//
+// usage: bench_compressed_series [bars] [block size]
+
+#include <trading_common/compressed_series.h>
+#include <cmath>
+#include <map>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 2'000'000;
+    size_t block_size = argc > 2 ? std::stoul(argv[2]) : CompressedSeriesOHLCV::DEFAULT_BLOCK_SIZE;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 3);
+    std::uniform_int_distribution<int> spread(0, 5);
+    std::geometric_distribution<size_t> volume(0.001);
+    ColumnarSeriesOHLCV series(symbol_t("AAPL"));
+    timestamp_t t = 1'500'000'000;
+    double close = 150;
+    for (size_t i = 0; i < bars; ++i) {
+        // 390 minute sessions, one a day
+        t += i % 390 == 0 ? 86'400 - 389 * 60 : 60;
+        double open = close;
+        close = std::max(0.01, std::round((close + step(rng) * 0.01) * 100) / 100);
+        series.insert(ColumnarSeriesOHLCV::Bar{t, open, std::max(open, close) + spread(rng) * 0.01,
+                                               std::min(open, close) - spread(rng) * 0.01, close, volume(rng)});
+    }
+
+    CompressedSeriesOHLCV compressed(series.symbol(), block_size);
+    double seconds = measure([&] {
+        auto columns = series.columns();
+        for (size_t i = 0; i < columns.size(); ++i) {
+            compressed.append(CompressedSeriesOHLCV::Bar{columns.timestamp[i], columns.open[i], columns.high[i],
+                                                         columns.low[i], columns.close[i], columns.volume[i]});
+        }
+    });
+    report("append", bars, seconds);
+
+    // a std::map node holds the key, the OHLCV and three pointers plus the color
+    constexpr size_t MAP_BAR = sizeof(std::pair<const timestamp_t, OHLCV>) + 4 * sizeof(void *);
+    std::printf("bytes per bar: compressed %.2f, columnar %zu, SeriesOHLCV >= %zu\n",
+                static_cast<double>(compressed.bytes()) / static_cast<double>(bars), size_t{48}, MAP_BAR);
+
+    CompressedSeriesOHLCV::Buffer buffer;
+    double checksum = 0;
+    seconds = measure([&] {
+        for (size_t b = 0; b < compressed.blocks(); ++b) {
+            auto columns = compressed.decode(b, buffer);
+            checksum += columns.close.back() + static_cast<double>(columns.volume.back());
+        }
+    });
+    report("sequential decode, values", bars * 6, seconds);
+
+    std::uniform_int_distribution<size_t> pick(0, bars - 1);
+    constexpr size_t LOOKUPS = 20'000;
+    seconds = measure([&] {
+        for (size_t k = 0; k < LOOKUPS; ++k) {
+            checksum += compressed.find(series.timestamps()[pick(rng)])->close;
+        }
+    });
+    report("find", LOOKUPS, seconds);
+
+    do_not_optimize(checksum);
+    return 0;
+}
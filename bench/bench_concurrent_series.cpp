@@ -0,0 +1,118 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// One writer appending bars while N readers repeatedly read the last bars of the series, comparing the
+// mutex-based SeriesOHLCV with the snapshot-based ConcurrentSeriesOHLCV.
+//
+// usage: bench_concurrent_series [bars] [max_readers]
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <trading_common/ohlc.h>
+#include <trading_common/concurrent_series.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+namespace {
+
+    constexpr size_t WINDOW = 64;
+
+    struct Outcome {
+        double writer_seconds = 0;
+        size_t reads = 0;
+    };
+
+    Outcome run_mutex_series(size_t bars, size_t readers) {
+        SeriesOHLCV series;
+        symbol_t symbol = std::make_shared<std::string>("BENCH");
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+
+        std::vector<std::thread> threads;
+        for (size_t r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                size_t local = 0;
+                double sum = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    if (series.empty()) continue;
+                    size_t n = 0;
+                    for (auto it = series.rbegin(); n < WINDOW && it != series.rend(); --it, ++n) {
+                        sum += (*it).second.close;
+                    }
+                    ++local;
+                }
+                do_not_optimize(sum);
+                reads += local;
+            });
+        }
+
+        Outcome outcome;
+        outcome.writer_seconds = measure([&] {
+            OHLCV bar(symbol, 1, 1, 2, 0.5, 1, 1);
+            for (size_t i = 1; i <= bars; ++i) {
+                bar.timestamp = i;
+                bar.close = (double) i;
+                series.insert(bar);
+            }
+        });
+        done = true;
+        for (auto &t: threads) t.join();
+        outcome.reads = reads;
+        return outcome;
+    }
+
+    Outcome run_snapshot_series(size_t bars, size_t readers) {
+        ConcurrentSeriesOHLCV series(std::make_shared<std::string>("BENCH"));
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+
+        std::vector<std::thread> threads;
+        for (size_t r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                size_t local = 0;
+                double sum = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto snapshot = series.snapshot();
+                    size_t size = snapshot.size();
+                    for (size_t i = size > WINDOW ? size - WINDOW : 0; i < size; ++i) {
+                        sum += snapshot.at(i).close;
+                    }
+                    ++local;
+                }
+                do_not_optimize(sum);
+                reads += local;
+            });
+        }
+
+        Outcome outcome;
+        outcome.writer_seconds = measure([&] {
+            for (size_t i = 1; i <= bars; ++i) {
+                series.append(ConcurrentSeriesOHLCV::Bar{i, 1, 2, 0.5, (double) i, i});
+            }
+        });
+        done = true;
+        for (auto &t: threads) t.join();
+        outcome.reads = reads;
+        return outcome;
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    size_t max_readers = argc > 2 ? std::stoul(argv[2]) : 8;
+
+    for (size_t readers = 1; readers <= max_readers; readers *= 2) {
+        auto locked = run_mutex_series(bars, readers);
+        report("SeriesOHLCV insert, readers=" + std::to_string(readers), bars, locked.writer_seconds);
+        report("SeriesOHLCV last " + std::to_string(WINDOW) + " reads", locked.reads, locked.writer_seconds);
+
+        auto snapshot = run_snapshot_series(bars, readers);
+        report("ConcurrentSeriesOHLCV append, readers=" + std::to_string(readers), bars, snapshot.writer_seconds);
+        report("ConcurrentSeriesOHLCV last " + std::to_string(WINDOW) + " reads", snapshot.reads,
+               snapshot.writer_seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Parsing order statuses and instruction types from text: upper-casing a copy and comparing names one by one,
+// or searching a std::map by value, against the perfect hash of EnumNames.
+//
+// usage: bench_enum_names [lookups]
+
+#include <algorithm>
+#include <map>
+#include <trading_common/instructions.h>
+#include <trading_common/order.h>
+#include "bench.h"
+
+using namespace trading::bench;
+using trading::order::Status;
+using trading::instructions::Type;
+
+namespace {
+    Status parse_status_by_comparison(const std::string &text) {
+        std::string upper = ::common::to_upper(text);
+        if (upper == "OPEN") {
+            return Status::OPEN;
+        } else if (upper == "CLOSED") {
+            return Status::CLOSED;
+        } else if (upper == "FILLED") {
+            return Status::FILLED;
+        } else if (upper == "CANCELED") {
+            return Status::CANCELED;
+        }
+        return Status::NONE;
+    }
+
+    const std::map<Type, std::string> TYPE_MAP = {
+            {Type::NONE, ""}, {Type::TICKER, "ticker"}, {Type::OHLC, "ohlc"},
+            {Type::MACD, "macd"}, {Type::SMA, "sma"}, {Type::EMA, "ema"}
+    };
+
+    Type parse_type_by_map(const std::string &text) {
+        auto found = std::find_if(TYPE_MAP.begin(), TYPE_MAP.end(), [&](const auto &item) {
+            return item.second == text;
+        });
+        return found == TYPE_MAP.end() ? Type::NONE : found->first;
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    const std::vector<std::string> statuses = {"open", "FILLED", "Canceled", "closed", "unknown"};
+    const std::vector<std::string> types = {"ticker", "ohlc", "macd", "sma", "ema", "other"};
+
+    // names are taken in turn without a division per lookup, which would cost as much as the lookup
+    auto each = [count](const std::vector<std::string> &names, auto &&lookup) {
+        size_t index = 0;
+        for (size_t i = 0; i < count; ++i) {
+            lookup(names[index]);
+            index = index + 1 == names.size() ? 0 : index + 1;
+        }
+    };
+
+    size_t checksum = 0;
+    double seconds = measure([&] {
+        each(statuses, [&](const std::string &name) {
+            checksum += static_cast<size_t>(parse_status_by_comparison(name));
+        });
+    });
+    report("Status to_upper and comparisons", count, seconds);
+    seconds = measure([&] {
+        each(statuses, [&](const std::string &name) {
+            checksum += static_cast<size_t>(trading::order::StatusNames.parse(name, Status::NONE));
+        });
+    });
+    report("Status EnumNames::parse", count, seconds);
+
+    seconds = measure([&] {
+        each(types, [&](const std::string &name) {
+            checksum += static_cast<size_t>(parse_type_by_map(name));
+        });
+    });
+    report("Type std::map search", count, seconds);
+    seconds = measure([&] {
+        each(types, [&](const std::string &name) {
+            checksum += static_cast<size_t>(trading::instructions::get_type_from_string(name));
+        });
+    });
+    report("Type get_type_from_string", count, seconds);
+    do_not_optimize(checksum);
+    return 0;
+}
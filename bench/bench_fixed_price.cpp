@@ -0,0 +1,76 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Accumulates the notional and average price of a stream of fills, the arithmetic of
+// BasicPosition::apply_order and BasicPnL, with price_t and with an overflow-checked FixedPrice<4>, and
+// prints how far the double result drifts from the exact one.
+//
+// usage: bench_fixed_price [fills]
+
+#include <trading_common/fixed_price.h>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t fills = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+
+    using Price = FixedPrice<4>;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> ticks(1'000'000, 2'000'000);
+    std::uniform_int_distribution<size_t> quantity(1, 100);
+    std::vector<Price> prices(fills);
+    std::vector<double> doubles(fills);
+    std::vector<size_t> quantities(fills);
+    for (size_t i = 0; i < fills; ++i) {
+        prices[i] = Price::from_ticks(ticks(rng));
+        doubles[i] = prices[i].to_double();
+        quantities[i] = quantity(rng);
+    }
+
+    double entry = 0;
+    size_t balance = 0;
+    double seconds = measure([&] {
+        for (size_t i = 0; i < fills; ++i) {
+            size_t next = balance + quantities[i];
+            entry = (entry * balance + doubles[i] * quantities[i]) / next;
+            balance = next;
+        }
+    });
+    report("average entry, price_t", fills, seconds);
+
+    Price fixed_entry;
+    balance = 0;
+    seconds = measure([&] {
+        for (size_t i = 0; i < fills; ++i) {
+            size_t next = balance + quantities[i];
+            fixed_entry = (fixed_entry * balance + prices[i] * quantities[i]) / next;
+            balance = next;
+        }
+    });
+    report("average entry, FixedPrice<4>", fills, seconds);
+
+    double notional = 0;
+    seconds = measure([&] {
+        for (size_t i = 0; i < fills; ++i) {
+            notional += doubles[i] * quantities[i];
+        }
+    });
+    report("notional, price_t", fills, seconds);
+
+    Price fixed_notional;
+    seconds = measure([&] {
+        for (size_t i = 0; i < fills; ++i) {
+            fixed_notional += prices[i] * quantities[i];
+        }
+    });
+    report("notional, FixedPrice<4>", fills, seconds);
+
+    std::printf("notional drift of price_t: %.6f over %.4f\n", notional - fixed_notional.to_double(),
+                fixed_notional.to_double());
+    do_not_optimize(entry);
+    do_not_optimize(fixed_entry);
+    return 0;
+}
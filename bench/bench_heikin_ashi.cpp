@@ -0,0 +1,73 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Builds the Heikin-Ashi series of one symbol by walking SeriesOHLCV with the single candle constructor,
+// through HeikinAshiView, with the batch column transform, and by extending it with HeikinAshiState.
+//
+// usage: bench_heikin_ashi [bars]
+
+#include <trading_common/heikin_ashi.h>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 0.5);
+    SeriesOHLCV series;
+    double close = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = close;
+        close += step(rng);
+        series.insert(OHLCV(symbol_t("HA"), 1'700'000'000 + i * 60, open, std::max(open, close) + 0.2,
+                            std::min(open, close) - 0.2, close, 100));
+    }
+    ColumnarSeriesOHLCV columnar(series);
+
+    double seconds = measure([&] {
+        std::vector<HeikinAshi> candles;
+        candles.reserve(bars);
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            const OHLCV &bar = (*it).second;
+            candles.push_back(candles.empty() ? HeikinAshi(bar) : HeikinAshi(bar, candles.back()));
+        }
+        do_not_optimize(candles);
+    });
+    report("SeriesOHLCV walk into vector<HeikinAshi>", bars, seconds);
+
+    seconds = measure([&] {
+        double sum = 0;
+        for (const auto &[timestamp, candle]: HeikinAshiView(series)) {
+            sum += candle.close;
+        }
+        do_not_optimize(sum);
+    });
+    report("HeikinAshiView over SeriesOHLCV", bars, seconds);
+
+    std::vector<double> open(bars), high(bars), low(bars), closes(bars);
+    seconds = measure([&] {
+        heikin_ashi(columnar.columns(), open, high, low, closes);
+        do_not_optimize(closes);
+    });
+    report("batch into columns", bars, seconds);
+
+    seconds = measure([&] {
+        auto ha = heikin_ashi(columnar);
+        do_not_optimize(ha);
+    });
+    report("batch into ColumnarSeriesOHLCV", bars, seconds);
+
+    HeikinAshiState state;
+    seconds = measure([&] {
+        for (size_t i = 0; i < bars; ++i) {
+            do_not_optimize(state.update(OHLC(open[i], high[i], low[i], closes[i])));
+        }
+    });
+    report("HeikinAshiState update", bars, seconds);
+
+    return 0;
+}
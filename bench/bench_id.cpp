@@ -0,0 +1,79 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Ids for new orders: the string keys of ::common::key_generator() against the lock-free 64 bit ids of
+// next_id(), on one thread and on several, then default-constructed and JSON-parsed orders.
+//
+// usage: bench_id [ids] [threads]
+
+#include <thread>
+#include <trading_common/order.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    size_t threads = argc > 2 ? std::stoul(argv[2]) : 4;
+
+    size_t checksum = 0;
+    double seconds = measure([&] {
+        for (size_t i = 0; i < count / 10; ++i) {
+            checksum += ::common::key_generator().size();
+        }
+    });
+    report("::common::key_generator()", count / 10, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            checksum += next_id().number();
+        }
+    });
+    report("next_id()", count, seconds);
+
+    seconds = measure([&] {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([count, threads] {
+                uint64_t sum = 0;
+                for (size_t i = 0; i < count / threads; ++i) {
+                    sum += next_id().number();
+                }
+                do_not_optimize(sum);
+            });
+        }
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    });
+    report("next_id() on " + std::to_string(threads) + " threads", count, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            checksum += next_id().str().size();
+        }
+    });
+    report("next_id().str()", count, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            trading::order::Order order;
+            checksum += order.quantity + order.id.number();
+        }
+    });
+    report("Order()", count, seconds);
+
+    json j = {{"id", "exchange-7f3c1e2a"}, {"quantity", 200}, {"symbol", "AAPL"}, {"side", "BUY"},
+              {"filled", 0}, {"filled_at_price", 0}, {"limit_price", 185.7}, {"type", "LIMIT"},
+              {"status", "OPEN"}};
+    seconds = measure([&] {
+        for (size_t i = 0; i < count / 10; ++i) {
+            trading::order::Order order(j);
+            checksum += order.id.size();
+        }
+    });
+    report("Order(json) with an id", count / 10, seconds);
+    do_not_optimize(checksum);
+    return 0;
+}
@@ -0,0 +1,69 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Streams bars through one IndicatorEngine per symbol with SMA, EMA, MACD, RSI, ATR and Bollinger, then
+// revises every last bar once, as a live feed does while a bar is forming.
+//
+// usage: bench_indicators [bars per symbol] [symbols]
+
+#include <trading_common/indicators.h>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::indicators;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000;
+    size_t symbols = argc > 2 ? std::stoul(argv[2]) : 5'000;
+    constexpr size_t INDICATORS = 6;
+
+    std::vector<IndicatorEngine> engines(symbols);
+    for (auto &engine: engines) {
+        engine.add_sma(20);
+        engine.add_ema(20);
+        engine.add_macd();
+        engine.add_rsi();
+        engine.add_atr();
+        engine.add_bollinger();
+    }
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 0.5);
+    std::vector<Bar> stream(bars);
+    double close = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = close;
+        close += step(rng);
+        stream[i] = {1'700'000'000 + i * 60, open, std::max(open, close) + 0.2, std::min(open, close) - 0.2, close,
+                     100};
+    }
+
+    double seconds = measure([&] {
+        for (auto &bar: stream) {
+            for (auto &engine: engines) {
+                engine.on_bar(bar);
+            }
+        }
+    });
+    report("new bar x " + std::to_string(INDICATORS) + " indicators", bars * symbols * INDICATORS, seconds);
+
+    Bar revision = stream.back();
+    seconds = measure([&] {
+        for (size_t k = 0; k < 10; ++k) {
+            revision.close += 0.01;
+            for (auto &engine: engines) {
+                engine.on_bar(revision);
+            }
+        }
+    });
+    report("revised bar x " + std::to_string(INDICATORS) + " indicators", 10 * symbols * INDICATORS, seconds);
+
+    double total = 0;
+    for (auto &engine: engines) {
+        total += engine.macd(0).histogram() + engine.bollinger(0).upper();
+    }
+    do_not_optimize(total);
+    return 0;
+}
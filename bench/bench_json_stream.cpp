@@ -0,0 +1,62 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Loads a large SeriesOHLCV JSON dump with the DOM constructor or the streaming SAX loader and reports
+// throughput and peak resident memory. Run each mode in its own process so the peaks do not mix.
+//
+// usage: bench_json_stream [dom|sax] [bars]
+
+#include <filesystem>
+#include <fstream>
+#include <sys/resource.h>
+#include <trading_common/json_stream.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+namespace {
+    long peak_rss_kb() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string mode = argc > 1 ? argv[1] : "sax";
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 2'000'000;
+    auto path = (std::filesystem::temp_directory_path() / "bench_json_stream.json").string();
+
+    {
+        // written bar by bar so generating the input does not raise the peak
+        std::ofstream out(path);
+        out << '[';
+        for (size_t i = 0; i < bars; ++i) {
+            double base = 100.0 + (double) (i % 97) * 0.01;
+            out << (i ? "," : "") << R"({"close":)" << base << R"(,"high":)" << base + 0.5 << R"(,"low":)"
+                << base - 0.5 << R"(,"open":)" << base << R"(,"timestamp":)" << 1577836800 + i * 60
+                << R"(,"volume":)" << i << '}';
+        }
+        out << ']';
+    }
+    auto bytes = std::filesystem::file_size(path);
+    long baseline = peak_rss_kb();
+
+    size_t loaded = 0;
+    double seconds = measure([&] {
+        if (mode == "dom") {
+            std::ifstream in(path);
+            ColumnarSeriesOHLCV series(json::parse(in));
+            loaded = series.size();
+        } else {
+            ColumnarSeriesOHLCV series;
+            loaded = load_json_file(path, series);
+        }
+    });
+    report("load " + mode, loaded, seconds);
+    std::printf("%.1f MB/s, peak rss +%ld MB over baseline for a %.1f MB document\n",
+                (double) bytes / seconds / 1e6, (peak_rss_kb() - baseline) / 1024, (double) bytes / 1e6);
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,59 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Serialization of OHLCV bars, orders, positions and a series to JSON text, through to_json().dump() and
+// through a JsonWriter reused across messages.
+//
+// usage: bench_json_writer [messages]
+
+#include <trading_common/json_writer.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+using Order = trading::order::Order;
+using Position = trading::position::Position;
+
+namespace {
+    template<typename T>
+    void run(const char *name, const T &message, size_t count) {
+        size_t checksum = 0;
+        double seconds = measure([&] {
+            for (size_t i = 0; i < count; ++i) {
+                checksum += message.to_json().dump().size();
+            }
+        });
+        report(std::string(name) + " to_json().dump()", count, seconds);
+
+        JsonWriter writer;
+        seconds = measure([&] {
+            for (size_t i = 0; i < count; ++i) {
+                writer.clear();
+                writer.write(message);
+                checksum += writer.size();
+            }
+        });
+        report(std::string(name) + " JsonWriter", count, seconds);
+        do_not_optimize(checksum);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    symbol_t symbol("AAPL");
+
+    run("OHLCV", OHLCV(symbol, 1704495600, 187.15, 188.44, 183.89, 185.64, 82'488'700), count);
+    run("Order", Order(1704495600, 200, symbol, trading::order::Side::BUY, 200, 185.64, 185.7,
+                       "7f3c1e2a-9b4d-4c1e-8a2f-5d6e7f8a9b0c", trading::order::Type::LIMIT,
+                       trading::order::Status::FILLED), count);
+    run("Position", Position("2b8e4f6a-1c3d-4e5f-9a7b-8c9d0e1f2a3b", 1704495600, 200, symbol,
+                             trading::position::Side::LONG, 185.64, 187.15, 302.0), count);
+
+    SeriesOHLCV series;
+    for (size_t i = 0; i < 1000; ++i) {
+        double open = 100 + static_cast<double>(i % 97) * 0.25;
+        series.insert(OHLCV(symbol, 1704495600 + 60 * i, open, open + 1.5, open - 1.25, open + 0.5, 1000 + i));
+    }
+    run("SeriesOHLCV of 1000 bars", series, count / 1000);
+    return 0;
+}
@@ -0,0 +1,86 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Runs each batch kernel over a 10M element price column on every instruction set the CPU supports,
+// against the loop a strategy would write by hand.
+//
+// usage: bench_kernels [elements] [window]
+
+#include <trading_common/kernels.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+#include "bench.h"
+
+using namespace trading::kernels;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    size_t window = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 0.5);
+    std::vector<double> close(n), high(n), low(n), out(n);
+    double price = 1000;
+    for (size_t i = 0; i < n; ++i) {
+        price = std::max(1.0, price + step(rng));
+        close[i] = price;
+        high[i] = price + 0.3;
+        low[i] = price - 0.3;
+    }
+
+    struct Case {
+        std::string name;
+        std::function<void()> naive;
+        std::function<void()> kernel;
+    };
+    std::vector<Case> cases = {
+            {"rolling_mean", [&] {
+                for (size_t i = window - 1; i < n; ++i) {
+                    double sum = 0;
+                    for (size_t k = i + 1 - window; k <= i; ++k) sum += close[k];
+                    out[i] = sum / (double) window;
+                }
+            }, [&] { rolling_mean(close, window, out); }},
+            {"rolling_max", [&] {
+                for (size_t i = window - 1; i < n; ++i) {
+                    out[i] = *std::max_element(close.begin() + (std::ptrdiff_t) (i + 1 - window),
+                                               close.begin() + (std::ptrdiff_t) (i + 1));
+                }
+            }, [&] { rolling_max(close, window, out); }},
+            {"ema", [&] {
+                double alpha = 2.0 / ((double) window + 1), value = close[0];
+                for (size_t i = 0; i < n; ++i) out[i] = value += alpha * (close[i] - value);
+            }, [&] { ema(close, window, out); }},
+            {"true_range", [&] {
+                out[0] = high[0] - low[0];
+                for (size_t i = 1; i < n; ++i) {
+                    out[i] = std::max({high[i] - low[i], std::abs(high[i] - close[i - 1]),
+                                       std::abs(low[i] - close[i - 1])});
+                }
+            }, [&] { true_range(high, low, close, out); }},
+            {"returns", [&] {
+                for (size_t i = 1; i < n; ++i) out[i] = close[i] / close[i - 1] - 1;
+            }, [&] { returns(close, out); }},
+            {"log_returns", [&] {
+                for (size_t i = 1; i < n; ++i) out[i] = std::log(close[i] / close[i - 1]);
+            }, [&] { log_returns(close, out); }},
+    };
+
+    for (auto &c: cases) {
+        report(c.name + " naive", n, measure(c.naive));
+        do_not_optimize(out[n - 1]);
+        for (auto isa: {Isa::SCALAR, Isa::AVX2, Isa::AVX512}) {
+            if (isa > supported_isa()) {
+                continue;
+            }
+            set_isa(isa);
+            report(c.name + " " + isa_name(isa), n, measure(c.kernel));
+            do_not_optimize(out[n - 1]);
+        }
+    }
+    return 0;
+}
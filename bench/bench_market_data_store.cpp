@@ -0,0 +1,110 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Multi-threaded throughput of a universe of symbols, comparing the usual
+// std::unordered_map<std::string, SeriesOHLCV> behind one global mutex with MarketDataStore. Every thread
+// count is run for: appends from threads that each own a slice of the symbols, the bulk ingest, and reads of
+// the last bar of random symbols.
+//
+// usage: bench_market_data_store [symbols] [bars per symbol] [max threads]
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <trading_common/market_data_store.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+namespace {
+    template<typename F>
+    double run_threads(size_t threads, F &&fn) {
+        return measure([&] {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back(fn, t);
+            }
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        });
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t symbols = argc > 1 ? std::stoul(argv[1]) : 5'000;
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 200;
+    size_t max_threads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    constexpr size_t READS_PER_THREAD = 1'000'000;
+
+    std::vector<std::string> names(symbols);
+    std::vector<symbol_t> interned(symbols);
+    for (size_t s = 0; s < symbols; ++s) {
+        names[s] = "MDS" + std::to_string(s);
+        interned[s] = symbol_t(names[s]);
+    }
+    std::vector<OHLCV> feed;
+    feed.reserve(symbols * bars);
+    for (size_t b = 0; b < bars; ++b) {
+        for (size_t s = 0; s < symbols; ++s) {
+            feed.emplace_back(interned[s], 1'700'000'000 + b * 60, 100, 101, 99, 100.5, 10);
+        }
+    }
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::printf("%zu threads\n", threads);
+
+        std::unordered_map<std::string, SeriesOHLCV> map;
+        std::mutex map_mutex;
+        double seconds = run_threads(threads, [&](size_t t) {
+            for (size_t b = 0; b < bars; ++b) {
+                for (size_t s = t; s < symbols; s += threads) {
+                    std::lock_guard lock(map_mutex);
+                    map[names[s]].insert(feed[b * symbols + s]);
+                }
+            }
+        });
+        report("  map + global mutex, append", symbols * bars, seconds);
+
+        MarketDataStore store;
+        seconds = run_threads(threads, [&](size_t t) {
+            for (size_t b = 0; b < bars; ++b) {
+                for (size_t s = t; s < symbols; s += threads) {
+                    store.append(feed[b * symbols + s]);
+                }
+            }
+        });
+        report("  MarketDataStore, append", symbols * bars, seconds);
+
+        MarketDataStore bulk;
+        seconds = measure([&] { do_not_optimize(bulk.ingest(feed, threads)); });
+        report("  MarketDataStore, ingest", symbols * bars, seconds);
+
+        seconds = run_threads(threads, [&](size_t t) {
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<size_t> pick(0, symbols - 1);
+            double sum = 0;
+            for (size_t i = 0; i < READS_PER_THREAD; ++i) {
+                std::lock_guard lock(map_mutex);
+                auto &series = map.find(names[pick(rng)])->second;
+                sum += (*series.rbegin()).second.close;
+            }
+            do_not_optimize(sum);
+        });
+        report("  map + global mutex, last bar", threads * READS_PER_THREAD, seconds);
+
+        seconds = run_threads(threads, [&](size_t t) {
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<size_t> pick(0, symbols - 1);
+            double sum = 0;
+            for (size_t i = 0; i < READS_PER_THREAD; ++i) {
+                sum += store.last(interned[pick(rng)])->close;
+            }
+            do_not_optimize(sum);
+        });
+        report("  MarketDataStore, last bar", threads * READS_PER_THREAD, seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Order book operations on one symbol: limit orders resting on 100 levels a side, canceling them in random
+// order, market orders sweeping the top levels, and a mix of adds, cancels and crossing orders like a live
+// feed. Orders are built beforehand, so the times are the book's alone.
+//
+// usage: bench_order_book [orders]
+
+#include <algorithm>
+#include <random>
+#include <trading_common/order_book.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::order;
+using namespace trading::bench;
+
+namespace {
+    // Limit orders around 1000, bids below and asks above
+    std::vector<Order> resting_orders(size_t count, const symbol_t &symbol, std::mt19937_64 &random) {
+        std::vector<Order> orders;
+        orders.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            Side side = random() % 2 == 0 ? Side::BUY : Side::SELL;
+            auto offset = static_cast<price_t>(random() % 100) * 0.01;
+            price_t price = side == Side::BUY ? 999.99 - offset : 1000.01 + offset;
+            orders.emplace_back(1, 1 + random() % 100, symbol, side, 0, 0, price, next_id(), Type::LIMIT,
+                                Status::OPEN);
+        }
+        return orders;
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    symbol_t symbol = std::make_shared<std::string>("BTC");
+    std::mt19937_64 random(42);
+    size_t checksum = 0;
+    size_t executions = 0;
+
+    OrderBook book(symbol);
+    book.reserve(count);
+    book.on_fill([&executions](const Fill &) { ++executions; });
+
+    std::vector<Order> orders = resting_orders(count, symbol, random);
+    std::vector<id_t_> ids;
+    for (const auto &order: orders) {
+        ids.push_back(order.id);
+    }
+    double seconds = measure([&] {
+        for (auto &order: orders) {
+            checksum += book.add(std::move(order)).resting;
+        }
+    });
+    report("add, resting", count, seconds);
+
+    std::shuffle(ids.begin(), ids.end(), random);
+    seconds = measure([&] {
+        for (const auto &id: ids) {
+            checksum += book.cancel(id);
+        }
+    });
+    report("cancel", count, seconds);
+
+    orders = resting_orders(count, symbol, random);
+    for (auto &order: orders) {
+        book.add(std::move(order));
+    }
+    std::vector<Order> markets;
+    for (size_t i = 0; i < count / 100; ++i) {
+        markets.emplace_back(1, 50 + random() % 100, symbol, i % 2 == 0 ? Side::BUY : Side::SELL, 0, 0, 0,
+                             next_id(), Type::MARKET, Status::OPEN);
+    }
+    executions = 0;
+    seconds = measure([&] {
+        for (auto &order: markets) {
+            checksum += book.add(std::move(order)).filled;
+        }
+    });
+    report("add, market sweeping the top", markets.size(), seconds);
+    std::printf("%-48s %12.1f executions per order\n", "",
+                static_cast<double>(executions) / static_cast<double>(markets.size()));
+
+    // live-like flow: 60% new limits near the touch, 30% cancels of a random resting order, 10% crossing limits
+    std::vector<Order> flow;
+    std::vector<int> actions;
+    for (size_t i = 0; i < count; ++i) {
+        int action = static_cast<int>(random() % 10);
+        actions.push_back(action);
+        Side side = random() % 2 == 0 ? Side::BUY : Side::SELL;
+        auto offset = static_cast<price_t>(random() % 20) * 0.01;
+        price_t price = action == 9 ? (side == Side::BUY ? 1000.05 : 999.95)
+                                    : (side == Side::BUY ? 999.99 - offset : 1000.01 + offset);
+        flow.emplace_back(1, 1 + random() % 100, symbol, side, 0, 0, price, next_id(), Type::LIMIT,
+                          Status::OPEN);
+    }
+    std::vector<id_t_> live;
+    live.reserve(count);
+    seconds = measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            if (actions[i] >= 6 && actions[i] <= 8 && !live.empty()) {
+                size_t at = (i * 2654435761u) % live.size();
+                checksum += book.cancel(live[at]);
+                live[at] = live.back();
+                live.pop_back();
+            } else {
+                live.push_back(flow[i].id);
+                checksum += book.add(std::move(flow[i])).filled;
+            }
+        }
+    });
+    report("mixed add / cancel / cross", count, seconds);
+    do_not_optimize(checksum);
+    return 0;
+}
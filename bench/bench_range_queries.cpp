@@ -0,0 +1,93 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Random as-of lookups and 100-bar range reads, as chart and backtest services issue them, on SeriesOHLCV and
+// ColumnarSeriesOHLCV. The scan is what answering an as-of query took before, walking the series in order.
+//
+// usage: bench_range_queries [bars] [queries]
+
+#include <trading_common/columnar.h>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    size_t queries = argc > 2 ? std::stoul(argv[2]) : 1'000'000;
+    constexpr timestamp_t START = 1'700'000'000;
+    constexpr timestamp_t STEP = 60;
+    constexpr size_t RANGE = 100;
+
+    SeriesOHLCV series;
+    for (size_t i = 0; i < bars; ++i) {
+        series.insert(OHLCV(symbol_t("RQ"), START + i * STEP, 100, 101, 99, 100.5, 10));
+    }
+    ColumnarSeriesOHLCV columnar(series);
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<timestamp_t> time(START, START + bars * STEP);
+    std::vector<timestamp_t> times(queries);
+    for (auto &t: times) {
+        t = time(rng);
+    }
+
+    size_t scans = std::max<size_t>(1, queries / 10'000);
+    double seconds = measure([&] {
+        double sum = 0;
+        for (size_t q = 0; q < scans; ++q) {
+            const OHLCV *found = nullptr;
+            for (auto it = series.begin(); it != series.end() && (*it).first <= times[q]; ++it) {
+                found = &(*it).second;
+            }
+            sum += found ? found->close : 0;
+        }
+        do_not_optimize(sum);
+    });
+    report("as_of by scan, SeriesOHLCV", scans, seconds);
+
+    seconds = measure([&] {
+        double sum = 0;
+        for (auto t: times) {
+            auto bar = series.as_of(t);
+            sum += bar ? bar->close : 0;
+        }
+        do_not_optimize(sum);
+    });
+    report("as_of, SeriesOHLCV", queries, seconds);
+
+    seconds = measure([&] {
+        double sum = 0;
+        for (auto t: times) {
+            auto bar = columnar.as_of(t);
+            sum += bar ? bar->close : 0;
+        }
+        do_not_optimize(sum);
+    });
+    report("as_of, ColumnarSeriesOHLCV", queries, seconds);
+
+    seconds = measure([&] {
+        double sum = 0;
+        for (auto t: times) {
+            for (const auto &[timestamp, bar]: series.range(t, t + RANGE * STEP)) {
+                sum += bar.close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+    report("range of 100 bars, SeriesOHLCV", queries, seconds);
+
+    seconds = measure([&] {
+        double sum = 0;
+        for (auto t: times) {
+            for (double close: columnar.range(t, t + RANGE * STEP).close) {
+                sum += close;
+            }
+        }
+        do_not_optimize(sum);
+    });
+    report("range of 100 bars, ColumnarSeriesOHLCV", queries, seconds);
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Resamples several years of 24/7 minute bars to 5m, 15m, 1h and calendar days.
+//
+// usage: bench_resample [years]
+
+#include <trading_common/resample.h>
+#include <trading_common/aggregator.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t years = argc > 1 ? std::stoul(argv[1]) : 5;
+    size_t bars = years * 365 * 24 * 60;
+
+    ColumnarSeriesOHLCV series(std::make_shared<std::string>("BENCH"));
+    series.reserve(bars);
+    for (size_t i = 0; i < bars; ++i) {
+        double base = 100.0 + (double) (i % 97) * 0.01;
+        series.insert(ColumnarSeriesOHLCV::Bar{1577836800 + i * 60, base, base + 0.5, base - 0.5, base + 0.1, i % 1000});
+    }
+
+    for (auto timeframe: {timeframes::FIVE_MINUTES, 15 * timeframes::MINUTE, timeframes::HOUR}) {
+        size_t out = 0;
+        double seconds = measure([&] { out = resample(series, timeframe).size(); });
+        report("resample " + std::to_string(timeframe) + "s -> " + std::to_string(out) + " bars", bars, seconds);
+    }
+    size_t out = 0;
+    double seconds = measure([&] { out = resample(series, timeframes::DAY, Alignment::CALENDAR_DAY).size(); });
+    report("resample calendar day -> " + std::to_string(out) + " bars", bars, seconds);
+    return 0;
+}
@@ -0,0 +1,77 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Streams bars for many symbols into one series per symbol, as a live strategy host does, and reports the
+// resident memory each layout ends up with: SeriesOHLCV keeps every bar in its own map node, RollingSeriesOHLCV
+// keeps the last `window` bars in a ring allocated up front.
+//
+// usage: bench_rolling_series [symbols] [bars per symbol] [window]
+
+#include <trading_common/rolling_series.h>
+#include <fstream>
+#include <unistd.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+namespace {
+    double resident_mb() {
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return static_cast<double>(resident * static_cast<size_t>(sysconf(_SC_PAGESIZE))) / (1024.0 * 1024.0);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t symbols = argc > 1 ? std::stoul(argv[1]) : 20'000;
+    size_t bars = argc > 2 ? std::stoul(argv[2]) : 1'000;
+    size_t window = argc > 3 ? std::stoul(argv[3]) : 500;
+
+    auto bar_at = [](size_t i) {
+        auto price = 100 + static_cast<double>(i % 100) * 0.01;
+        return ColumnarSeriesOHLCV::Bar{1'700'000'000 + i * 60, price, price + 0.1, price - 0.1, price, 10};
+    };
+
+    {
+        double before = resident_mb();
+        std::vector<RollingSeriesOHLCV> series;
+        series.reserve(symbols);
+        for (size_t s = 0; s < symbols; ++s) {
+            series.emplace_back(window, symbol_t("R" + std::to_string(s)));
+        }
+        double seconds = measure([&] {
+            for (size_t i = 0; i < bars; ++i) {
+                auto bar = bar_at(i);
+                for (auto &one: series) {
+                    one.insert(bar);
+                }
+            }
+        });
+        report("RollingSeriesOHLCV insert", symbols * bars, seconds);
+        std::printf("  resident %.1f MB, %.1f MB expected\n", resident_mb() - before,
+                    static_cast<double>(symbols * window * RollingSeriesOHLCV::BYTES_PER_BAR) / (1024.0 * 1024.0));
+    }
+
+    {
+        double before = resident_mb();
+        std::vector<SeriesOHLCV> series(symbols);
+        std::vector<symbol_t> names(symbols);
+        for (size_t s = 0; s < symbols; ++s) {
+            names[s] = symbol_t("S" + std::to_string(s));
+        }
+        double seconds = measure([&] {
+            for (size_t i = 0; i < bars; ++i) {
+                auto bar = bar_at(i);
+                for (size_t s = 0; s < symbols; ++s) {
+                    series[s].insert(bar.to_ohlcv(names[s]));
+                }
+            }
+        });
+        report("SeriesOHLCV insert", symbols * bars, seconds);
+        std::printf("  resident %.1f MB, growing with every bar\n", resident_mb() - before);
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Streams bars through the rolling statistics (standard deviation, Donchian channel, VWAP and realized
+// volatility) and through the O(window) loops they replace, recomputed over the window on every bar.
+//
+// usage: bench_rolling_stats [bars] [window]
+
+#include <trading_common/rolling_stats.h>
+#include <cmath>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::indicators;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    size_t window = argc > 2 ? std::stoul(argv[2]) : 200;
+    constexpr size_t STATISTICS = 4;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0, 0.5);
+    std::uniform_int_distribution<size_t> volume(1, 1000);
+    std::vector<Bar> stream(bars);
+    double close = 100;
+    for (size_t i = 0; i < bars; ++i) {
+        double open = close;
+        close = std::max(1.0, close + step(rng));
+        stream[i] = {1'700'000'000 + i * 60, open, std::max(open, close) + 0.2, std::min(open, close) - 0.2, close,
+                     volume(rng)};
+    }
+
+    RollingVariance variance(window);
+    Donchian channel(window);
+    VWAP vwap(window);
+    RealizedVolatility volatility(window);
+    double total = 0;
+    double seconds = measure([&] {
+        for (auto &bar: stream) {
+            variance.update(bar);
+            channel.update(bar);
+            vwap.update(bar);
+            volatility.update(bar);
+            total += variance.stddev() + channel.middle() + vwap.value() + volatility.value();
+        }
+    });
+    report("streaming x " + std::to_string(STATISTICS) + " statistics", bars * STATISTICS, seconds);
+
+    seconds = measure([&] {
+        for (size_t i = window + 1; i <= bars; ++i) {
+            double mean = 0, deviation = 0, high = stream[i - window].high, low = stream[i - window].low;
+            double value = 0, traded = 0, return_mean = 0, return_deviation = 0;
+            for (size_t j = i - window; j < i; ++j) {
+                const Bar &bar = stream[j];
+                mean += bar.close;
+                high = std::max(high, bar.high);
+                low = std::min(low, bar.low);
+                value += (bar.high + bar.low + bar.close) / 3 * static_cast<double>(bar.volume);
+                traded += static_cast<double>(bar.volume);
+                return_mean += std::log(bar.close / stream[j - 1].close);
+            }
+            mean /= static_cast<double>(window);
+            return_mean /= static_cast<double>(window);
+            for (size_t j = i - window; j < i; ++j) {
+                deviation += (stream[j].close - mean) * (stream[j].close - mean);
+                double r = std::log(stream[j].close / stream[j - 1].close) - return_mean;
+                return_deviation += r * r;
+            }
+            total += std::sqrt(deviation / static_cast<double>(window)) + (high + low) / 2 + value / traded +
+                     std::sqrt(return_deviation / static_cast<double>(window - 1));
+        }
+    });
+    report("window loops x " + std::to_string(STATISTICS) + " statistics", (bars - window) * STATISTICS, seconds);
+
+    Bar revision = stream.back();
+    seconds = measure([&] {
+        for (size_t k = 0; k < bars; ++k) {
+            revision.close += k % 2 ? 0.01 : -0.01;
+            variance.revise(revision);
+            channel.revise(revision);
+            vwap.revise(revision);
+            volatility.revise(revision);
+            total += variance.stddev() + channel.middle() + vwap.value() + volatility.value();
+        }
+    });
+    report("revised bar x " + std::to_string(STATISTICS) + " statistics", bars * STATISTICS, seconds);
+
+    do_not_optimize(total);
+    return 0;
+}
@@ -0,0 +1,114 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Ingests minute bars into SeriesOHLCV and ColumnarSeriesOHLCV: in-order appends against a plain std::map
+// insert, and sorted or shuffled batches merged into a series they interleave with, bar by bar against the
+// bulk insert.
+//
+// usage: bench_series_ingest [bars] [threads]
+
+#include <trading_common/columnar.h>
+#include <algorithm>
+#include <random>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+
+int main(int argc, char **argv) {
+    size_t bars = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    size_t threads = argc > 2 ? std::stoul(argv[2]) : 0;
+
+    symbol_t symbol("AAPL");
+    std::vector<OHLCV> appends;
+    std::vector<ColumnarSeriesOHLCV::Bar> columnar_appends;
+    appends.reserve(bars);
+    for (size_t i = 0; i < bars; ++i) {
+        double close = 100 + static_cast<double>(i % 97);
+        appends.emplace_back(symbol, 1'700'000'000 + i * 60, close, close + 1, close - 1, close, i);
+        columnar_appends.push_back({appends.back().timestamp, close, close + 1, close - 1, close, i});
+    }
+    // half of the bars, on the odd minutes, go in first; the batches bring the other half
+    std::vector<OHLCV> base, batch;
+    std::vector<ColumnarSeriesOHLCV::Bar> columnar_base, columnar_batch;
+    for (size_t i = 0; i < bars; ++i) {
+        (i % 2 ? base : batch).push_back(appends[i]);
+        (i % 2 ? columnar_base : columnar_batch).push_back(columnar_appends[i]);
+    }
+    auto shuffled = batch;
+    auto columnar_shuffled = columnar_batch;
+    std::mt19937 rng(42);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::shuffle(columnar_shuffled.begin(), columnar_shuffled.end(), rng);
+
+    size_t checksum = 0;
+    double seconds = measure([&] {
+        std::map<timestamp_t, OHLCV> map;
+        for (const auto &bar: appends) {
+            map.insert({bar.timestamp, bar});
+        }
+        checksum += map.size();
+    });
+    report("std::map insert, in order", bars, seconds);
+
+    seconds = measure([&] {
+        SeriesOHLCV series;
+        for (const auto &bar: appends) {
+            series.insert(bar);
+        }
+        checksum += series.size();
+    });
+    report("SeriesOHLCV insert, in order", bars, seconds);
+
+    seconds = measure([&] {
+        SeriesOHLCV series;
+        series.insert(appends);
+        checksum += series.size();
+    });
+    report("SeriesOHLCV batch, in order", bars, seconds);
+
+    auto series_run = [&](const char *name, const std::vector<OHLCV> &input, bool bulk) {
+        SeriesOHLCV series;
+        series.insert(base);
+        double elapsed = measure([&] {
+            if (bulk) {
+                series.insert(input, DuplicatePolicy::KEEP, threads);
+            } else {
+                for (const auto &bar: input) {
+                    series.insert(bar);
+                }
+            }
+        });
+        checksum += series.size();
+        report(name, input.size(), elapsed);
+    };
+    series_run("SeriesOHLCV insert, interleaved sorted", batch, false);
+    series_run("SeriesOHLCV batch, interleaved sorted", batch, true);
+    series_run("SeriesOHLCV insert, interleaved shuffled", shuffled, false);
+    series_run("SeriesOHLCV batch, interleaved shuffled", shuffled, true);
+
+    auto columnar_run = [&](const char *name, const std::vector<ColumnarSeriesOHLCV::Bar> &input, bool bulk) {
+        ColumnarSeriesOHLCV series(symbol);
+        series.insert(columnar_base);
+        double elapsed = measure([&] {
+            if (bulk) {
+                series.insert(input, DuplicatePolicy::KEEP, threads);
+            } else {
+                for (const auto &bar: input) {
+                    series.insert(bar);
+                }
+            }
+        });
+        checksum += series.size();
+        report(name, input.size(), elapsed);
+    };
+    // bar by bar, every insert in the middle shifts the columns after it
+    if (bars <= 100'000) {
+        columnar_run("Columnar insert, interleaved sorted", columnar_batch, false);
+    }
+    columnar_run("Columnar batch, interleaved sorted", columnar_batch, true);
+    columnar_run("Columnar batch, interleaved shuffled", columnar_shuffled, true);
+
+    do_not_optimize(checksum);
+    return 0;
+}
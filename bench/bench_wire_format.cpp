@@ -0,0 +1,58 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Round trips of OHLCV bars, orders and positions through the binary wire format, encoding into and
+// decoding from reused buffers and objects, against to_json().dump() and parsing back with the JSON
+// constructors.
+//
+// usage: bench_wire_format [messages]
+
+#include <trading_common/wire_format.h>
+#include "bench.h"
+
+using namespace trading::common;
+using namespace trading::bench;
+using Order = trading::order::Order;
+using Position = trading::position::Position;
+
+namespace {
+    template<typename T>
+    void run(const char *name, const T &message, size_t count) {
+        size_t checksum = 0;
+        double seconds = measure([&] {
+            for (size_t i = 0; i < count / 10; ++i) {
+                std::string text = message.to_json().dump();
+                json j = json::parse(text);
+                T decoded(j);
+                checksum += text.size() + decoded.timestamp;
+            }
+        });
+        report(std::string(name) + " JSON round trip", count / 10, seconds);
+
+        std::vector<unsigned char> buffer(wire::encoded_size(message));
+        T decoded = message;
+        seconds = measure([&] {
+            for (size_t i = 0; i < count; ++i) {
+                size_t size = wire::encode(message, buffer);
+                checksum += wire::decode(std::span<const unsigned char>(buffer.data(), size), decoded);
+                do_not_optimize(decoded);
+            }
+        });
+        report(std::string(name) + " wire round trip", count, seconds);
+        std::printf("%s bytes: JSON %zu, wire %zu\n", name, message.to_json().dump().size(), buffer.size());
+        do_not_optimize(checksum);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    symbol_t symbol("AAPL");
+
+    run("OHLCV", OHLCV(symbol, 1704495600, 187.15, 188.44, 183.89, 185.64, 82'488'700), count);
+    run("Order", Order(1704495600, 200, symbol, trading::order::Side::BUY, 200, 185.64, 185.7,
+                       "7f3c1e2a-9b4d-4c1e-8a2f-5d6e7f8a9b0c", trading::order::Type::LIMIT,
+                       trading::order::Status::FILLED), count);
+    run("Position", Position("2b8e4f6a-1c3d-4e5f-9a7b-8c9d0e1f2a3b", 1704495600, 200, symbol,
+                             trading::position::Side::LONG, 185.64, 187.15, 302.0), count);
+    return 0;
+}
@@ -0,0 +1,100 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_AGGREGATOR_H
+#define TRADING_COMMON_AGGREGATOR_H
+
+#include <functional>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // Bar lengths in the same unit as the timestamps fed to the aggregator (seconds by default).
+    namespace timeframes {
+        constexpr timestamp_t SECOND = 1;
+        constexpr timestamp_t MINUTE = 60 * SECOND;
+        constexpr timestamp_t FIVE_MINUTES = 5 * MINUTE;
+        constexpr timestamp_t HOUR = 60 * MINUTE;
+        constexpr timestamp_t DAY = 24 * HOUR;
+    }
+
+    struct Tick {
+        timestamp_t timestamp = 0;
+        price_t price = 0;
+        size_t size = 0;
+    };
+
+    // Builds OHLCV bars of one symbol from trades at several timeframes at once. Every tick updates the open
+    // bar of each timeframe in place; a bar is emitted once, when the first tick of a later bucket arrives
+    // (or on flush), and is never touched again. Bars are aligned to multiples of their timeframe and empty
+    // buckets produce no bar. Ticks older than the open bar of the finest timeframe, or than the end of the last
+    // finest bar emitted, are rejected.
+    class BarAggregator {
+    public:
+        using Bar = ColumnarSeriesOHLCV::Bar;
+        using callback_t = std::function<void(timestamp_t timeframe, const Bar &bar)>;
+
+    private:
+        struct Slot {
+            timestamp_t timeframe = 0;
+            timestamp_t end = 0;
+            // end of the last bar emitted, kept across flush so that an emitted bucket is never reopened
+            timestamp_t emitted = 0;
+            bool open = false;
+            Bar bar{};
+            SeriesOHLCV *series = nullptr;
+        };
+
+        symbol_t m_symbol;
+        std::vector<Slot> m_slots;
+        callback_t m_callback;
+        size_t m_rejected = 0;
+        size_t m_truncated = 0;
+
+        void emit(Slot &slot);
+
+        void roll(Slot &slot, timestamp_t timestamp, price_t price, size_t size);
+
+    public:
+        explicit BarAggregator(symbol_t symbol,
+                               std::vector<timestamp_t> timeframes = {timeframes::SECOND, timeframes::MINUTE,
+                                                                      timeframes::FIVE_MINUTES, timeframes::HOUR});
+
+        // Called for every completed bar, finest timeframe first.
+        void on_bar(callback_t callback);
+
+        // Also insert the completed bars of one timeframe into a series, which must outlive the aggregator.
+        void emit_into(timestamp_t timeframe, SeriesOHLCV &series);
+
+        bool add(timestamp_t timestamp, price_t price, size_t size);
+
+        bool add(const Tick &tick);
+
+        // Emits every open bar and starts again with no open bar. Ticks in the buckets already emitted stay
+        // rejected, and a later tick in an emitted coarser bucket only feeds the finer timeframes; those are
+        // counted by truncated().
+        void flush();
+
+        // Emits the open bars whose bucket ends at or before `now` and keeps the others open, so that the ticks
+        // still to come in them are not lost.
+        void flush(timestamp_t now);
+
+        // The bar currently being built for a timeframe, or nullptr if there is none.
+        [[nodiscard]] const Bar *current(timestamp_t timeframe) const;
+
+        [[nodiscard]] std::vector<timestamp_t> get_timeframes() const;
+
+        [[nodiscard]] const symbol_t &symbol() const;
+
+        [[nodiscard]] size_t rejected() const;
+
+        // Ticks accepted that could not reach every timeframe, their coarser bucket having been flushed
+        [[nodiscard]] size_t truncated() const;
+    };
+}
+
+#endif //TRADING_COMMON_AGGREGATOR_H
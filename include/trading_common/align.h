@@ -0,0 +1,114 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ALIGN_H
+#define TRADING_COMMON_ALIGN_H
+
+#include <span>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // How series are put on one timestamp grid.
+    //
+    // FORWARD_FILL: every timestamp of any series, from the first one at which all of them have a bar. A series
+    // without a bar at a grid timestamp gets a flat bar at its last close with no volume.
+    // DROP: only the timestamps at which every series has a bar.
+    enum class AlignPolicy {
+        FORWARD_FILL,
+        DROP
+    };
+
+    // Timestamps of the grid, by a k-way merge of the sorted inputs done as a tree of pairwise unions (or
+    // intersections for DROP). Each level of the tree is merged from `threads` threads (0 for one per hardware
+    // thread).
+    std::vector<timestamp_t> align_timestamps(std::span<const ColumnsOHLCV> inputs,
+                                              AlignPolicy policy = AlignPolicy::FORWARD_FILL, size_t threads = 1);
+
+    // Several series aligned on one timestamp grid, stored as one block of columns per field with the series
+    // one after the other. columns(i) is series i on the grid, sharing the timestamp column with the others.
+    //
+    // The grid is merged once and then each series is filled in one linear pass over its bars and the grid.
+    // Series are independent in that pass, so with `threads` > 1 they are split into groups filled in parallel.
+    class AlignedSeries {
+    private:
+        std::vector<symbol_t> m_symbols;
+        std::vector<timestamp_t> m_timestamp;
+        std::vector<double> m_open;
+        std::vector<double> m_high;
+        std::vector<double> m_low;
+        std::vector<double> m_close;
+        std::vector<size_t> m_volume;
+
+        void fill(size_t index, const ColumnsOHLCV &input);
+
+        void fill_all(std::span<const ColumnsOHLCV> inputs, size_t threads);
+
+    public:
+        AlignedSeries() = default;
+
+        // `symbols` is optional; when given it has one symbol per input
+        explicit AlignedSeries(std::span<const ColumnsOHLCV> inputs, AlignPolicy policy = AlignPolicy::FORWARD_FILL,
+                               size_t threads = 1, std::vector<symbol_t> symbols = {});
+
+        explicit AlignedSeries(const std::vector<const ColumnarSeriesOHLCV *> &series,
+                               AlignPolicy policy = AlignPolicy::FORWARD_FILL, size_t threads = 1);
+
+        // Each series is copied into columns first, in the same thread groups
+        explicit AlignedSeries(const std::vector<const SeriesOHLCV *> &series,
+                               AlignPolicy policy = AlignPolicy::FORWARD_FILL, size_t threads = 1);
+
+        // Number of timestamps in the grid
+        [[nodiscard]] size_t size() const { return m_timestamp.size(); }
+
+        [[nodiscard]] bool empty() const { return m_timestamp.empty(); }
+
+        // Number of series
+        [[nodiscard]] size_t width() const { return m_symbols.size(); }
+
+        [[nodiscard]] std::span<const timestamp_t> timestamps() const { return m_timestamp; }
+
+        [[nodiscard]] const symbol_t &symbol(size_t index) const { return m_symbols.at(index); }
+
+        [[nodiscard]] ColumnsOHLCV columns(size_t index) const;
+
+        [[nodiscard]] ColumnarSeriesOHLCV to_columnar(size_t index) const;
+    };
+
+    // Walks the grid of several series one timestamp at a time without building their aligned columns, e.g. to
+    // stream a backtest over many symbols. bars() holds the bar of every series at timestamp(), filled as
+    // AlignPolicy says; timestamp() and bars() are only valid after next() returned true. The inputs must outlive
+    // the cursor.
+    class AlignmentCursor {
+    public:
+        using Bar = ColumnarSeriesOHLCV::Bar;
+
+    private:
+        std::vector<ColumnsOHLCV> m_inputs;
+        std::vector<timestamp_t> m_grid;
+        size_t m_position = 0;
+        // next unread bar of each input
+        std::vector<size_t> m_next;
+        std::vector<Bar> m_row;
+
+    public:
+        explicit AlignmentCursor(std::vector<ColumnsOHLCV> inputs, AlignPolicy policy = AlignPolicy::FORWARD_FILL);
+
+        // Moves to the next timestamp of the grid; false when there is none
+        bool next();
+
+        [[nodiscard]] timestamp_t timestamp() const { return m_grid[m_position - 1]; }
+
+        [[nodiscard]] size_t width() const { return m_inputs.size(); }
+
+        [[nodiscard]] std::span<const Bar> bars() const { return m_row; }
+
+        [[nodiscard]] const Bar &bar(size_t input) const { return m_row.at(input); }
+    };
+}
+
+#endif //TRADING_COMMON_ALIGN_H
@@ -0,0 +1,115 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_BINARY_SERIES_H
+#define TRADING_COMMON_BINARY_SERIES_H
+
+#include <cstdint>
+#include <string>
+#include <trading_common/common.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // On-disk layout of an OHLCV series, little-endian:
+    //
+    //   BinarySeriesHeader (128 bytes)
+    //   timestamp[count] (u64) | open[count] (f64) | high[count] | low[count] | close[count] | volume[count] (u64)
+    //
+    // Every column starts at header_size + k * column_stride, where the stride is count * 8 rounded up to 64
+    // bytes, so each column can be used in place as a span once the file is mapped.
+    struct BinarySeriesHeader {
+        static constexpr char MAGIC[8] = {'T', 'C', 'O', 'H', 'L', 'C', 'V', '\0'};
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t SYMBOL_CAPACITY = 88;
+
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint64_t count;
+        uint64_t column_stride;
+        uint32_t column_count;
+        uint32_t symbol_length;
+        char symbol[SYMBOL_CAPACITY];
+    };
+
+    static_assert(sizeof(BinarySeriesHeader) == 128);
+
+    void write_binary(const std::string &path, const ColumnsOHLCV &columns, const symbol_t &symbol = {});
+
+    void write_binary(const std::string &path, const ColumnarSeriesOHLCV &series);
+
+    // Read-only series backed by a memory-mapped binary file. Opening only validates the header, the bars
+    // are paged in by the OS as they are touched, so startup does not depend on the history length.
+    class MappedSeriesOHLCV {
+    private:
+        const unsigned char *m_data = nullptr;
+        size_t m_length = 0;
+        symbol_t m_symbol{};
+        ColumnsOHLCV m_columns{};
+
+        void unmap();
+
+    public:
+        using Bar = ColumnarSeriesOHLCV::Bar;
+
+        MappedSeriesOHLCV() = default;
+
+        explicit MappedSeriesOHLCV(const std::string &path);
+
+        ~MappedSeriesOHLCV();
+
+        MappedSeriesOHLCV(const MappedSeriesOHLCV &) = delete;
+
+        MappedSeriesOHLCV &operator=(const MappedSeriesOHLCV &) = delete;
+
+        MappedSeriesOHLCV(MappedSeriesOHLCV &&other) noexcept;
+
+        MappedSeriesOHLCV &operator=(MappedSeriesOHLCV &&other) noexcept;
+
+        [[nodiscard]] const symbol_t &symbol() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] Bar at(size_t index) const;
+
+        [[nodiscard]] ColumnsOHLCV columns() const;
+
+        // Bars with from <= timestamp < to, without copying.
+        [[nodiscard]] ColumnsOHLCV range(timestamp_t from, timestamp_t to) const;
+
+        [[nodiscard]] ColumnarSeriesOHLCV to_columnar() const;
+
+        class iterator {
+        private:
+            const MappedSeriesOHLCV *series;
+            std::ptrdiff_t index;
+
+        public:
+            iterator(const MappedSeriesOHLCV *s, std::ptrdiff_t i);
+
+            iterator &operator++();
+
+            iterator &operator--();
+
+            bool operator==(const iterator &other) const;
+
+            bool operator!=(const iterator &other) const;
+
+            std::pair<const timestamp_t, Bar> operator*() const;
+        };
+
+        [[nodiscard]] iterator begin() const;
+
+        [[nodiscard]] iterator rbegin() const;
+
+        [[nodiscard]] iterator end() const;
+
+        [[nodiscard]] iterator rend() const;
+    };
+}
+
+#endif //TRADING_COMMON_BINARY_SERIES_H
@@ -0,0 +1,180 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_CALENDAR_H
+#define TRADING_COMMON_CALENDAR_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <trading_common/common.h>
+
+namespace trading::common {
+
+    constexpr int64_t SECONDS_PER_DAY = 86400;
+
+    class CalendarException : public std::exception {
+    private:
+        std::string message{};
+    public:
+        explicit CalendarException(std::string message) : message(std::move(message)) {}
+
+        [[nodiscard]] const char *what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    struct CivilDate {
+        int year = 1970;
+        unsigned month = 1;
+        unsigned day = 1;
+
+        bool operator==(const CivilDate &other) const = default;
+    };
+
+    constexpr int64_t floor_div(int64_t a, int64_t b) noexcept {
+        return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+    }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm)
+    constexpr int64_t days_from_civil(int year, unsigned month, unsigned day) noexcept {
+        const int64_t y = static_cast<int64_t>(year) - (month <= 2);
+        const int64_t era = floor_div(y, 400);
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    constexpr int64_t days_from_civil(const CivilDate &date) noexcept {
+        return days_from_civil(date.year, date.month, date.day);
+    }
+
+    constexpr CivilDate civil_from_days(int64_t days) noexcept {
+        days += 719468;
+        const int64_t era = floor_div(days, 146097);
+        const auto doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2)), month, day};
+    }
+
+    // 0 is Sunday, as in std::tm::tm_wday
+    constexpr unsigned weekday_from_days(int64_t days) noexcept {
+        return static_cast<unsigned>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+    }
+
+    constexpr bool is_leap_year(int year) noexcept {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    constexpr unsigned days_in_month(int year, unsigned month) noexcept {
+        constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return month == 2 && is_leap_year(year) ? 29 : days[month - 1];
+    }
+
+    // Writes "YYYY-MM-DD" into out, which must have room for 10 chars. Years outside 0-9999 are clamped.
+    void format_civil(const CivilDate &date, char *out) noexcept;
+
+    // Strict "YYYY-MM-DD" parser that also checks the day exists
+    std::optional<CivilDate> parse_civil(std::string_view text) noexcept;
+
+    // UTC offsets of a time zone as a sorted table of transitions. Built from a TZif file (the zoneinfo
+    // database), a POSIX TZ rule or a fixed offset. Rules in a TZif footer are expanded up to year 2200.
+    class TimeZone {
+    private:
+        std::string m_name;
+        // m_offsets[i] is in effect before m_transitions[i], the last one after the last transition
+        std::vector<int64_t> m_transitions;
+        std::vector<int32_t> m_offsets;
+        uint64_t m_serial;
+
+        TimeZone(std::string name, std::vector<int64_t> transitions, std::vector<int32_t> offsets);
+
+    public:
+        static TimeZone utc();
+
+        static TimeZone fixed(int32_t offset, std::string name = {});
+
+        // POSIX TZ rule such as "CET-1CEST,M3.5.0,M10.5.0/3"
+        static TimeZone posix(const std::string &rule);
+
+        // zoneinfo name such as "Europe/Madrid" or an absolute path to a TZif file
+        static TimeZone load(const std::string &name);
+
+        // Zone of the process, from $TZ or /etc/localtime. It is read once; later changes of TZ are not seen.
+        static const TimeZone &local();
+
+        [[nodiscard]] const std::string &name() const;
+
+        // unique per instance, used to key caches
+        [[nodiscard]] uint64_t serial() const;
+
+        [[nodiscard]] int32_t offset(int64_t utc) const;
+
+        [[nodiscard]] int64_t to_local(int64_t utc) const;
+
+        // UTC instant of a local wall clock time. Ambiguous times take the earlier instant and times
+        // skipped by a forward transition are moved past it, as mktime does.
+        [[nodiscard]] int64_t from_local(int64_t local) const;
+
+        // local calendar day, in days since the epoch, that contains the instant
+        [[nodiscard]] int64_t local_day(int64_t utc) const;
+
+        // UTC instant of the first second of a local day
+        [[nodiscard]] int64_t midnight(int64_t day) const;
+
+        // [start, end) in UTC of the local day containing the instant
+        [[nodiscard]] std::pair<int64_t, int64_t> day_bounds(int64_t utc) const;
+    };
+
+    // "YYYY-MM-DD" of the instant in the time zone. The day of the last call on each thread is cached, so
+    // consecutive bars of the same day cost a range check and a 10 byte copy.
+    std::string format_date(timestamp_t timestamp, const TimeZone &zone = TimeZone::local());
+
+    // Local midnight of a "YYYY-MM-DD" date, or nullopt for malformed text
+    std::optional<timestamp_t> parse_date(std::string_view date, const TimeZone &zone = TimeZone::local());
+
+    // Trading sessions of an exchange, precomputed for a range of days. A day trades unless it is a weekend
+    // or a holiday; its session runs from `open` to `close` seconds after local midnight in the exchange zone.
+    class TradingCalendar {
+    public:
+        struct Session {
+            int64_t day = 0;
+            timestamp_t open = 0;
+            timestamp_t close = 0;
+        };
+
+        TradingCalendar(TimeZone zone, int64_t open, int64_t close, const CivilDate &first, const CivilDate &last,
+                        std::vector<CivilDate> holidays = {}, std::vector<unsigned> weekend = {0, 6});
+
+        [[nodiscard]] const TimeZone &zone() const;
+
+        [[nodiscard]] const std::vector<Session> &sessions() const;
+
+        [[nodiscard]] bool is_trading_day(const CivilDate &date) const;
+
+        // session whose [open, close) contains the instant
+        [[nodiscard]] std::optional<Session> session_at(timestamp_t timestamp) const;
+
+        [[nodiscard]] bool is_open(timestamp_t timestamp) const;
+
+        // first session that closes after the instant, the current one while the market is open
+        [[nodiscard]] std::optional<Session> next_session(timestamp_t timestamp) const;
+
+    private:
+        TimeZone m_zone;
+        std::vector<Session> m_sessions;
+        int64_t m_first_day;
+        int64_t m_last_day;
+    };
+}
+
+#endif //TRADING_COMMON_CALENDAR_H
@@ -0,0 +1,70 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_CLOCK_H
+#define TRADING_COMMON_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#include <trading_common/common.h>
+
+namespace trading::common {
+
+    // Clock that default timestamps of orders, positions and instructions are read from. Every source tells
+    // the time since the Unix epoch, in nanoseconds through now_ns() and in the seconds of timestamp_t
+    // through now_timestamp().
+    //
+    //   SYSTEM     std::chrono::system_clock, read on every call. The default.
+    //   COARSE     a time cached by a background thread every resolution, 1 ms unless changed: a read is one
+    //              atomic load. The thread starts the first time the coarse time is read.
+    //   TSC        the CPU time stamp counter, scaled to nanoseconds by a calibration against system_clock
+    //              at first use: monotonic and without a system call, but it drifts from the wall clock as
+    //              NTP corrects it, until calibrate_tsc() is called again. Where the counter is missing or not
+    //              invariant, steady_clock takes its place.
+    //   SIMULATED  a time that only moves through set_simulated_time() and advance_simulated_time(), for
+    //              backtests that replay history at their own pace and give the same timestamps every run.
+    enum class ClockSource {
+        SYSTEM,
+        COARSE,
+        TSC,
+        SIMULATED
+    };
+
+    void set_clock_source(ClockSource source);
+
+    [[nodiscard]] ClockSource clock_source();
+
+    // Nanoseconds since the epoch from the current source
+    [[nodiscard]] int64_t now_ns();
+
+    // Seconds since the epoch from the current source, the unit of timestamp_t
+    [[nodiscard]] timestamp_t now_timestamp();
+
+    // The "timestamp" number of a JSON object, or now_timestamp() when it has none, so that objects parsed
+    // from JSON only read the clock for the timestamps they lack
+    [[nodiscard]] timestamp_t timestamp_from_json(const json &object);
+
+    // Each source read directly, whatever the current one
+
+    [[nodiscard]] int64_t system_now_ns();
+
+    [[nodiscard]] int64_t coarse_now_ns();
+
+    [[nodiscard]] int64_t tsc_now_ns();
+
+    [[nodiscard]] int64_t simulated_now_ns();
+
+    // Interval of the coarse clock updates
+    void set_coarse_resolution(std::chrono::nanoseconds resolution);
+
+    // Takes a new pair of counter and system_clock readings to scale the TSC clock from. Blocks for about
+    // `window`, over which the tick rate is measured.
+    void calibrate_tsc(std::chrono::nanoseconds window = std::chrono::milliseconds(10));
+
+    void set_simulated_time(int64_t ns);
+
+    void advance_simulated_time(int64_t ns);
+}
+
+#endif //TRADING_COMMON_CLOCK_H
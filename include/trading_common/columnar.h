@@ -0,0 +1,201 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_COLUMNAR_H
+#define TRADING_COMMON_COLUMNAR_H
+
+#include <optional>
+#include <span>
+#include <vector>
+#include <utility>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+
+namespace trading::common {
+
+    // Non-owning view over the columns of a sorted OHLCV series. All the spans have the same length and
+    // index i of every column belongs to the same bar.
+    struct ColumnsOHLCV {
+        std::span<const timestamp_t> timestamp{};
+        std::span<const double> open{};
+        std::span<const double> high{};
+        std::span<const double> low{};
+        std::span<const double> close{};
+        std::span<const size_t> volume{};
+
+        [[nodiscard]] size_t size() const { return timestamp.size(); }
+
+        [[nodiscard]] bool empty() const { return timestamp.empty(); }
+
+        [[nodiscard]] ColumnsOHLCV subspan(size_t offset, size_t count) const;
+
+        // Bars with from <= timestamp < to, found by binary search.
+        [[nodiscard]] ColumnsOHLCV range(timestamp_t from, timestamp_t to) const;
+
+        // The last `count` bars, or all of them when there are fewer.
+        [[nodiscard]] ColumnsOHLCV last(size_t count) const;
+
+        // Index of the bar at exactly `timestamp`.
+        [[nodiscard]] std::optional<size_t> find(timestamp_t timestamp) const;
+
+        // Index of the last bar at or before `timestamp`; nullopt when every bar is later.
+        [[nodiscard]] std::optional<size_t> as_of(timestamp_t timestamp) const;
+    };
+
+    // Series of bars stored as contiguous, timestamp-sorted columns (structure of arrays) instead of one map
+    // node per bar. Keeps the SeriesOHLCV semantics: insert keeps an existing bar unless given another
+    // DuplicatePolicy and operator[] creates an empty bar on a miss. It is not internally synchronized; spans
+    // and references returned by it are invalidated by any insertion.
+    class ColumnarSeriesOHLCV {
+    private:
+        symbol_t m_symbol{};
+        std::vector<timestamp_t> m_timestamp;
+        std::vector<double> m_open;
+        std::vector<double> m_high;
+        std::vector<double> m_low;
+        std::vector<double> m_close;
+        std::vector<size_t> m_volume;
+
+        size_t lower_bound(timestamp_t timestamp) const;
+
+        void insert_at(size_t index, timestamp_t timestamp, double open, double high, double low, double close,
+                       size_t volume);
+
+    public:
+        // Plain copy of one bar, used by iteration.
+        struct Bar {
+            timestamp_t timestamp = 0;
+            double open = 0;
+            double high = 0;
+            double low = 0;
+            double close = 0;
+            size_t volume = 0;
+
+            [[nodiscard]] OHLCV to_ohlcv(const symbol_t &symbol) const;
+
+            [[nodiscard]] json to_json() const;
+        };
+
+        // Mutable access to one bar in place, returned by operator[].
+        struct BarRef {
+            const timestamp_t &timestamp;
+            double &open;
+            double &high;
+            double &low;
+            double &close;
+            size_t &volume;
+
+            [[nodiscard]] Bar get() const;
+        };
+
+    private:
+        void apply(size_t index, const Bar &bar, DuplicatePolicy policy);
+
+        // Adds a bar at or after the last one
+        void append(const Bar &bar, DuplicatePolicy policy);
+
+        // Merges `count` bars sorted by timestamp, bar(j) returning the j-th. Bars before the first of them stay
+        // in place and the rest of the columns are rewritten once, so appends cost O(count).
+        template<typename F>
+        void merge(size_t count, F bar, DuplicatePolicy policy);
+
+    public:
+        ColumnarSeriesOHLCV() = default;
+
+        explicit ColumnarSeriesOHLCV(symbol_t symbol);
+
+        explicit ColumnarSeriesOHLCV(const json &j);
+
+        explicit ColumnarSeriesOHLCV(const SeriesOHLCV &series);
+
+        // Takes over columns that are already built, without copying them. All must have the same length and
+        // the timestamps must be strictly increasing.
+        ColumnarSeriesOHLCV(symbol_t symbol, std::vector<timestamp_t> timestamp, std::vector<double> open,
+                            std::vector<double> high, std::vector<double> low, std::vector<double> close,
+                            std::vector<size_t> volume);
+
+        [[nodiscard]] json to_json() const;
+
+        [[nodiscard]] SeriesOHLCV to_series() const;
+
+        [[nodiscard]] const symbol_t &symbol() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] size_t size() const;
+
+        void reserve(size_t capacity);
+
+        void clear();
+
+        bool insert(const OHLCV &ohlc, DuplicatePolicy policy = DuplicatePolicy::KEEP);
+
+        bool insert(const Bar &bar, DuplicatePolicy policy = DuplicatePolicy::KEEP);
+
+        bool insert(const ColumnarSeriesOHLCV &series, DuplicatePolicy policy = DuplicatePolicy::KEEP);
+
+        // Bulk insert, like SeriesOHLCV: sorted batches are merged in one pass, unsorted ones are first sorted on
+        // `threads` threads (0 for one per hardware thread) and bars sharing a timestamp apply in batch order.
+        bool insert(std::span<const Bar> bars, DuplicatePolicy policy = DuplicatePolicy::KEEP, size_t threads = 1);
+
+        BarRef operator[](timestamp_t timestamp);
+
+        BarRef operator[](const std::string &date);
+
+        [[nodiscard]] Bar at(size_t index) const;
+
+        // Lookups and slices by binary search. Unlike operator[], a miss leaves the series untouched.
+
+        [[nodiscard]] std::optional<Bar> find(timestamp_t timestamp) const;
+
+        [[nodiscard]] std::optional<Bar> as_of(timestamp_t timestamp) const;
+
+        [[nodiscard]] ColumnsOHLCV range(timestamp_t from, timestamp_t to) const;
+
+        [[nodiscard]] ColumnsOHLCV last(size_t count) const;
+
+        [[nodiscard]] std::span<const timestamp_t> timestamps() const;
+
+        [[nodiscard]] std::span<const double> open() const;
+
+        [[nodiscard]] std::span<const double> high() const;
+
+        [[nodiscard]] std::span<const double> low() const;
+
+        [[nodiscard]] std::span<const double> close() const;
+
+        [[nodiscard]] std::span<const size_t> volume() const;
+
+        [[nodiscard]] ColumnsOHLCV columns() const;
+
+        class iterator {
+        private:
+            const ColumnarSeriesOHLCV *series;
+            std::ptrdiff_t index;
+
+        public:
+            iterator(const ColumnarSeriesOHLCV *s, std::ptrdiff_t i);
+
+            iterator &operator++();
+
+            iterator &operator--();
+
+            bool operator==(const iterator &other) const;
+
+            bool operator!=(const iterator &other) const;
+
+            std::pair<const timestamp_t, Bar> operator*() const;
+        };
+
+        [[nodiscard]] iterator begin() const;
+
+        [[nodiscard]] iterator rbegin() const;
+
+        [[nodiscard]] iterator end() const;
+
+        [[nodiscard]] iterator rend() const;
+    };
+}
+
+#endif //TRADING_COMMON_COLUMNAR_H
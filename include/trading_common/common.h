@@ -8,15 +8,17 @@
 #include <cstdlib>
 #include <string>
 #include "nlohmann/json.hpp"
+#include <trading_common/id.h>
+#include <trading_common/symbol_table.h>
 
 using json = nlohmann::json;
 
 namespace trading::common {
     typedef double price_t;
     typedef std::string symbol_value_t;
-    typedef std::shared_ptr<symbol_value_t> symbol_t;
+    typedef InternedSymbol symbol_t;
     typedef std::string date_t;
-    typedef std::string id_t_;
+    typedef Id id_t_;
     typedef unsigned long long timestamp_t;
 
     struct Result {
@@ -0,0 +1,133 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_COMPRESSED_SERIES_H
+#define TRADING_COMMON_COMPRESSED_SERIES_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // Bit stream written and read most significant bit first, in 64 bit words. One zero word is kept past the
+    // last written bit so a reader can always load two words.
+    struct BitStream {
+        std::vector<uint64_t> words;
+        size_t bits = 0;
+
+        // Appends the low `count` bits of `value`, 1 <= count <= 64
+        void write(uint64_t value, unsigned count);
+    };
+
+    // Series of bars compressed in blocks of block_size() bars, in the way of Facebook's Gorilla:
+    //
+    //   timestamp  delta of delta, 1 bit when bars are evenly spaced
+    //   high, low, close  XOR with the previous value of the column, 1 bit when unchanged and otherwise only the
+    //                     bits between the leading and trailing zeros of the XOR
+    //   open       XOR with the previous close, which it usually equals
+    //   volume     LEB128 varint
+    //
+    // Each column of a block is its own bit stream and every block starts from scratch, so a block is decoded on
+    // its own and lookups cost a binary search over the blocks plus one block decode. Bars are appended in
+    // increasing timestamp order; the last block stays open until it is full. Not internally synchronized.
+    class CompressedSeriesOHLCV {
+    public:
+        using Bar = ColumnarSeriesOHLCV::Bar;
+
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 512;
+
+        // Decoded bars of one block, reused between calls so decoding does not allocate
+        struct Buffer {
+            std::vector<timestamp_t> timestamp;
+            std::vector<double> open;
+            std::vector<double> high;
+            std::vector<double> low;
+            std::vector<double> close;
+            std::vector<size_t> volume;
+        };
+
+    private:
+        enum Column {
+            TIMESTAMP, OPEN, HIGH, LOW, CLOSE, VOLUME, COLUMNS
+        };
+
+        struct Block {
+            timestamp_t first = 0;
+            timestamp_t last = 0;
+            size_t count = 0;
+            std::array<BitStream, COLUMNS> streams;
+        };
+
+        // window of meaningful bits of the last XOR written to a price stream; none until the first one
+        struct Window {
+            unsigned leading = 64;
+            unsigned trailing = 0;
+        };
+
+        symbol_t m_symbol{};
+        size_t m_block_size;
+        size_t m_size = 0;
+        std::vector<Block> m_blocks;
+        // encoder state of the open block
+        int64_t m_delta = 0;
+        std::array<Window, COLUMNS> m_windows{};
+        Bar m_last{};
+
+        static void put_price(BitStream &stream, Window &window, double value, double reference);
+
+        [[nodiscard]] std::optional<size_t> block_of(timestamp_t timestamp) const;
+
+        // decodes bars of a block up to the first one at or after `until`
+        ColumnsOHLCV decode(size_t block, Buffer &buffer, timestamp_t until) const;
+
+    public:
+        explicit CompressedSeriesOHLCV(symbol_t symbol = {}, size_t block_size = DEFAULT_BLOCK_SIZE);
+
+        explicit CompressedSeriesOHLCV(const ColumnarSeriesOHLCV &series, size_t block_size = DEFAULT_BLOCK_SIZE);
+
+        [[nodiscard]] const symbol_t &symbol() const { return m_symbol; }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+
+        [[nodiscard]] size_t block_size() const { return m_block_size; }
+
+        [[nodiscard]] size_t blocks() const { return m_blocks.size(); }
+
+        // Heap memory held by the encoded blocks
+        [[nodiscard]] size_t bytes() const;
+
+        // Returns false for a bar that is not newer than the last one
+        bool append(const Bar &bar);
+
+        bool append(const OHLCV &ohlc);
+
+        // Decodes one block into `buffer` and returns its bars as columns, valid until the buffer is reused
+        ColumnsOHLCV decode(size_t block, Buffer &buffer) const;
+
+        // Index 0 is the oldest bar. Decodes its block.
+        [[nodiscard]] Bar at(size_t index) const;
+
+        // The newest bar, kept decoded. Throws OHLCException when the series is empty.
+        [[nodiscard]] Bar back() const;
+
+        [[nodiscard]] std::optional<Bar> find(timestamp_t timestamp) const;
+
+        // Last bar at or before `timestamp`
+        [[nodiscard]] std::optional<Bar> as_of(timestamp_t timestamp) const;
+
+        // Bars with from <= timestamp < to, decoding only the blocks that overlap the range
+        [[nodiscard]] ColumnarSeriesOHLCV range(timestamp_t from, timestamp_t to) const;
+
+        [[nodiscard]] ColumnarSeriesOHLCV to_columnar() const;
+    };
+}
+
+#endif //TRADING_COMMON_COMPRESSED_SERIES_H
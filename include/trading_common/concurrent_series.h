@@ -0,0 +1,152 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_CONCURRENT_SERIES_H
+#define TRADING_COMMON_CONCURRENT_SERIES_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // Append-only series for one writer and many readers. The writer appends bars in strictly increasing
+    // timestamp order into fixed-size columnar chunks that never move, and publishes the new length with a
+    // release store. Readers take a Snapshot, an immutable view of the first size() bars, without taking
+    // any lock, so they never block the writer and the writer never blocks them.
+    //
+    // append() must only be called from one thread at a time. It is wait-free except for the allocation of
+    // a new chunk every CHUNK_SIZE bars (and of a bigger chunk directory, amortized).
+    class ConcurrentSeriesOHLCV {
+    public:
+        static constexpr size_t CHUNK_BITS = 12;
+        static constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+        static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+        using Bar = ColumnarSeriesOHLCV::Bar;
+
+    private:
+        struct Chunk {
+            timestamp_t timestamp[CHUNK_SIZE];
+            double open[CHUNK_SIZE];
+            double high[CHUNK_SIZE];
+            double low[CHUNK_SIZE];
+            double close[CHUNK_SIZE];
+            size_t volume[CHUNK_SIZE];
+        };
+
+        struct Directory {
+            std::unique_ptr<Chunk *[]> chunks;
+            size_t capacity = 0;
+        };
+
+        // Everything readers can reach. Shared with the snapshots so they stay valid after the series is gone.
+        struct Storage {
+            std::atomic<Directory *> directory{nullptr};
+            std::atomic<size_t> size{0};
+            // owned by the writer, readers only go through the raw pointers above
+            std::vector<std::unique_ptr<Chunk>> chunks;
+            std::vector<std::unique_ptr<Directory>> directories;
+            symbol_t symbol{};
+        };
+
+        std::shared_ptr<Storage> m_storage;
+        timestamp_t m_last_timestamp = 0;
+
+        Chunk *chunk_for_append(size_t index);
+
+    public:
+        class Snapshot {
+        private:
+            std::shared_ptr<const Storage> m_storage;
+            const Directory *m_directory = nullptr;
+            size_t m_size = 0;
+
+        public:
+            Snapshot() = default;
+
+            Snapshot(std::shared_ptr<const Storage> storage, const Directory *directory, size_t size);
+
+            [[nodiscard]] bool empty() const;
+
+            [[nodiscard]] size_t size() const;
+
+            // Bars are never modified once published, so the number of bars is also the snapshot version.
+            [[nodiscard]] size_t version() const;
+
+            [[nodiscard]] const symbol_t &symbol() const;
+
+            [[nodiscard]] timestamp_t timestamp(size_t index) const;
+
+            [[nodiscard]] Bar at(size_t index) const;
+
+            [[nodiscard]] Bar back() const;
+
+            // Contiguous columns of the chunks covering [0, size()), in order. Useful for kernels that want
+            // linear memory access without copying the snapshot.
+            [[nodiscard]] std::vector<ColumnsOHLCV> segments() const;
+
+            [[nodiscard]] ColumnarSeriesOHLCV to_columnar() const;
+
+            [[nodiscard]] json to_json() const;
+
+            class iterator {
+            private:
+                const Snapshot *snapshot;
+                std::ptrdiff_t index;
+
+            public:
+                iterator(const Snapshot *s, std::ptrdiff_t i);
+
+                iterator &operator++();
+
+                iterator &operator--();
+
+                bool operator==(const iterator &other) const;
+
+                bool operator!=(const iterator &other) const;
+
+                std::pair<const timestamp_t, Bar> operator*() const;
+            };
+
+            [[nodiscard]] iterator begin() const;
+
+            [[nodiscard]] iterator rbegin() const;
+
+            [[nodiscard]] iterator end() const;
+
+            [[nodiscard]] iterator rend() const;
+        };
+
+        ConcurrentSeriesOHLCV();
+
+        explicit ConcurrentSeriesOHLCV(symbol_t symbol);
+
+        ConcurrentSeriesOHLCV(const ConcurrentSeriesOHLCV &) = delete;
+
+        ConcurrentSeriesOHLCV &operator=(const ConcurrentSeriesOHLCV &) = delete;
+
+        // Writer side. Returns false when the bar is not newer than the last appended one. The series symbol is
+        // the one given at construction, the symbol of the appended OHLCV is not looked at.
+        bool append(const OHLCV &ohlc);
+
+        bool append(const Bar &bar);
+
+        // Reader side, safe to call from any thread concurrently with append().
+        [[nodiscard]] Snapshot snapshot() const;
+
+        // Last published bar, read in place without the reference counting of a snapshot; nullopt when empty.
+        [[nodiscard]] std::optional<Bar> last() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+    };
+}
+
+#endif //TRADING_COMMON_CONCURRENT_SERIES_H
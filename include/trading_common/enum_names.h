@@ -0,0 +1,165 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ENUM_NAMES_H
+#define TRADING_COMMON_ENUM_NAMES_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace trading::common {
+
+    // Names of the values of an enum, built at compile time. name() indexes an array and parse() looks the text
+    // up in a perfect hash table, ignoring ASCII case, so neither allocates nor compares against every name.
+    // The entries must list the values 0, 1, ..., N - 1 in order; the first one, usually NONE, is what name()
+    // gives for a value out of range.
+    template<typename E, size_t N>
+    class EnumNames {
+    public:
+        using entry_type = std::pair<E, std::string_view>;
+
+    private:
+        static constexpr uint64_t ONES = 0x0101010101010101;
+
+        // twice as many slots as names keeps the seed search short
+        static constexpr size_t SLOTS = std::bit_ceil(2 * N);
+
+        static constexpr int SHIFT = 64 - std::countr_zero(SLOTS);
+
+        std::array<entry_type, N> m_entries{};
+        // the key() of each name, so that a lookup compares one integer
+        std::array<uint64_t, N> m_keys{};
+        // index + 1 of the name hashed to each slot, 0 for none
+        std::array<uint8_t, SLOTS> m_slots{};
+        uint64_t m_multiplier = 0;
+
+        static constexpr char fold(char c) {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+        template<typename T>
+        static T load(const char *data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        // Up to eight characters from `offset`, byte i of the text in byte i of the word, ASCII letters
+        // lowered eight at a time
+        static constexpr uint64_t word(std::string_view text, size_t offset) {
+            size_t n = std::min<size_t>(text.size() - offset, 8);
+            const char *data = text.data() + offset;
+            uint64_t value = 0;
+            if (std::is_constant_evaluated() || std::endian::native != std::endian::little) {
+                for (size_t i = 0; i < n; ++i) {
+                    value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+                }
+            } else if (n == 8) {
+                value = load<uint64_t>(data);
+            } else if (n >= 4) {
+                // two overlapping loads cover 4 to 7 characters
+                value = load<uint32_t>(data) | static_cast<uint64_t>(load<uint32_t>(data + n - 4)) << (8 * (n - 4));
+            } else if (n > 0) {
+                value = static_cast<uint64_t>(static_cast<unsigned char>(data[0]))
+                       | static_cast<uint64_t>(static_cast<unsigned char>(data[n / 2])) << (8 * (n / 2))
+                       | static_cast<uint64_t>(static_cast<unsigned char>(data[n - 1])) << (8 * (n - 1));
+            }
+            // the top bit of a byte tells whether it is at least 'A', and past 'Z', without carrying into the
+            // next byte; bytes from 0x80, UTF-8, stay as they are
+            uint64_t low = value & (0x7f * ONES);
+            uint64_t upper = (low + (0x80 - 'A') * ONES) & ~(low + (0x80 - 'Z' - 1) * ONES) & ~value & (0x80 * ONES);
+            return value | upper >> 2;
+        }
+
+        // The first eight characters and the length; longer names also mix in their last eight characters
+        static constexpr uint64_t key(std::string_view text) {
+            uint64_t result = word(text, 0) ^ text.size() << 56;
+            if (text.size() > 8) {
+                result ^= std::rotl(word(text, text.size() - 8), 29);
+            }
+            return result;
+        }
+
+        constexpr size_t slot(uint64_t key) const {
+            return static_cast<size_t>((key * m_multiplier) >> SHIFT);
+        }
+
+        static constexpr bool equal_ignore_case(std::string_view a, std::string_view b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (fold(a[i]) != fold(b[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    public:
+        static_assert(N > 0 && N < 256, "EnumNames holds between 1 and 255 names");
+
+        // Throws, which stops the compilation of a constexpr table, when the values are not 0, 1, ..., N - 1 or
+        // no multiplier hashes the names to distinct slots, e.g. two names only differ in case
+        constexpr explicit EnumNames(const std::array<entry_type, N> &entries) : m_entries(entries) {
+            for (size_t i = 0; i < N; ++i) {
+                if (static_cast<size_t>(m_entries[i].first) != i) {
+                    throw std::logic_error("EnumNames entries must list the values in order from 0");
+                }
+                m_keys[i] = key(m_entries[i].second);
+            }
+            for (uint64_t seed = 0; seed < 100'000; ++seed) {
+                m_multiplier = 0x9e3779b97f4a7c15 + 2 * seed;
+                std::array<uint8_t, SLOTS> slots{};
+                bool perfect = true;
+                for (size_t i = 0; i < N && perfect; ++i) {
+                    uint8_t &taken = slots[slot(m_keys[i])];
+                    perfect = taken == 0;
+                    taken = static_cast<uint8_t>(i + 1);
+                }
+                if (perfect) {
+                    m_slots = slots;
+                    return;
+                }
+            }
+            throw std::logic_error("EnumNames found no perfect hash for its names");
+        }
+
+        [[nodiscard]] constexpr std::string_view name(E value) const {
+            auto index = static_cast<size_t>(value);
+            return index < N ? m_entries[index].second : m_entries[0].second;
+        }
+
+        // Value named `text` in any case, or `fallback`
+        [[nodiscard]] constexpr E parse(std::string_view text, E fallback) const {
+            uint64_t text_key = key(text);
+            uint8_t taken = m_slots[slot(text_key)];
+            if (taken == 0 || m_keys[taken - 1] != text_key) {
+                return fallback;
+            }
+            // the key holds all of a name up to eight characters long, bar its length
+            std::string_view candidate = m_entries[taken - 1].second;
+            if (text.size() <= 8 ? candidate.size() == text.size() : equal_ignore_case(candidate, text)) {
+                return m_entries[taken - 1].first;
+            }
+            return fallback;
+        }
+
+        [[nodiscard]] constexpr size_t size() const { return N; }
+
+        [[nodiscard]] constexpr auto begin() const { return m_entries.begin(); }
+
+        [[nodiscard]] constexpr auto end() const { return m_entries.end(); }
+    };
+}
+
+#endif //TRADING_COMMON_ENUM_NAMES_H
@@ -0,0 +1,171 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_FIXED_PRICE_H
+#define TRADING_COMMON_FIXED_PRICE_H
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <trading_common/common.h>
+
+namespace trading::common {
+
+    constexpr int64_t decimal_scale(unsigned decimals) {
+        int64_t scale = 1;
+        for (unsigned i = 0; i < decimals; ++i) {
+            scale *= 10;
+        }
+        return scale;
+    }
+
+    // Price held as a whole number of ticks of 10^-DECIMALS: FixedPrice<2> counts cents, FixedPrice<5> FX
+    // pipettes, so each instrument picks the type with its scale. Sums, differences and products with a
+    // quantity are exact integer arithmetic that throws std::overflow_error instead of wrapping; dividing by a
+    // quantity rounds half away from zero to the nearest tick. Doubles only come in through from_double() and
+    // out through to_double(), at the edges: bars, JSON and display.
+    template<unsigned DECIMALS>
+    class FixedPrice {
+    public:
+        static_assert(DECIMALS <= 18, "The scale of a FixedPrice must fit in 64 bits");
+
+        static constexpr unsigned DECIMAL_PLACES = DECIMALS;
+
+        static constexpr int64_t SCALE = decimal_scale(DECIMALS);
+
+    private:
+        int64_t m_ticks = 0;
+
+        static constexpr void check(bool overflow) {
+            if (overflow) {
+                throw std::overflow_error("FixedPrice overflow");
+            }
+        }
+
+    public:
+        constexpr FixedPrice() = default;
+
+        static constexpr FixedPrice from_ticks(int64_t ticks) {
+            FixedPrice price;
+            price.m_ticks = ticks;
+            return price;
+        }
+
+        // Rounds to the nearest tick
+        static FixedPrice from_double(double value) {
+            double ticks = std::round(value * static_cast<double>(SCALE));
+            // 2^63 is the first double past INT64_MAX
+            if (!(std::abs(ticks) < 9223372036854775808.0)) {
+                throw std::overflow_error("Price out of the range of a FixedPrice");
+            }
+            return from_ticks(static_cast<int64_t>(ticks));
+        }
+
+        [[nodiscard]] constexpr int64_t ticks() const { return m_ticks; }
+
+        [[nodiscard]] constexpr double to_double() const {
+            return static_cast<double>(m_ticks) / static_cast<double>(SCALE);
+        }
+
+        constexpr auto operator<=>(const FixedPrice &) const = default;
+
+        constexpr FixedPrice operator-() const {
+            int64_t ticks = 0;
+            check(__builtin_sub_overflow(int64_t{0}, m_ticks, &ticks));
+            return from_ticks(ticks);
+        }
+
+        constexpr FixedPrice operator+(FixedPrice other) const {
+            int64_t ticks = 0;
+            check(__builtin_add_overflow(m_ticks, other.m_ticks, &ticks));
+            return from_ticks(ticks);
+        }
+
+        constexpr FixedPrice operator-(FixedPrice other) const {
+            int64_t ticks = 0;
+            check(__builtin_sub_overflow(m_ticks, other.m_ticks, &ticks));
+            return from_ticks(ticks);
+        }
+
+        constexpr FixedPrice &operator+=(FixedPrice other) { return *this = *this + other; }
+
+        constexpr FixedPrice &operator-=(FixedPrice other) { return *this = *this - other; }
+
+        // Price times a quantity, e.g. the value of a position
+        template<std::integral I>
+        constexpr FixedPrice operator*(I quantity) const {
+            int64_t ticks = 0;
+            check(__builtin_mul_overflow(m_ticks, quantity, &ticks));
+            return from_ticks(ticks);
+        }
+
+        template<std::integral I>
+        friend constexpr FixedPrice operator*(I quantity, FixedPrice price) { return price * quantity; }
+
+        // Value divided by a quantity, e.g. an average price
+        template<std::integral I>
+        constexpr FixedPrice operator/(I quantity) const {
+            if (quantity == 0) {
+                throw std::domain_error("FixedPrice divided by zero");
+            }
+            if (quantity > 0 && std::in_range<int64_t>(quantity)) {
+                // the usual case, in 64 bit division: |remainder| < divisor, so nothing below overflows
+                auto divisor = static_cast<int64_t>(quantity);
+                int64_t quotient = m_ticks / divisor;
+                int64_t remainder = m_ticks % divisor;
+                int64_t magnitude = remainder < 0 ? -remainder : remainder;
+                if (magnitude >= divisor - magnitude) {
+                    quotient += m_ticks < 0 ? -1 : 1;
+                }
+                return from_ticks(quotient);
+            }
+            auto divisor = static_cast<__int128>(quantity);
+            auto ticks = static_cast<__int128>(m_ticks);
+            __int128 quotient = ticks / divisor;
+            __int128 remainder = ticks % divisor;
+            if ((remainder < 0 ? -2 * remainder : 2 * remainder) >= (divisor < 0 ? -divisor : divisor)) {
+                quotient += (ticks < 0) == (divisor < 0) ? 1 : -1;
+            }
+            check(quotient > INT64_MAX || quotient < INT64_MIN);
+            return from_ticks(static_cast<int64_t>(quotient));
+        }
+    };
+
+    // Prices in JSON are plain numbers, whatever the representation
+    template<unsigned DECIMALS>
+    void to_json(json &j, const FixedPrice<DECIMALS> &price) {
+        j = price.to_double();
+    }
+
+    template<unsigned DECIMALS>
+    void from_json(const json &j, FixedPrice<DECIMALS> &price) {
+        price = FixedPrice<DECIMALS>::from_double(j.get<double>());
+    }
+
+    // Conversions for code templated on the price type, price_t or a FixedPrice
+
+    template<typename P>
+    constexpr double price_to_double(const P &price) {
+        if constexpr (std::is_floating_point_v<P>) {
+            return price;
+        } else {
+            return price.to_double();
+        }
+    }
+
+    template<typename P>
+    P price_from_double(double value) {
+        if constexpr (std::is_floating_point_v<P>) {
+            return value;
+        } else {
+            return P::from_double(value);
+        }
+    }
+}
+
+#endif //TRADING_COMMON_FIXED_PRICE_H
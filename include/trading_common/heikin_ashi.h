@@ -0,0 +1,93 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_HEIKIN_ASHI_H
+#define TRADING_COMMON_HEIKIN_ASHI_H
+
+#include <span>
+#include <utility>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // Heikin-Ashi candles of a whole series, written into caller-provided columns that must be as long as
+    // `in`. The output columns may be the input ones, for an in-place transform. Every candle is the same,
+    // bit for bit, as chaining HeikinAshi(current, previous candle) from HeikinAshi(first bar).
+    void heikin_ashi(const ColumnsOHLCV &in, std::span<double> open, std::span<double> high,
+                     std::span<double> low, std::span<double> close);
+
+    // Same, as a new series with the timestamps, volumes and symbol of `series`
+    ColumnarSeriesOHLCV heikin_ashi(const ColumnarSeriesOHLCV &series);
+
+    // Extends a Heikin-Ashi series one bar at a time in O(1). revise() takes the last bar again, e.g. while
+    // it is still forming, and replaces the last candle.
+    class HeikinAshiState {
+    private:
+        HeikinAshi m_last{};
+        HeikinAshi m_previous{};
+        size_t m_count = 0;
+
+    public:
+        HeikinAshiState() = default;
+
+        // Continues a series already transformed in batch from its last candles
+        explicit HeikinAshiState(const ColumnsOHLCV &candles);
+
+        const HeikinAshi &update(const OHLC &bar);
+
+        const HeikinAshi &revise(const OHLC &bar);
+
+        const HeikinAshi &update(const ColumnarSeriesOHLCV::Bar &bar);
+
+        const HeikinAshi &revise(const ColumnarSeriesOHLCV::Bar &bar);
+
+        [[nodiscard]] bool ready() const { return m_count > 0; }
+
+        [[nodiscard]] size_t count() const { return m_count; }
+
+        // Last candle; only meaningful once ready()
+        [[nodiscard]] const HeikinAshi &last() const { return m_last; }
+
+        void reset();
+    };
+
+    // Heikin-Ashi candles of a SeriesOHLCV computed while iterating, without a second copy of the series.
+    // Iteration is forward only, since each candle depends on the one before, and it holds the series lock
+    // like SeriesOHLCV::begin().
+    class HeikinAshiView {
+    private:
+        const SeriesOHLCV &m_series;
+
+    public:
+        explicit HeikinAshiView(const SeriesOHLCV &series);
+
+        class iterator {
+        private:
+            SeriesOHLCV::iterator m_iter;
+            SeriesOHLCV::iterator m_end;
+            std::pair<timestamp_t, HeikinAshi> m_current{};
+
+            void load(bool first);
+
+        public:
+            iterator(SeriesOHLCV::iterator it, SeriesOHLCV::iterator end);
+
+            iterator &operator++();
+
+            bool operator!=(const iterator &other) const;
+
+            const std::pair<timestamp_t, HeikinAshi> &operator*() const;
+
+            const std::pair<timestamp_t, HeikinAshi> *operator->() const;
+        };
+
+        [[nodiscard]] iterator begin() const;
+
+        [[nodiscard]] iterator end() const;
+    };
+}
+
+#endif //TRADING_COMMON_HEIKIN_ASHI_H
@@ -0,0 +1,106 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ID_H
+#define TRADING_COMMON_ID_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "nlohmann/json.hpp"
+
+namespace trading::common {
+
+    // Id of an order or a position: a 64 bit number from the id generator, or any text, e.g. an id read from
+    // JSON or given by an exchange. A number only becomes text, its decimal digits, when the id is serialized
+    // or compared with a text id, so generating one costs no formatting and no allocation.
+    class Id {
+    private:
+        // 0 for an id held as text
+        uint64_t m_number = 0;
+        std::string m_text;
+
+    public:
+        // Characters of the longest number
+        static constexpr size_t MAX_DIGITS = 20;
+
+        Id() = default;
+
+        // Implicit, as for the std::string that ids used to be
+        Id(std::string text) : m_text(std::move(text)) {}
+
+        Id(const char *text) : m_text(text) {}
+
+        // 0 gives an empty id
+        [[nodiscard]] static Id from_number(uint64_t number);
+
+        [[nodiscard]] bool is_number() const { return m_number != 0; }
+
+        // 0 for a text id
+        [[nodiscard]] uint64_t number() const { return m_number; }
+
+        // Empty for a number
+        [[nodiscard]] std::string_view text() const { return m_text; }
+
+        [[nodiscard]] bool empty() const { return m_number == 0 && m_text.empty(); }
+
+        // Length of the text
+        [[nodiscard]] size_t size() const;
+
+        // Writes the text at `out`, which has room for size() characters, and returns the end
+        char *format(char *out) const;
+
+        [[nodiscard]] std::string str() const;
+
+        explicit operator std::string() const { return str(); }
+
+        // Becomes a text id, reusing the memory of the previous text
+        void assign(std::string_view text);
+
+        // A number and a text are equal when the text is the number's digits
+        bool operator==(const Id &other) const;
+
+        // Equal ids hash alike: a text of a number's digits hashes as the number
+        [[nodiscard]] size_t hash() const;
+    };
+
+    // Ids are JSON strings, whatever they hold
+
+    void to_json(nlohmann::json &j, const Id &id);
+
+    void from_json(const nlohmann::json &j, Id &id);
+
+    // Source of the ids of new orders and positions
+    typedef Id (*id_generator_t)();
+
+    // Id for a new order or position, from the generator in use
+    [[nodiscard]] Id generate_id();
+
+    // The "id" string of a JSON object, or a new id when it has none, so that objects parsed from JSON only
+    // generate the ids they lack
+    [[nodiscard]] Id id_from_json(const nlohmann::json &object);
+
+    // Replaces the generator, e.g. with one that asks an external sequencer; nullptr restores next_id()
+    void set_id_generator(id_generator_t generator);
+
+    // The default generator, lock-free. A 64 bit id packs, from the top bit, the node (10 bits), a block
+    // (38 bits) and a sequence in the block (16 bits). Each thread takes a block of 65536 ids from a shared
+    // atomic counter and hands them out in order without further synchronization, so the ids of one thread
+    // increase and no two threads share one. Blocks are numbered from the seconds since 2024 times 64 at
+    // start-up, so a process restarted later does not repeat the ids of an earlier run that took fewer than
+    // 64 blocks, 4 million ids, per second of uptime.
+    [[nodiscard]] Id next_id();
+
+    // Node number of the ids of this process, that keeps processes on different machines apart. Blocks taken
+    // from now on use it; only the lower 10 bits count.
+    void set_node_id(uint16_t node);
+}
+
+template<>
+struct std::hash<trading::common::Id> {
+    size_t operator()(const trading::common::Id &id) const noexcept { return id.hash(); }
+};
+
+#endif //TRADING_COMMON_ID_H
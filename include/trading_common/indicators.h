@@ -0,0 +1,277 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_INDICATORS_H
+#define TRADING_COMMON_INDICATORS_H
+
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+#include <trading_common/aggregator.h>
+
+namespace trading::indicators {
+
+    using trading::common::price_t;
+    using trading::common::timestamp_t;
+    using Bar = trading::common::ColumnarSeriesOHLCV::Bar;
+
+    class IndicatorException : public std::exception {
+    private:
+        std::string message{};
+    public:
+        explicit IndicatorException(std::string message) : message(std::move(message)) {}
+
+        [[nodiscard]] const char *what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    // Streaming indicators. Every one takes each new bar in O(1) with update() and can take the last bar
+    // again with revise(), e.g. while the current bar is still forming, also in O(1). The memory they need
+    // is allocated in the constructor; updates never allocate. value() is only meaningful once ready().
+
+    // Simple moving average of the close
+    class SMA {
+    private:
+        std::vector<price_t> m_window;
+        size_t m_head = 0;
+        size_t m_count = 0;
+        double m_sum = 0;
+        double m_sum_squares = 0;
+
+        friend class Bollinger;
+
+    public:
+        explicit SMA(size_t period = 20);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] size_t period() const { return m_window.size(); }
+
+        [[nodiscard]] bool ready() const { return m_count >= m_window.size(); }
+
+        [[nodiscard]] price_t value() const;
+    };
+
+    // Exponential moving average of the close, seeded with the SMA of the first `period` values
+    class EMA {
+    private:
+        struct State {
+            size_t count = 0;
+            double value = 0;
+        };
+
+        size_t m_period;
+        double m_alpha;
+        State m_state{};
+        State m_previous{};
+
+        void apply(price_t value);
+
+    public:
+        explicit EMA(size_t period = 20);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] size_t period() const { return m_period; }
+
+        [[nodiscard]] bool ready() const { return m_state.count >= m_period; }
+
+        [[nodiscard]] price_t value() const { return m_state.value; }
+    };
+
+    // EMA(fast) - EMA(slow) of the close, with an EMA(signal) of that difference
+    class MACD {
+    private:
+        EMA m_fast;
+        EMA m_slow;
+        EMA m_signal;
+
+    public:
+        explicit MACD(size_t fast = 12, size_t slow = 26, size_t signal = 9);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] bool ready() const { return m_signal.ready(); }
+
+        [[nodiscard]] price_t value() const { return m_fast.value() - m_slow.value(); }
+
+        [[nodiscard]] price_t signal() const { return m_signal.value(); }
+
+        [[nodiscard]] price_t histogram() const { return value() - signal(); }
+    };
+
+    // Wilder's relative strength index of the close, 0 to 100
+    class RSI {
+    private:
+        struct State {
+            size_t count = 0;
+            price_t last = 0;
+            double gain = 0;
+            double loss = 0;
+        };
+
+        size_t m_period;
+        State m_state{};
+        State m_previous{};
+
+        void apply(price_t value);
+
+    public:
+        explicit RSI(size_t period = 14);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] size_t period() const { return m_period; }
+
+        // one change per value, so it takes period + 1 values
+        [[nodiscard]] bool ready() const { return m_state.count > m_period; }
+
+        [[nodiscard]] double value() const;
+    };
+
+    // Wilder's average true range
+    class ATR {
+    private:
+        struct State {
+            size_t count = 0;
+            price_t close = 0;
+            double value = 0;
+        };
+
+        size_t m_period;
+        State m_state{};
+        State m_previous{};
+
+        void apply(const Bar &bar);
+
+    public:
+        explicit ATR(size_t period = 14);
+
+        void update(const Bar &bar);
+
+        void revise(const Bar &bar);
+
+        [[nodiscard]] size_t period() const { return m_period; }
+
+        [[nodiscard]] bool ready() const { return m_state.count >= m_period; }
+
+        [[nodiscard]] price_t value() const { return m_state.value; }
+    };
+
+    // SMA of the close with bands `width` population standard deviations above and below
+    class Bollinger {
+    private:
+        SMA m_average;
+        double m_width;
+
+    public:
+        explicit Bollinger(size_t period = 20, double width = 2.0);
+
+        void update(price_t value) { m_average.update(value); }
+
+        void revise(price_t value) { m_average.revise(value); }
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] bool ready() const { return m_average.ready(); }
+
+        [[nodiscard]] price_t middle() const { return m_average.value(); }
+
+        [[nodiscard]] double deviation() const;
+
+        [[nodiscard]] price_t upper() const { return middle() + m_width * deviation(); }
+
+        [[nodiscard]] price_t lower() const { return middle() - m_width * deviation(); }
+    };
+
+    // Set of indicators over one bar stream, kept in one contiguous array per kind. add_* returns the index
+    // to read the indicator back with. A bar with the timestamp of the previous one revises it, a later one
+    // is a new bar and an earlier one is rejected.
+    class IndicatorEngine {
+    private:
+        std::vector<SMA> m_sma;
+        std::vector<EMA> m_ema;
+        std::vector<MACD> m_macd;
+        std::vector<RSI> m_rsi;
+        std::vector<ATR> m_atr;
+        std::vector<Bollinger> m_bollinger;
+        timestamp_t m_last = 0;
+        size_t m_count = 0;
+
+        template<typename T, typename... Args>
+        static size_t add(std::vector<T> &indicators, Args... args);
+
+    public:
+        IndicatorEngine() = default;
+
+        size_t add_sma(size_t period);
+
+        size_t add_ema(size_t period);
+
+        size_t add_macd(size_t fast = 12, size_t slow = 26, size_t signal = 9);
+
+        size_t add_rsi(size_t period = 14);
+
+        size_t add_atr(size_t period = 14);
+
+        size_t add_bollinger(size_t period = 20, double width = 2.0);
+
+        bool on_bar(const Bar &bar);
+
+        // Feeds every bar of a series, e.g. to warm up on history before streaming
+        void replay(const trading::common::ColumnsOHLCV &columns);
+
+        void replay(const trading::common::ColumnarSeriesOHLCV &series);
+
+        void replay(const trading::common::SeriesOHLCV &series);
+
+        // Callback for BarAggregator::on_bar that takes the bars of one timeframe. The engine must outlive it.
+        [[nodiscard]] trading::common::BarAggregator::callback_t callback(timestamp_t timeframe);
+
+        // bars taken so far, revisions not counted
+        [[nodiscard]] size_t count() const { return m_count; }
+
+        [[nodiscard]] const SMA &sma(size_t index) const { return m_sma.at(index); }
+
+        [[nodiscard]] const EMA &ema(size_t index) const { return m_ema.at(index); }
+
+        [[nodiscard]] const MACD &macd(size_t index) const { return m_macd.at(index); }
+
+        [[nodiscard]] const RSI &rsi(size_t index) const { return m_rsi.at(index); }
+
+        [[nodiscard]] const ATR &atr(size_t index) const { return m_atr.at(index); }
+
+        [[nodiscard]] const Bollinger &bollinger(size_t index) const { return m_bollinger.at(index); }
+    };
+}
+
+#endif //TRADING_COMMON_INDICATORS_H
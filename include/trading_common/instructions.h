@@ -6,10 +6,13 @@
 #define COMMON_INSTRUCTIONS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <common/common.h>
 #include <common/dates.h>
+#include <trading_common/clock.h>
+#include <trading_common/enum_names.h>
 
 namespace trading::instructions {
 
@@ -27,18 +30,19 @@ namespace trading::instructions {
         EMA = 5
     };
 
-    const std::map<Type, type_t> TypeNames = {
+    inline constexpr trading::common::EnumNames<Type, 6> TypeNames{{{
             {Type::NONE,   ""},
             {Type::TICKER, "ticker"},
             {Type::OHLC,   "ohlc"},
             {Type::MACD,   "macd"},
             {Type::SMA,    "sma"},
             {Type::EMA,    "ema"}
-    };
+    }}};
 
-    type_t get_type_name(Type type);
+    std::string_view get_type_name(Type type);
 
-    Type get_type_from_string(const type_t &type);
+    // Case-insensitive, NONE for an unknown name
+    Type get_type_from_string(std::string_view type);
 
     enum class Selector {
         NONE = 0,
@@ -47,16 +51,17 @@ namespace trading::instructions {
         SET = 3
     };
 
-    const std::map<Selector, selector_t> SelectorNames = {
+    inline constexpr trading::common::EnumNames<Selector, 4> SelectorNames{{{
             {Selector::NONE, ""},
             {Selector::ALL,  "all"},
             {Selector::ONE,  "one"},
             {Selector::SET,  "set"}
-    };
+    }}};
 
-    selector_t get_selector_name(Selector selector);
+    std::string_view get_selector_name(Selector selector);
 
-    Selector get_selector_from_string(const selector_t &selector);
+    // Case-insensitive, NONE for an unknown name
+    Selector get_selector_from_string(std::string_view selector);
 
     template<typename T>
     concept JsonSerializable = requires(T t, const nlohmann::json &j) {
@@ -70,7 +75,7 @@ namespace trading::instructions {
         Type type = Type::NONE;
         Selector selector = Selector::NONE;
         std::vector<std::string> tickers;
-        size_t timestamp = ::common::dates::get_unix_timestamp();
+        size_t timestamp = trading::common::now_timestamp();
         T other;
 
         bool validate() {
@@ -107,8 +112,8 @@ namespace trading::instructions {
 
         void from_json(const json &j) {
             try {
-                type = get_type_from_string(j.at("type").get<std::string>());
-                selector = get_selector_from_string(j.at("selector").get<std::string>());
+                type = get_type_from_string(j.at("type").get_ref<const std::string &>());
+                selector = get_selector_from_string(j.at("selector").get_ref<const std::string &>());
                 tickers = j.at("tickers").get<std::vector<std::string>>();
                 timestamp = j.at("timestamp").get<size_t>();
                 if (j.contains("other"))
@@ -0,0 +1,35 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_JSON_STREAM_H
+#define TRADING_COMMON_JSON_STREAM_H
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    using bar_callback_t = std::function<void(const ColumnarSeriesOHLCV::Bar &bar)>;
+
+    // Streaming readers for the array written by SeriesOHLCV::to_json(). The input is parsed incrementally
+    // with a SAX handler and every bar is handed over as soon as its object closes, so no DOM is built and
+    // memory stays bounded by the destination series. Unknown keys are skipped; a missing field or a
+    // malformed document throws OHLCException. All of them return the number of bars read.
+    size_t load_json(std::istream &in, const bar_callback_t &callback);
+
+    size_t load_json(std::istream &in, ColumnarSeriesOHLCV &series);
+
+    size_t load_json(std::istream &in, SeriesOHLCV &series, const symbol_t &symbol = {});
+
+    // Same as above, opening the file. Throws OHLCException when it cannot be opened.
+    size_t load_json_file(const std::string &path, const bar_callback_t &callback);
+
+    size_t load_json_file(const std::string &path, ColumnarSeriesOHLCV &series);
+}
+
+#endif //TRADING_COMMON_JSON_STREAM_H
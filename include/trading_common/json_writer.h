@@ -0,0 +1,112 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_JSON_WRITER_H
+#define TRADING_COMMON_JSON_WRITER_H
+
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <trading_common/common.h>
+#include <trading_common/columnar.h>
+#include <trading_common/instructions.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/order.h>
+#include <trading_common/position.h>
+
+namespace trading::common {
+
+    // Serializes bars, series, orders, positions and instructions straight into a reusable buffer, without
+    // building a json object first. The text is byte for byte what to_json().dump() gives: keys in sorted
+    // order, no spaces, doubles in the shortest form that json picks and non-finite ones as null, strings
+    // escaped the same way. clear() keeps the memory, so once the buffer has grown to the largest message a
+    // write() allocates nothing. Strings are expected to be valid UTF-8 and are copied through as they are.
+    class JsonWriter {
+    private:
+        // m_buffer only grows; its first m_size characters are the text
+        std::string m_buffer;
+        size_t m_size = 0;
+
+        // Room for `count` more characters at the end of the text
+        char *reserve(size_t count);
+
+    public:
+        JsonWriter() = default;
+
+        explicit JsonWriter(size_t capacity);
+
+        // Drops the text and keeps the memory for the next one
+        void clear() { m_size = 0; }
+
+        [[nodiscard]] std::string_view view() const { return {m_buffer.data(), m_size}; }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+
+        // Building blocks, for the JSON of other types
+
+        void raw(std::string_view text);
+
+        // Quoted and escaped
+        void string(std::string_view text);
+
+        void number(double value);
+
+        template<std::integral I> requires (!std::same_as<I, bool>)
+        void number(I value) {
+            // 20 characters hold any 64 bit integer with its sign
+            char *first = reserve(20);
+            m_size += std::to_chars(first, first + 20, value).ptr - first;
+        }
+
+        // A generated id is formatted straight into the buffer
+        void write(const Id &id);
+
+        void write(const OHLCV &ohlcv);
+
+        // An empty series is null, like its to_json()
+        void write(const SeriesOHLCV &series);
+
+        void write(const ColumnarSeriesOHLCV::Bar &bar);
+
+        void write(const ColumnarSeriesOHLCV &series);
+
+        // Instantiated for the price types of BasicOrder
+
+        template<typename P>
+        void write(const trading::order::BasicOrder<P> &order);
+
+        template<typename P>
+        void write(const trading::position::BasicPosition<P> &position);
+
+        // `other` is written by its write_json(JsonWriter &) when T has one, and through its to_json() otherwise
+        template<typename T>
+        void write(const trading::instructions::Instructions<T> &instructions) {
+            raw("{\"other\":");
+            if constexpr (requires(JsonWriter &writer) { instructions.other.write_json(writer); }) {
+                instructions.other.write_json(*this);
+            } else {
+                raw(instructions.other.to_json().dump());
+            }
+            raw(",\"selector\":");
+            string(trading::instructions::get_selector_name(instructions.selector));
+            raw(",\"tickers\":[");
+            for (size_t i = 0; i < instructions.tickers.size(); ++i) {
+                if (i > 0) {
+                    raw(",");
+                }
+                string(instructions.tickers[i]);
+            }
+            raw("],\"timestamp\":");
+            number(instructions.timestamp);
+            raw(",\"type\":");
+            string(trading::instructions::get_type_name(instructions.type));
+            raw("}");
+        }
+    };
+}
+
+#endif //TRADING_COMMON_JSON_WRITER_H
@@ -0,0 +1,70 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_KERNELS_H
+#define TRADING_COMMON_KERNELS_H
+
+#include <span>
+#include <string>
+
+namespace trading::kernels {
+
+    class KernelException : public std::exception {
+    private:
+        std::string message{};
+    public:
+        explicit KernelException(std::string message) : message(std::move(message)) {}
+
+        [[nodiscard]] const char *what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    enum class Isa {
+        SCALAR = 0,
+        AVX2 = 1,
+        AVX512 = 2
+    };
+
+    // Widest instruction set both the CPU and the build support
+    Isa supported_isa();
+
+    Isa active_isa();
+
+    // Selects the code path used by every kernel, e.g. to compare against the scalar one. Requests above
+    // supported_isa() are lowered to it; returns the one now in effect.
+    Isa set_isa(Isa isa);
+
+    const char *isa_name(Isa isa);
+
+    // Batch indicators over whole columns, such as ColumnarSeriesOHLCV::close() or the columns of a
+    // MappedSeriesOHLCV. `out` must be as long as the input. Positions without a full window are NaN.
+    // Inputs are expected to be finite; results agree with the scalar path within rounding.
+
+    void rolling_sum(std::span<const double> in, size_t window, std::span<double> out);
+
+    void rolling_mean(std::span<const double> in, size_t window, std::span<double> out);
+
+    // Seeded with the mean of the first `period` values, like indicators::EMA. The recurrence is serial, so
+    // this one has no vector path.
+    void ema(std::span<const double> in, size_t period, std::span<double> out);
+
+    // Short windows compare every element directly in vector registers; longer ones use van Herk /
+    // Gil-Werman, three comparisons per element whatever the window
+    void rolling_max(std::span<const double> in, size_t window, std::span<double> out);
+
+    void rolling_min(std::span<const double> in, size_t window, std::span<double> out);
+
+    // max(high - low, |high - previous close|, |low - previous close|); the first bar is high - low
+    void true_range(std::span<const double> high, std::span<const double> low, std::span<const double> close,
+                    std::span<double> out);
+
+    // in[i] / in[i - 1] - 1, the first one NaN
+    void returns(std::span<const double> in, std::span<double> out);
+
+    // log(in[i] / in[i - 1]), the first one NaN
+    void log_returns(std::span<const double> in, std::span<double> out);
+}
+
+#endif //TRADING_COMMON_KERNELS_H
@@ -0,0 +1,115 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_MARKET_DATA_STORE_H
+#define TRADING_COMMON_MARKET_DATA_STORE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/concurrent_series.h>
+
+namespace trading::common {
+
+    // Bars of a whole universe of symbols, one ConcurrentSeriesOHLCV per symbol.
+    //
+    // Symbols are spread over shards by id. A shard owns the series of its symbols and a lock that is only
+    // taken to add a symbol or to list the shard. Finding the series of a symbol takes no lock: symbol ids are
+    // dense, so it is found in a directory indexed by id, the same way SymbolTable finds names. Series are
+    // never removed, so pointers to them stay valid for the life of the store.
+    //
+    // Any thread may append. Appends to the same symbol are serialized by a per-symbol lock, so they must
+    // still come in increasing timestamp order; appends to different symbols run in parallel. Readers take
+    // lock-free snapshots and never block writers.
+    class MarketDataStore {
+    public:
+        using Bar = ConcurrentSeriesOHLCV::Bar;
+        using Snapshot = ConcurrentSeriesOHLCV::Snapshot;
+        using visitor_t = std::function<void(const symbol_t &symbol, const Snapshot &snapshot)>;
+
+        static constexpr size_t CHUNK_BITS = 10;
+        static constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+        static constexpr size_t MAX_CHUNKS = 4096;
+
+    private:
+        struct Entry {
+            ConcurrentSeriesOHLCV series;
+            std::mutex writer;
+
+            explicit Entry(symbol_t symbol) : series(symbol) {}
+        };
+
+        struct alignas(64) Shard {
+            mutable std::shared_mutex mutex;
+            std::vector<std::unique_ptr<Entry>> entries;
+        };
+
+        struct Chunk {
+            std::atomic<Entry *> entries[CHUNK_SIZE]{};
+        };
+
+        std::unique_ptr<Shard[]> m_shards;
+        size_t m_shard_mask;
+        std::unique_ptr<std::atomic<Chunk *>[]> m_directory;
+        std::atomic<size_t> m_size{0};
+
+        [[nodiscard]] Shard &shard_of(symbol_id_t id) const;
+
+        [[nodiscard]] Entry *lookup(symbol_id_t id) const;
+
+        Entry &entry(const symbol_t &symbol);
+
+        [[nodiscard]] std::vector<const Entry *> entries(size_t shard) const;
+
+    public:
+        // `shards` is rounded up to a power of two; 0 picks four per hardware thread
+        explicit MarketDataStore(size_t shards = 0);
+
+        ~MarketDataStore();
+
+        MarketDataStore(const MarketDataStore &) = delete;
+
+        MarketDataStore &operator=(const MarketDataStore &) = delete;
+
+        [[nodiscard]] size_t shards() const;
+
+        // Number of symbols
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool contains(const symbol_t &symbol) const;
+
+        // Returns false when the bar is not newer than the last one of its symbol
+        bool append(const OHLCV &ohlc);
+
+        bool append(const symbol_t &symbol, const Bar &bar);
+
+        // Appends bars of any number of symbols from `threads` threads (0 for one per hardware thread). Each
+        // symbol is handled by one thread, so its bars keep their order in `bars`. Returns how many were
+        // appended.
+        size_t ingest(std::span<const OHLCV> bars, size_t threads = 0);
+
+        // Series of one symbol, or nullptr. Lock-free.
+        [[nodiscard]] const ConcurrentSeriesOHLCV *series(const symbol_t &symbol) const;
+
+        [[nodiscard]] std::optional<Snapshot> snapshot(const symbol_t &symbol) const;
+
+        // Last bar of a symbol without taking a snapshot; nullopt for an unknown symbol or an empty series
+        [[nodiscard]] std::optional<Bar> last(const symbol_t &symbol) const;
+
+        [[nodiscard]] std::vector<symbol_t> symbols() const;
+
+        // Calls `visitor` with a snapshot of every symbol, from `threads` threads (0 for one per hardware
+        // thread), each walking its own shards. With more than one thread the visitor must be thread safe.
+        void for_each(const visitor_t &visitor, size_t threads = 1) const;
+    };
+}
+
+#endif //TRADING_COMMON_MARKET_DATA_STORE_H
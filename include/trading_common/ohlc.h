@@ -10,6 +10,10 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <trading_common/common.h>
 #include <common/dates.h>
 
@@ -21,6 +25,8 @@ namespace trading::common {
 
     std::string epoch_to_date_string(long long epoch); // TODO: moved to common
 
+    timestamp_t date_string_to_epoch(const std::string &date);
+
     class OHLCException : public std::exception {
     private:
         std::string message{};
@@ -90,8 +96,17 @@ namespace trading::common {
     };
 
 
+    // What insert does with a bar whose timestamp is already in the series
+    enum class DuplicatePolicy {
+        KEEP,       // the bar in the series stays, like std::map::insert
+        REPLACE,    // the new bar takes its place
+        AGGREGATE   // both become one bar: first open, highest high, lowest low, last close, summed volume
+    };
+
     struct HeikinAshi : public OHLC {
 
+        HeikinAshi() = default;
+
         explicit HeikinAshi(const OHLC &current, const OHLC &previous);
 
         explicit HeikinAshi(const OHLC &current);
@@ -106,6 +121,10 @@ namespace trading::common {
     public:
         SeriesOHLCV() = default;
 
+        SeriesOHLCV(const SeriesOHLCV &other);
+
+        SeriesOHLCV &operator=(const SeriesOHLCV &other);
+
         explicit SeriesOHLCV(const json &j);
 
         [[nodiscard]] json to_json() const;
@@ -114,24 +133,39 @@ namespace trading::common {
 
         [[nodiscard]] size_t size();
 
-        bool insert(const OHLCV &ohlc);
+        // A bar newer than the last one is appended at the end of the map in constant time.
+        bool insert(const OHLCV &ohlc, DuplicatePolicy policy = DuplicatePolicy::KEEP);
 
-        bool insert(const SeriesOHLCV &ohlc);
+        // Merges another series, holding the locks of both. Linear in the bars of both when they interleave.
+        bool insert(const SeriesOHLCV &ohlc, DuplicatePolicy policy = DuplicatePolicy::KEEP);
 
+        // Bulk insert. A batch sorted by timestamp is merged in one pass; an unsorted one is first sorted on
+        // `threads` threads (0 for one per hardware thread), outside the lock. Bars of the batch that share a
+        // timestamp are applied in batch order.
+        bool insert(std::span<const OHLCV> bars, DuplicatePolicy policy = DuplicatePolicy::KEEP, size_t threads = 1);
+
+        // Creates an empty bar when there is none at `timestamp`; use find() to look up without inserting.
         OHLCV &operator[](timestamp_t timestamp);
 
         OHLCV &operator[](const std::string &date);
 
+        // Lookups in O(log n) that leave the series untouched on a miss. They return a copy of the bar.
+
+        [[nodiscard]] std::optional<OHLCV> find(timestamp_t timestamp) const;
+
+        // Last bar at or before `timestamp`
+        [[nodiscard]] std::optional<OHLCV> as_of(timestamp_t timestamp) const;
+
+        // begin() and rbegin() lock the series until the last copy of the returned iterator is destroyed.
+        // For readers that must not block the writer see ConcurrentSeriesOHLCV.
         class iterator {
         private:
             std::map<timestamp_t, OHLCV>::const_iterator iter;
-            const SeriesOHLCV *series;
-            bool isEnd;
+            std::shared_ptr<std::unique_lock<std::mutex>> lock;
 
         public:
-            iterator(std::map<timestamp_t, OHLCV>::const_iterator it, const SeriesOHLCV *s, bool end = false);
-
-            ~iterator();
+            explicit iterator(std::map<timestamp_t, OHLCV>::const_iterator it,
+                              std::shared_ptr<std::unique_lock<std::mutex>> lock = nullptr);
 
             iterator &operator++();
 
@@ -151,6 +185,29 @@ namespace trading::common {
 
         iterator rend() const;
 
+        // Bars of a range query, iterated in place without copying. Like begin(), it keeps the series locked
+        // until the range and every iterator taken from it are destroyed.
+        class Range {
+        private:
+            iterator m_begin;
+            iterator m_end;
+
+        public:
+            Range(iterator begin, iterator end);
+
+            [[nodiscard]] iterator begin() const;
+
+            [[nodiscard]] iterator end() const;
+
+            [[nodiscard]] bool empty() const;
+        };
+
+        // Bars with from <= timestamp < to, located in O(log n)
+        [[nodiscard]] Range range(timestamp_t from, timestamp_t to) const;
+
+        // The last `count` bars, or all of them when there are fewer
+        [[nodiscard]] Range last(size_t count) const;
+
     };
 }
 
@@ -8,7 +8,10 @@
 #include <cstdlib>
 #include <string>
 #include <common/common.h>
+#include <trading_common/clock.h>
 #include <trading_common/common.h>
+#include <trading_common/enum_names.h>
+#include <trading_common/fixed_price.h>
 #include <trading_common/ohlc.h>
 
 using OHLC = trading::common::OHLC;
@@ -51,27 +54,54 @@ namespace trading::order {
         CANCELED = 4
     };
 
-
-    struct Order {
-        id_t_ id = ::common::key_generator();
-        timestamp_t timestamp = ::common::dates::get_unix_timestamp();
+    // Names in the JSON of an order, parsed in any case
+
+    inline constexpr EnumNames<Side, 3> SideNames{{{
+            {Side::NONE, "NONE"},
+            {Side::BUY, "BUY"},
+            {Side::SELL, "SELL"}
+    }}};
+
+    inline constexpr EnumNames<Type, 3> TypeNames{{{
+            {Type::NONE, "NONE"},
+            {Type::MARKET, "MARKET"},
+            {Type::LIMIT, "LIMIT"}
+    }}};
+
+    inline constexpr EnumNames<Status, 5> StatusNames{{{
+            {Status::NONE, "NONE"},
+            {Status::OPEN, "OPEN"},
+            {Status::CLOSED, "CLOSED"},
+            {Status::FILLED, "FILLED"},
+            {Status::CANCELED, "CANCELED"}
+    }}};
+
+
+    // Order templated on the price type P: price_t, or a FixedPrice for exact integer arithmetic. Instantiated
+    // for price_t and FixedPrice<2>, <4> and <8>; Order keeps price_t.
+    template<typename P>
+    struct BasicOrder {
+        using price_type = P;
+
+        id_t_ id = generate_id();
+        timestamp_t timestamp = now_timestamp();
         size_t quantity = 0;
-        symbol_t symbol = std::make_shared<std::string>();
+        symbol_t symbol{};
         Side side = Side::NONE;
         size_t filled = 0;
-        price_t filled_at_price = 0;
-        price_t limit_price = 0;
+        P filled_at_price{};
+        P limit_price{};
 
         Type type = Type::NONE;
         Status status = Status::NONE;
 
-        Order() = default;
+        BasicOrder() = default;
 
-        Order(timestamp_t timestamp, size_t quantity, symbol_t symbol, Side side, size_t filled,
-              price_t filled_at_price,
-              price_t limit_price, id_t_ id, Type type, Status status);
+        BasicOrder(timestamp_t timestamp, size_t quantity, symbol_t symbol, Side side, size_t filled,
+                   P filled_at_price,
+                   P limit_price, id_t_ id, Type type, Status status);
 
-        explicit Order(json &j);
+        explicit BasicOrder(json &j);
 
         void check_match_price(OHLC &ohlc);
 
@@ -91,5 +121,7 @@ namespace trading::order {
 
     };
 
+    using Order = BasicOrder<price_t>;
+
 }
 #endif //TRADING_COMMON_ORDER_H
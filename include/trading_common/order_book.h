@@ -0,0 +1,183 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ORDER_BOOK_H
+#define TRADING_COMMON_ORDER_BOOK_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <trading_common/order.h>
+
+namespace trading::order {
+
+    // One execution between an incoming order, the taker, and a resting one, the maker, at the maker's limit
+    // price. The orders are as they stand after the execution: filled, average filled_at_price and status.
+    template<typename P>
+    struct BasicFill {
+        const BasicOrder<P> *taker = nullptr;
+        const BasicOrder<P> *maker = nullptr;
+        size_t quantity = 0;
+        P price{};
+
+        // The execution alone as a FILLED order of one side, with the id, type and limit price of that side's
+        // order and the taker's timestamp: what Position::apply_order takes
+        [[nodiscard]] BasicOrder<P> taker_execution() const;
+
+        [[nodiscard]] BasicOrder<P> maker_execution() const;
+    };
+
+    // Limit order book of one symbol, matching by price-time priority. Market orders and limit orders that
+    // cross the spread fill against the best opposite levels, oldest order first, with partial fills; what a
+    // limit order has left rests, what a market order has left is canceled.
+    //
+    // Price levels are ordered in one array per side, best last, so that the levels matched and the ones new
+    // orders join are at the end, and each keeps its orders in a FIFO list linked by index through a pool.
+    // An open addressing table from id hash to pool slot makes cancel and amend O(1), except for removing a
+    // level left empty away from the top, which shifts the better levels. Nothing is allocated per order once
+    // the pool and the table have grown to the book's size. Instantiated for price_t and FixedPrice<2>, <4> and <8>;
+    // OrderBook keeps price_t.
+    template<typename P>
+    class BasicOrderBook {
+    public:
+        using price_type = P;
+        using Order = BasicOrder<P>;
+        using Fill = BasicFill<P>;
+        using callback_t = std::function<void(const Fill &fill)>;
+
+        struct AddResult : public ValidateResult {
+            // Quantity filled on arrival
+            size_t filled = 0;
+            // Whether a remainder rests in the book
+            bool resting = false;
+            // Remainder of a market order left unfilled by the book, and canceled
+            size_t canceled = 0;
+        };
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        // Part of a resting order walked by matching; the order itself is in m_orders at the same index
+        struct Node {
+            size_t remaining = 0;
+            uint64_t hash = 0;
+            uint32_t level = NONE;
+            uint32_t previous = NONE;
+            uint32_t next = NONE;
+        };
+
+        struct Level {
+            size_t quantity = 0;
+            uint32_t head = NONE;
+            uint32_t tail = NONE;
+        };
+
+        struct Rung {
+            P price{};
+            uint32_t level = NONE;
+        };
+
+        symbol_t m_symbol;
+        callback_t m_callback;
+
+        // bids ascending and asks descending, so that the best price of each side is last
+        std::vector<Rung> m_bids;
+        std::vector<Rung> m_asks;
+        std::vector<Level> m_levels;
+        std::vector<uint32_t> m_free_levels;
+
+        std::vector<Node> m_nodes;
+        std::vector<Order> m_orders;
+        std::vector<uint32_t> m_free_orders;
+
+        // Pool slots of the resting orders by id, probed linearly from the top bits of the id hash times a
+        // constant; never more than half full. Ids are only compared on a hash match, in m_orders.
+        struct Entry {
+            uint64_t hash = 0;
+            uint32_t order = NONE;
+        };
+        std::vector<Entry> m_index;
+        int m_index_shift = 64;
+        size_t m_size = 0;
+
+        std::vector<Rung> &ladder(Side side) { return side == Side::BUY ? m_bids : m_asks; }
+
+        const std::vector<Rung> &ladder(Side side) const { return side == Side::BUY ? m_bids : m_asks; }
+
+        // Index of the rung of a price in its side, or where it would go
+        size_t position(Side side, P price) const;
+
+        [[nodiscard]] size_t home(uint64_t hash) const;
+
+        // Pool slot of the resting order with the id, or NONE
+        [[nodiscard]] uint32_t lookup(const id_t_ &id) const;
+
+        void grow_index(size_t capacity);
+
+        void add_to_index(uint64_t hash, uint32_t order);
+
+        // Empties the entry of a pool slot, shifting back the entries probed past it
+        void remove_from_index(uint64_t hash, uint32_t order);
+
+        size_t execute(Order &order);
+
+        void rest(Order &&order);
+
+        // Unlinks a resting order, takes it out of the index and frees its slot and, if it was the last of its
+        // level, the level
+        void remove(uint32_t index);
+
+        void remove_level(Side side, P price, uint32_t level);
+
+    public:
+        explicit BasicOrderBook(symbol_t symbol);
+
+        // Called for every execution, in order. Must not change the book; the orders it points to are only
+        // valid during the call.
+        void on_fill(callback_t callback);
+
+        // Room for `orders` resting orders without reallocating
+        void reserve(size_t orders);
+
+        // Matches an OPEN, unfilled, valid order of the book's symbol and rests what a limit order has left;
+        // what a market order has left is returned as canceled. Rejected, with a message, if an order with the
+        // same id is resting.
+        AddResult add(Order order);
+
+        // False if no order with the id is resting
+        bool cancel(const id_t_ &id);
+
+        // Changes the total quantity and the limit price of a resting order. Reducing the quantity at the same
+        // price keeps the order's place in its queue; any other change sends it to the back of the queue of
+        // the new price, matching it first if that crosses the spread. A quantity not above what is already
+        // filled cancels the order. False if no order with the id is resting or the price is 0.
+        bool amend(const id_t_ &id, size_t quantity, P limit_price);
+
+        // The resting order with the id, or nullptr
+        [[nodiscard]] const Order *find(const id_t_ &id) const;
+
+        // Best price of a side, or P{} if the side is empty
+        [[nodiscard]] P best_bid() const;
+
+        [[nodiscard]] P best_ask() const;
+
+        // Resting quantity at a price of a side
+        [[nodiscard]] size_t volume_at(Side side, P price) const;
+
+        // Number of price levels of a side
+        [[nodiscard]] size_t levels(Side side) const;
+
+        // Number of resting orders
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] const symbol_t &symbol() const;
+    };
+
+    using Fill = BasicFill<price_t>;
+    using OrderBook = BasicOrderBook<price_t>;
+}
+
+#endif //TRADING_COMMON_ORDER_BOOK_H
@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <trading_common/common.h>
 #include <trading_common/position.h>
 
@@ -14,9 +15,14 @@ namespace trading::pnl {
 
     using Position = trading::position::Position;
 
-    class PnL {
+    // Cash and open positions of a portfolio, templated on the price type like BasicPosition. Instantiated for
+    // price_t and FixedPrice<2>, <4> and <8>; PnL keeps price_t.
+    template<typename P>
+    class BasicPnL {
     public:
-        PnL() = default;
+        using Position = trading::position::BasicPosition<P>;
+
+        BasicPnL() = default;
 
         void add_position(const Position& position) ;
 
@@ -26,13 +32,15 @@ namespace trading::pnl {
 
         void delete_position(const symbol_value_t& symbol);
 
-        void add_cash(price_t cashAmount);
+        void add_cash(P cashAmount);
 
-        [[nodiscard]] price_t calculate_total_value() const;
+        [[nodiscard]] P calculate_total_value() const;
 
     private:
-        std::map<symbol_value_t, std::shared_ptr<Position>> positions;
-        price_t cash = 0;
+        std::unordered_map<symbol_id_t, std::shared_ptr<Position>> positions;
+        P cash{};
     };
+
+    using PnL = BasicPnL<price_t>;
 }
 #endif //TRADING_COMMON_PNL_H
@@ -9,6 +9,7 @@
 #include <cstdlib>
 //#include <string>
 #include <common/common.h>
+#include <trading_common/clock.h>
 #include <trading_common/common.h>
 #include <trading_common/ohlc.h>
 #include <trading_common/order.h>
@@ -24,50 +25,65 @@ namespace trading::position {
         SHORT = 2
     };
 
+    // Names in the JSON of a position, parsed in any case
+    inline constexpr EnumNames<Side, 3> SideNames{{{
+            {Side::NONE, "NONE"},
+            {Side::LONG, "LONG"},
+            {Side::SHORT, "SHORT"}
+    }}};
 
 
-    class Position {
+    // Position templated on the price type like trading::order::BasicOrder. With a FixedPrice the entry price
+    // averages and the PnL are integer arithmetic, the average rounded to the nearest tick. Instantiated for
+    // price_t and FixedPrice<2>, <4> and <8>; Position keeps price_t.
+    template<typename P>
+    class BasicPosition {
     public:
+        using price_type = P;
+        using Order = trading::order::BasicOrder<P>;
+
         struct ApplyOrderResult : public Result {
-            price_t pnl = 0;
+            P pnl{};
         };
 
-        id_t_ id = ::common::key_generator();
-        timestamp_t timestamp = ::common::dates::get_unix_timestamp();
+        id_t_ id = generate_id();
+        timestamp_t timestamp = now_timestamp();
         size_t balance = 0;
-        symbol_t symbol = std::make_shared<symbol_value_t>();
+        symbol_t symbol{};
         Side side = Side::NONE;
-        price_t entry_price = 0;
-        price_t current_price = 0;
-        price_t pnl = 0;
+        P entry_price{};
+        P current_price{};
+        P pnl{};
 
-        Position() = default;
+        BasicPosition() = default;
 
-        Position(id_t_ id, timestamp_t timestamp, size_t balance, symbol_t symbol, Side side, price_t entry_price,
-                 price_t current_price, price_t pnl);
+        BasicPosition(id_t_ id, timestamp_t timestamp, size_t balance, symbol_t symbol, Side side, P entry_price,
+                      P current_price, P pnl);
 
-        explicit Position(json &j);
+        explicit BasicPosition(json &j);
 
         bool validate() const;
 
-        void set_current_price(price_t cp);
+        void set_current_price(P cp);
 
-        [[nodiscard]] price_t get_pnl() const;
+        [[nodiscard]] P get_pnl() const;
 
         [[nodiscard]] json to_json() const;
 
-        ApplyOrderResult apply_order(const trading::order::Order &order);
+        ApplyOrderResult apply_order(const Order &order);
 
     private:
-        Position::ApplyOrderResult apply_order_for_empty_position(const trading::order::Order &order);
+        ApplyOrderResult apply_order_for_empty_position(const Order &order);
 
-        Position::ApplyOrderResult apply_order_for_long_position(const trading::order::Order &order);
+        ApplyOrderResult apply_order_for_long_position(const Order &order);
 
-        Position::ApplyOrderResult apply_order_for_short_position(const trading::order::Order &order);
+        ApplyOrderResult apply_order_for_short_position(const Order &order);
 
-        static Position::ApplyOrderResult validateOrder(const trading::order::Order &order);
+        static ApplyOrderResult validateOrder(const Order &order);
 
     };
 
+    using Position = BasicPosition<price_t>;
+
 }
 #endif //TRADING_COMMON_POSITION_H
@@ -0,0 +1,33 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_RESAMPLE_H
+#define TRADING_COMMON_RESAMPLE_H
+
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    enum class Alignment {
+        // buckets start at multiples of the timeframe since the epoch
+        EPOCH = 0,
+        // buckets start at local midnight, the same day boundaries used for Timestamp::date
+        CALENDAR_DAY = 1
+    };
+
+    // Groups the bars into buckets of `timeframe` (seconds) and reduces each bucket to one bar: first open,
+    // max high, min low, last close and summed volume. The bar of a bucket is stamped with the bucket start.
+    // CALENDAR_DAY alignment needs a timeframe that is a whole number of days.
+    ColumnarSeriesOHLCV resample(const ColumnsOHLCV &columns, timestamp_t timeframe,
+                                 Alignment alignment = Alignment::EPOCH, symbol_t symbol = {});
+
+    ColumnarSeriesOHLCV resample(const ColumnarSeriesOHLCV &series, timestamp_t timeframe,
+                                 Alignment alignment = Alignment::EPOCH);
+
+    SeriesOHLCV resample(const SeriesOHLCV &series, timestamp_t timeframe, Alignment alignment = Alignment::EPOCH);
+}
+
+#endif //TRADING_COMMON_RESAMPLE_H
@@ -0,0 +1,112 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ROLLING_SERIES_H
+#define TRADING_COMMON_ROLLING_SERIES_H
+
+#include <array>
+#include <optional>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+
+namespace trading::common {
+
+    // The last capacity() bars of a series, in a ring of columns allocated once in the constructor. Appending
+    // a bar when full evicts the oldest one; neither allocates, so the memory of a series is fixed at
+    // BYTES_PER_BAR * capacity plus the object itself.
+    //
+    // Bars keep the SeriesOHLCV semantics: inserting a timestamp that is already held keeps the existing bar.
+    // New bars must be newer than the last one; an older bar not in the window is refused, since moving the
+    // ring to make room for it would not be O(1). Not internally synchronized.
+    class RollingSeriesOHLCV {
+    public:
+        using Bar = ColumnarSeriesOHLCV::Bar;
+
+        static constexpr size_t BYTES_PER_BAR = sizeof(timestamp_t) + 4 * sizeof(double) + sizeof(size_t);
+
+    private:
+        symbol_t m_symbol{};
+        std::vector<timestamp_t> m_timestamp;
+        std::vector<double> m_open;
+        std::vector<double> m_high;
+        std::vector<double> m_low;
+        std::vector<double> m_close;
+        std::vector<size_t> m_volume;
+        size_t m_head = 0;
+        size_t m_size = 0;
+
+        [[nodiscard]] size_t physical(size_t index) const;
+
+    public:
+        explicit RollingSeriesOHLCV(size_t capacity, symbol_t symbol = {});
+
+        [[nodiscard]] const symbol_t &symbol() const;
+
+        [[nodiscard]] size_t capacity() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] bool full() const;
+
+        void clear();
+
+        // Returns false for a bar older than the last one that is not already in the window
+        bool insert(const OHLCV &ohlc);
+
+        bool insert(const Bar &bar);
+
+        // Index 0 is the oldest bar in the window
+        [[nodiscard]] Bar at(size_t index) const;
+
+        // Oldest and newest bars; throw OHLCException when the window is empty
+        [[nodiscard]] Bar front() const;
+
+        [[nodiscard]] Bar back() const;
+
+        [[nodiscard]] std::optional<Bar> find(timestamp_t timestamp) const;
+
+        [[nodiscard]] std::optional<Bar> as_of(timestamp_t timestamp) const;
+
+        // The window as at most two contiguous runs of columns, oldest first; the second one is empty until the
+        // ring wraps. Invalidated by the next insertion.
+        [[nodiscard]] std::array<ColumnsOHLCV, 2> segments() const;
+
+        [[nodiscard]] ColumnarSeriesOHLCV to_columnar() const;
+
+        [[nodiscard]] json to_json() const;
+
+        class iterator {
+        private:
+            const RollingSeriesOHLCV *series;
+            std::ptrdiff_t index;
+
+        public:
+            iterator(const RollingSeriesOHLCV *s, std::ptrdiff_t i);
+
+            iterator &operator++();
+
+            iterator &operator--();
+
+            bool operator==(const iterator &other) const;
+
+            bool operator!=(const iterator &other) const;
+
+            std::pair<const timestamp_t, Bar> operator*() const;
+        };
+
+        [[nodiscard]] iterator begin() const;
+
+        [[nodiscard]] iterator rbegin() const;
+
+        [[nodiscard]] iterator end() const;
+
+        [[nodiscard]] iterator rend() const;
+    };
+}
+
+#endif //TRADING_COMMON_ROLLING_SERIES_H
@@ -0,0 +1,268 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_ROLLING_STATS_H
+#define TRADING_COMMON_ROLLING_STATS_H
+
+#include <optional>
+#include <vector>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/columnar.h>
+#include <trading_common/aggregator.h>
+#include <trading_common/calendar.h>
+#include <trading_common/indicators.h>
+
+namespace trading::indicators {
+
+    // Rolling statistics over the last `period` values, with the same contract as the indicators: update() and
+    // revise() are O(1) (amortized for the extremes), memory is allocated in the constructor and value() is
+    // only meaningful once ready().
+
+    // Mean and variance of the close over a window, updated with Welford's recurrence so they do not suffer the
+    // cancellation of sum and sum of squares. They are recomputed from the window once per period.
+    class RollingVariance {
+    private:
+        std::vector<double> m_window;
+        size_t m_head = 0;
+        size_t m_count = 0;
+        double m_mean = 0;
+        // sum of squared differences from the mean
+        double m_m2 = 0;
+
+        // replaces `removed` by `added` in a window of n values
+        void replace(double removed, double added, size_t n);
+
+    public:
+        explicit RollingVariance(size_t period = 20);
+
+        void update(double value);
+
+        void revise(double value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] size_t period() const { return m_window.size(); }
+
+        // values taken so far, revisions not counted
+        [[nodiscard]] size_t count() const { return m_count; }
+
+        [[nodiscard]] bool ready() const { return m_count >= m_window.size(); }
+
+        [[nodiscard]] double mean() const { return m_mean; }
+
+        // population variance
+        [[nodiscard]] double variance() const;
+
+        // variance with Bessel's correction, 0 until there are two values
+        [[nodiscard]] double sample_variance() const;
+
+        // population standard deviation
+        [[nodiscard]] double stddev() const;
+
+        [[nodiscard]] double value() const { return variance(); }
+    };
+
+    // Highest (MAX) or lowest value over a window, with a monotonic deque kept in a ring. The last value is
+    // held outside the deque so revise() only replaces it; update() settles it into the deque.
+    template<bool MAX>
+    class RollingExtreme {
+    private:
+        struct Entry {
+            size_t index;
+            price_t value;
+        };
+
+        size_t m_period;
+        std::vector<Entry> m_deque;
+        size_t m_front = 0;
+        size_t m_size = 0;
+        size_t m_count = 0;
+        price_t m_last = 0;
+
+        [[nodiscard]] static bool better(price_t a, price_t b) { return MAX ? a > b : a < b; }
+
+        [[nodiscard]] size_t slot(size_t offset) const;
+
+    public:
+        explicit RollingExtreme(size_t period = 20);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        // the high of a bar for RollingMax, the low for RollingMin
+        void update(const Bar &bar) { update(MAX ? bar.high : bar.low); }
+
+        void revise(const Bar &bar) { revise(MAX ? bar.high : bar.low); }
+
+        [[nodiscard]] size_t period() const { return m_period; }
+
+        [[nodiscard]] bool ready() const { return m_count >= m_period; }
+
+        [[nodiscard]] price_t value() const;
+    };
+
+    using RollingMax = RollingExtreme<true>;
+    using RollingMin = RollingExtreme<false>;
+
+    // Donchian channel: highest high and lowest low over a window
+    class Donchian {
+    private:
+        RollingMax m_upper;
+        RollingMin m_lower;
+
+    public:
+        explicit Donchian(size_t period = 20);
+
+        void update(const Bar &bar);
+
+        void revise(const Bar &bar);
+
+        [[nodiscard]] size_t period() const { return m_upper.period(); }
+
+        [[nodiscard]] bool ready() const { return m_upper.ready(); }
+
+        [[nodiscard]] price_t upper() const { return m_upper.value(); }
+
+        [[nodiscard]] price_t lower() const { return m_lower.value(); }
+
+        [[nodiscard]] price_t middle() const { return (upper() + lower()) / 2; }
+    };
+
+    // Volume weighted average of the typical price (high + low + close) / 3 over the last `period` bars. With no
+    // volume traded in the window it is the typical price of the last bar.
+    class VWAP {
+    private:
+        std::vector<double> m_value;
+        std::vector<size_t> m_volume;
+        size_t m_head = 0;
+        size_t m_count = 0;
+        double m_sum_value = 0;
+        // integral, so it is kept exactly
+        size_t m_sum_volume = 0;
+        price_t m_typical = 0;
+
+    public:
+        explicit VWAP(size_t period = 20);
+
+        void update(const Bar &bar);
+
+        void revise(const Bar &bar);
+
+        [[nodiscard]] size_t period() const { return m_value.size(); }
+
+        [[nodiscard]] bool ready() const { return m_count >= m_value.size(); }
+
+        [[nodiscard]] size_t volume() const { return m_sum_volume; }
+
+        [[nodiscard]] price_t value() const;
+    };
+
+    // VWAP accumulated since the start of the session, which restarts at each local midnight of `zone`
+    class SessionVWAP {
+    private:
+        struct State {
+            size_t count = 0;
+            int64_t day = 0;
+            double value = 0;
+            size_t volume = 0;
+            price_t typical = 0;
+        };
+
+        trading::common::TimeZone m_zone;
+        State m_state{};
+        State m_previous{};
+
+        void apply(const Bar &bar);
+
+    public:
+        explicit SessionVWAP(trading::common::TimeZone zone = trading::common::TimeZone::utc());
+
+        void update(const Bar &bar);
+
+        void revise(const Bar &bar);
+
+        void reset();
+
+        [[nodiscard]] bool ready() const { return m_state.count > 0; }
+
+        // bars in the current session
+        [[nodiscard]] size_t count() const { return m_state.count; }
+
+        [[nodiscard]] size_t volume() const { return m_state.volume; }
+
+        [[nodiscard]] price_t value() const;
+    };
+
+    // Sample standard deviation of the log returns of the close over the last `period` returns, times
+    // sqrt(annualization), e.g. 252 for daily bars. It takes period + 1 closes to be ready.
+    class RealizedVolatility {
+    private:
+        RollingVariance m_returns;
+        double m_annualization;
+        size_t m_count = 0;
+        price_t m_last = 0;
+        // close before the last one, to revise the last return
+        price_t m_before = 0;
+
+    public:
+        explicit RealizedVolatility(size_t period = 20, double annualization = 1);
+
+        void update(price_t value);
+
+        void revise(price_t value);
+
+        void update(const Bar &bar) { update(bar.close); }
+
+        void revise(const Bar &bar) { revise(bar.close); }
+
+        [[nodiscard]] size_t period() const { return m_returns.period(); }
+
+        [[nodiscard]] bool ready() const { return m_returns.ready(); }
+
+        [[nodiscard]] double value() const;
+    };
+
+    // Feeds every bar of a series to one indicator, e.g. to warm it up on history. Works with any class of this
+    // file or of indicators.h; use IndicatorEngine to drive many at once.
+    template<typename Indicator>
+    void replay(Indicator &indicator, const trading::common::ColumnsOHLCV &columns) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            indicator.update(Bar{columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i],
+                                 columns.close[i], columns.volume[i]});
+        }
+    }
+
+    template<typename Indicator>
+    void replay(Indicator &indicator, const trading::common::SeriesOHLCV &series) {
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            const auto &[timestamp, ohlc] = *it;
+            indicator.update(Bar{timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+        }
+    }
+
+    // Callback for BarAggregator::on_bar that feeds the bars of one timeframe to one indicator, with the rules of
+    // IndicatorEngine::on_bar: the same timestamp again revises, an earlier one is dropped. The indicator must
+    // outlive it.
+    template<typename Indicator>
+    trading::common::BarAggregator::callback_t callback(Indicator &indicator, timestamp_t timeframe) {
+        return [&indicator, timeframe, last = std::optional<timestamp_t>{}](timestamp_t bar_timeframe,
+                                                                            const Bar &bar) mutable {
+            if (bar_timeframe != timeframe || (last && bar.timestamp < *last)) {
+                return;
+            }
+            if (last && bar.timestamp == *last) {
+                indicator.revise(bar);
+            } else {
+                indicator.update(bar);
+                last = bar.timestamp;
+            }
+        };
+    }
+}
+
+#endif //TRADING_COMMON_ROLLING_STATS_H
@@ -0,0 +1,118 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_SYMBOL_TABLE_H
+#define TRADING_COMMON_SYMBOL_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace trading::common {
+
+    typedef uint32_t symbol_id_t;
+
+    // Process-wide table that maps tickers to dense ids. Ids start at 0, which is always the empty symbol, and
+    // are never reused, so they can index arrays. Interning takes a lock; looking a name up by id does not.
+    class SymbolTable {
+    public:
+        static constexpr size_t CHUNK_BITS = 10;
+        static constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+        static constexpr size_t MAX_CHUNKS = 4096;
+
+        static SymbolTable &global();
+
+        SymbolTable();
+
+        ~SymbolTable();
+
+        SymbolTable(const SymbolTable &) = delete;
+
+        SymbolTable &operator=(const SymbolTable &) = delete;
+
+        symbol_id_t intern(std::string_view name);
+
+        [[nodiscard]] std::optional<symbol_id_t> find(std::string_view name) const;
+
+        [[nodiscard]] const std::string &name(symbol_id_t id) const;
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        using Chunk = std::array<std::string, CHUNK_SIZE>;
+
+        std::unique_ptr<std::atomic<Chunk *>[]> m_chunks;
+        std::unordered_map<std::string_view, symbol_id_t> m_ids;
+        std::atomic<size_t> m_size{0};
+        mutable std::shared_mutex m_mutex;
+    };
+
+    // Handle to a symbol interned in SymbolTable::global(). It is four bytes, copies without touching any
+    // reference count and compares and hashes by id. Dereferencing gives the ticker for I/O. The default
+    // value is the empty symbol; a null handle, built from nullptr, dereferences to the empty string too.
+    class InternedSymbol {
+    private:
+        symbol_id_t m_id = 0;
+
+        struct from_id_tag {
+        };
+
+        InternedSymbol(symbol_id_t id, from_id_tag) : m_id(id) {}
+
+    public:
+        static constexpr symbol_id_t NULL_ID = UINT32_MAX;
+
+        InternedSymbol() = default;
+
+        InternedSymbol(std::nullptr_t) : m_id(NULL_ID) {}
+
+        // Kept implicit so code written against the former shared_ptr<std::string> symbols still compiles.
+        InternedSymbol(const std::shared_ptr<std::string> &name);
+
+        explicit InternedSymbol(std::string_view name);
+
+        explicit InternedSymbol(const std::string &name) : InternedSymbol(std::string_view(name)) {}
+
+        explicit InternedSymbol(const char *name) : InternedSymbol(std::string_view(name)) {}
+
+        static InternedSymbol from_id(symbol_id_t id) { return {id, from_id_tag{}}; }
+
+        [[nodiscard]] symbol_id_t id() const { return m_id; }
+
+        [[nodiscard]] const std::string &str() const;
+
+        [[nodiscard]] std::string_view view() const { return str(); }
+
+        const std::string &operator*() const { return str(); }
+
+        const std::string *operator->() const { return &str(); }
+
+        explicit operator bool() const { return m_id != NULL_ID; }
+
+        bool operator==(const InternedSymbol &other) const { return m_id == other.m_id; }
+
+        bool operator!=(const InternedSymbol &other) const { return m_id != other.m_id; }
+
+        bool operator==(std::nullptr_t) const { return m_id == NULL_ID; }
+
+        bool operator!=(std::nullptr_t) const { return m_id != NULL_ID; }
+    };
+}
+
+template<>
+struct std::hash<trading::common::InternedSymbol> {
+    size_t operator()(const trading::common::InternedSymbol &symbol) const noexcept {
+        return std::hash<trading::common::symbol_id_t>{}(symbol.id());
+    }
+};
+
+#endif //TRADING_COMMON_SYMBOL_TABLE_H
@@ -0,0 +1,86 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#ifndef TRADING_COMMON_WIRE_FORMAT_H
+#define TRADING_COMMON_WIRE_FORMAT_H
+
+#include <cstdint>
+#include <span>
+#include <trading_common/common.h>
+#include <trading_common/ohlc.h>
+#include <trading_common/order.h>
+#include <trading_common/position.h>
+
+namespace trading::common {
+
+    // Compact binary encoding of single bars, orders and positions for messaging, in place of to_json(). Every
+    // message is little-endian, whatever the host:
+    //
+    //   header   kind u8 | version u8 | price format u8 | reserved u8, 0 | message size u32
+    //   fields   fixed layout per kind: integers and prices 8 bytes, enums 1 byte, string lengths 2 bytes
+    //   strings  symbol, then the id of an order or position
+    //
+    //   OHLCV     timestamp, open, high, low, close, volume, symbol length
+    //   order     timestamp, quantity, filled, filled_at_price, limit_price, side, type, status, symbol length,
+    //             id length
+    //   position  timestamp, balance, entry_price, current_price, pnl, side, symbol length, id length
+    //
+    // Prices are IEEE doubles (price format 255) or the ticks of a FixedPrice, the price format being its
+    // decimal places; a reader must use the same price type. Like the JSON, an OHLCV message leaves out the
+    // date string. encode() writes into a caller buffer and decode() into an existing object, reusing its
+    // strings, so neither allocates in steady state. Both throw OHLCException on a short buffer or a symbol
+    // longer than MAX_SYMBOL_LENGTH, and decode() on a message of another kind, version or price format, or
+    // with the reserved byte set. Decoded symbols are interned in the global SymbolTable; once it is full,
+    // decode() throws OHLCException as well.
+    namespace wire {
+        enum class Kind : uint8_t {
+            OHLCV = 1,
+            ORDER = 2,
+            POSITION = 3
+        };
+
+        constexpr uint8_t VERSION = 1;
+
+        constexpr size_t HEADER_SIZE = 8;
+
+        // Longest symbol a message carries, so that untrusted input cannot intern arbitrary names
+        constexpr size_t MAX_SYMBOL_LENGTH = 64;
+
+        // Kind of the message at the start of `buffer`, to pick the decode() overload
+        [[nodiscard]] Kind peek(std::span<const unsigned char> buffer);
+
+        // Size of the message at the start of `buffer`, to step over it
+        [[nodiscard]] size_t message_size(std::span<const unsigned char> buffer);
+
+        [[nodiscard]] size_t encoded_size(const OHLCV &ohlcv);
+
+        // Returns the bytes written
+        size_t encode(const OHLCV &ohlcv, std::span<unsigned char> buffer);
+
+        // Returns the bytes read
+        size_t decode(std::span<const unsigned char> buffer, OHLCV &ohlcv);
+
+        // Orders and positions, instantiated for the price types of BasicOrder
+
+        template<typename P>
+        [[nodiscard]] size_t encoded_size(const trading::order::BasicOrder<P> &order);
+
+        template<typename P>
+        size_t encode(const trading::order::BasicOrder<P> &order, std::span<unsigned char> buffer);
+
+        template<typename P>
+        size_t decode(std::span<const unsigned char> buffer, trading::order::BasicOrder<P> &order);
+
+        template<typename P>
+        [[nodiscard]] size_t encoded_size(const trading::position::BasicPosition<P> &position);
+
+        template<typename P>
+        size_t encode(const trading::position::BasicPosition<P> &position, std::span<unsigned char> buffer);
+
+        template<typename P>
+        size_t decode(std::span<const unsigned char> buffer, trading::position::BasicPosition<P> &position);
+    }
+}
+
+#endif //TRADING_COMMON_WIRE_FORMAT_H
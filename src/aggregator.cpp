@@ -0,0 +1,140 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/aggregator.h>
+
+#include <algorithm>
+
+namespace trading::common {
+
+    BarAggregator::BarAggregator(symbol_t symbol, std::vector<timestamp_t> timeframes)
+            : m_symbol(std::move(symbol)) {
+        std::sort(timeframes.begin(), timeframes.end());
+        timeframes.erase(std::unique(timeframes.begin(), timeframes.end()), timeframes.end());
+        if (timeframes.empty() || timeframes.front() == 0) {
+            throw OHLCException("BarAggregator needs at least one timeframe greater than 0");
+        }
+        m_slots.reserve(timeframes.size());
+        for (auto timeframe: timeframes) {
+            Slot slot;
+            slot.timeframe = timeframe;
+            m_slots.push_back(slot);
+        }
+    }
+
+    void BarAggregator::on_bar(callback_t callback) {
+        m_callback = std::move(callback);
+    }
+
+    void BarAggregator::emit_into(timestamp_t timeframe, SeriesOHLCV &series) {
+        for (auto &slot: m_slots) {
+            if (slot.timeframe == timeframe) {
+                slot.series = &series;
+                return;
+            }
+        }
+        throw OHLCException("BarAggregator has no timeframe " + std::to_string(timeframe));
+    }
+
+    void BarAggregator::emit(Slot &slot) {
+        if (m_callback) {
+            m_callback(slot.timeframe, slot.bar);
+        }
+        if (slot.series != nullptr) {
+            slot.series->insert(slot.bar.to_ohlcv(m_symbol));
+        }
+        slot.emitted = slot.end;
+    }
+
+    void BarAggregator::roll(Slot &slot, timestamp_t timestamp, price_t price, size_t size) {
+        if (slot.open) {
+            emit(slot);
+        }
+        // the only division, once per bar instead of once per tick
+        timestamp_t start = timestamp - timestamp % slot.timeframe;
+        slot.end = start + slot.timeframe;
+        slot.open = true;
+        slot.bar = {start, price, price, price, price, size};
+    }
+
+    bool BarAggregator::add(timestamp_t timestamp, price_t price, size_t size) {
+        const Slot &finest = m_slots.front();
+        if (timestamp < (finest.open ? finest.bar.timestamp : finest.emitted)) {
+            ++m_rejected;
+            return false;
+        }
+        bool truncated = false;
+        for (auto &slot: m_slots) {
+            if (!slot.open && timestamp < slot.emitted) {
+                // after a flush, in a coarser bucket that has been emitted
+                truncated = true;
+                continue;
+            }
+            if (!slot.open || timestamp >= slot.end) {
+                roll(slot, timestamp, price, size);
+                continue;
+            }
+            Bar &bar = slot.bar;
+            bar.high = std::max(bar.high, price);
+            bar.low = std::min(bar.low, price);
+            bar.close = price;
+            bar.volume += size;
+        }
+        m_truncated += truncated;
+        return true;
+    }
+
+    bool BarAggregator::add(const Tick &tick) {
+        return add(tick.timestamp, tick.price, tick.size);
+    }
+
+    void BarAggregator::flush() {
+        for (auto &slot: m_slots) {
+            if (slot.open) {
+                emit(slot);
+                slot.open = false;
+            }
+        }
+    }
+
+    void BarAggregator::flush(timestamp_t now) {
+        for (auto &slot: m_slots) {
+            if (slot.open && slot.end <= now) {
+                emit(slot);
+                slot.open = false;
+            }
+        }
+    }
+
+    const BarAggregator::Bar *BarAggregator::current(timestamp_t timeframe) const {
+        for (const auto &slot: m_slots) {
+            if (slot.timeframe == timeframe) {
+                return slot.open ? &slot.bar : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<timestamp_t> BarAggregator::get_timeframes() const {
+        std::vector<timestamp_t> result;
+        result.reserve(m_slots.size());
+        for (const auto &slot: m_slots) {
+            result.push_back(slot.timeframe);
+        }
+        return result;
+    }
+
+    const symbol_t &BarAggregator::symbol() const {
+        return m_symbol;
+    }
+
+    size_t BarAggregator::rejected() const {
+        return m_rejected;
+    }
+
+    size_t BarAggregator::truncated() const {
+        return m_truncated;
+    }
+
+}
@@ -0,0 +1,218 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/align.h>
+#include "fork_join.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace trading::common {
+
+    namespace {
+        // Runs fn(begin, end) over `count` items split in contiguous groups, one per thread (0 for one per
+        // hardware thread), the first group on the calling thread
+        template<typename F>
+        void run_groups(size_t count, size_t threads, F &&fn) {
+            const size_t workers = worker_count(threads, count);
+            fork_join(workers, [&fn, count, workers](size_t worker) {
+                fn(count * worker / workers, count * (worker + 1) / workers);
+            });
+        }
+    }
+
+    std::vector<timestamp_t> align_timestamps(std::span<const ColumnsOHLCV> inputs, AlignPolicy policy,
+                                              size_t threads) {
+        if (inputs.empty()) {
+            return {};
+        }
+        timestamp_t start = 0;
+        for (const auto &input: inputs) {
+            if (input.empty()) {
+                // no timestamp has a bar of every series, and forward filling never starts
+                return {};
+            }
+            start = std::max(start, input.timestamp.front());
+        }
+
+        auto combine = [policy](std::span<const timestamp_t> a, std::span<const timestamp_t> b) {
+            std::vector<timestamp_t> result;
+            if (policy == AlignPolicy::DROP) {
+                result.reserve(std::min(a.size(), b.size()));
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+            } else {
+                result.reserve(std::max(a.size(), b.size()));
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+            }
+            return result;
+        };
+
+        // pairwise tree of merges: when the series share most timestamps every level is about as long as one
+        // series, so the whole tree costs a small multiple of the n input bars instead of n log k
+        std::vector<std::vector<timestamp_t>> level((inputs.size() + 1) / 2);
+        run_groups(level.size(), threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto &first = inputs[2 * i].timestamp;
+                if (2 * i + 1 < inputs.size()) {
+                    level[i] = combine(first, inputs[2 * i + 1].timestamp);
+                } else {
+                    level[i].assign(first.begin(), first.end());
+                }
+            }
+        });
+        while (level.size() > 1) {
+            std::vector<std::vector<timestamp_t>> next(level.size() / 2);
+            run_groups(next.size(), threads, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    next[i] = combine(level[2 * i], level[2 * i + 1]);
+                }
+            });
+            if (level.size() % 2 == 1) {
+                next.push_back(std::move(level.back()));
+            }
+            level = std::move(next);
+        }
+
+        std::vector<timestamp_t> grid = std::move(level.front());
+        if (policy == AlignPolicy::FORWARD_FILL) {
+            grid.erase(grid.begin(), std::lower_bound(grid.begin(), grid.end(), start));
+        }
+        return grid;
+    }
+
+    AlignedSeries::AlignedSeries(std::span<const ColumnsOHLCV> inputs, AlignPolicy policy, size_t threads,
+                                 std::vector<symbol_t> symbols) : m_symbols(std::move(symbols)) {
+        if (m_symbols.empty()) {
+            m_symbols.resize(inputs.size());
+        } else if (m_symbols.size() != inputs.size()) {
+            throw OHLCException("Aligned series need one symbol per input");
+        }
+        m_timestamp = align_timestamps(inputs, policy, threads);
+        fill_all(inputs, threads);
+    }
+
+    AlignedSeries::AlignedSeries(const std::vector<const ColumnarSeriesOHLCV *> &series, AlignPolicy policy,
+                                 size_t threads) {
+        std::vector<ColumnsOHLCV> inputs;
+        std::vector<symbol_t> symbols;
+        inputs.reserve(series.size());
+        symbols.reserve(series.size());
+        for (const auto *s: series) {
+            inputs.push_back(s->columns());
+            symbols.push_back(s->symbol());
+        }
+        *this = AlignedSeries(inputs, policy, threads, std::move(symbols));
+    }
+
+    AlignedSeries::AlignedSeries(const std::vector<const SeriesOHLCV *> &series, AlignPolicy policy,
+                                 size_t threads) {
+        std::vector<ColumnarSeriesOHLCV> converted(series.size());
+        run_groups(series.size(), threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                converted[i] = ColumnarSeriesOHLCV(*series[i]);
+            }
+        });
+        std::vector<const ColumnarSeriesOHLCV *> pointers;
+        pointers.reserve(converted.size());
+        for (const auto &s: converted) {
+            pointers.push_back(&s);
+        }
+        *this = AlignedSeries(pointers, policy, threads);
+    }
+
+    void AlignedSeries::fill_all(std::span<const ColumnsOHLCV> inputs, size_t threads) {
+        const size_t cells = m_timestamp.size() * inputs.size();
+        m_open.resize(cells);
+        m_high.resize(cells);
+        m_low.resize(cells);
+        m_close.resize(cells);
+        m_volume.resize(cells);
+        run_groups(inputs.size(), threads, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                fill(i, inputs[i]);
+            }
+        });
+    }
+
+    void AlignedSeries::fill(size_t index, const ColumnsOHLCV &input) {
+        const size_t rows = m_timestamp.size();
+        const size_t base = index * rows;
+        const size_t n = input.size();
+        size_t j = 0;
+        double close = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            const timestamp_t timestamp = m_timestamp[r];
+            // bars off the grid: before it starts, or missing from another series when dropping
+            while (j < n && input.timestamp[j] < timestamp) {
+                close = input.close[j++];
+            }
+            const size_t cell = base + r;
+            if (j < n && input.timestamp[j] == timestamp) {
+                m_open[cell] = input.open[j];
+                m_high[cell] = input.high[j];
+                m_low[cell] = input.low[j];
+                m_close[cell] = close = input.close[j];
+                m_volume[cell] = input.volume[j];
+                ++j;
+            } else {
+                m_open[cell] = m_high[cell] = m_low[cell] = m_close[cell] = close;
+                m_volume[cell] = 0;
+            }
+        }
+    }
+
+    ColumnsOHLCV AlignedSeries::columns(size_t index) const {
+        if (index >= width()) {
+            throw std::out_of_range("Aligned series index out of range");
+        }
+        const size_t rows = m_timestamp.size();
+        const size_t base = index * rows;
+        return {m_timestamp,
+                std::span<const double>(m_open).subspan(base, rows),
+                std::span<const double>(m_high).subspan(base, rows),
+                std::span<const double>(m_low).subspan(base, rows),
+                std::span<const double>(m_close).subspan(base, rows),
+                std::span<const size_t>(m_volume).subspan(base, rows)};
+    }
+
+    ColumnarSeriesOHLCV AlignedSeries::to_columnar(size_t index) const {
+        auto c = columns(index);
+        return {m_symbols[index],
+                {c.timestamp.begin(), c.timestamp.end()},
+                {c.open.begin(), c.open.end()},
+                {c.high.begin(), c.high.end()},
+                {c.low.begin(), c.low.end()},
+                {c.close.begin(), c.close.end()},
+                {c.volume.begin(), c.volume.end()}};
+    }
+
+    AlignmentCursor::AlignmentCursor(std::vector<ColumnsOHLCV> inputs, AlignPolicy policy)
+            : m_inputs(std::move(inputs)), m_grid(align_timestamps(m_inputs, policy)), m_next(m_inputs.size(), 0),
+              m_row(m_inputs.size()) {}
+
+    bool AlignmentCursor::next() {
+        if (m_position == m_grid.size()) {
+            return false;
+        }
+        const timestamp_t timestamp = m_grid[m_position++];
+        for (size_t i = 0; i < m_inputs.size(); ++i) {
+            const auto &input = m_inputs[i];
+            size_t &j = m_next[i];
+            while (j < input.size() && input.timestamp[j] < timestamp) {
+                ++j;
+            }
+            if (j < input.size() && input.timestamp[j] == timestamp) {
+                m_row[i] = {timestamp, input.open[j], input.high[j], input.low[j], input.close[j], input.volume[j]};
+                ++j;
+            } else {
+                // only with FORWARD_FILL, where the grid starts once every input has a bar
+                price_t close = input.close[j - 1];
+                m_row[i] = {timestamp, close, close, close, close, 0};
+            }
+        }
+        return true;
+    }
+
+}
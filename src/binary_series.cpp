@@ -0,0 +1,224 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/binary_series.h>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace trading::common {
+
+    static_assert(std::endian::native == std::endian::little, "binary series files are mapped in place");
+    static_assert(sizeof(timestamp_t) == 8 && sizeof(size_t) == 8 && sizeof(double) == 8);
+
+    namespace {
+        constexpr uint32_t COLUMN_COUNT = 6;
+        constexpr uint64_t COLUMN_ALIGNMENT = 64;
+
+        uint64_t column_stride(uint64_t count) {
+            return (count * 8 + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+        }
+
+        template<typename T>
+        void write_column(std::ofstream &out, std::span<const T> column, uint64_t stride) {
+            static const char padding[COLUMN_ALIGNMENT] = {};
+            out.write(reinterpret_cast<const char *>(column.data()),
+                      static_cast<std::streamsize>(column.size_bytes()));
+            out.write(padding, static_cast<std::streamsize>(stride - column.size_bytes()));
+        }
+    }
+
+    void write_binary(const std::string &path, const ColumnsOHLCV &columns, const symbol_t &symbol) {
+        BinarySeriesHeader header{};
+        std::memcpy(header.magic, BinarySeriesHeader::MAGIC, sizeof(header.magic));
+        header.version = BinarySeriesHeader::VERSION;
+        header.header_size = sizeof(BinarySeriesHeader);
+        header.count = columns.size();
+        header.column_stride = column_stride(header.count);
+        header.column_count = COLUMN_COUNT;
+        if (!symbol->empty()) {
+            if (symbol->size() > BinarySeriesHeader::SYMBOL_CAPACITY) {
+                throw OHLCException("Symbol too long for binary series: " + *symbol);
+            }
+            header.symbol_length = static_cast<uint32_t>(symbol->size());
+            std::memcpy(header.symbol, symbol->data(), symbol->size());
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw OHLCException("Cannot open binary series for writing: " + path);
+        }
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        write_column(out, columns.timestamp, header.column_stride);
+        write_column(out, columns.open, header.column_stride);
+        write_column(out, columns.high, header.column_stride);
+        write_column(out, columns.low, header.column_stride);
+        write_column(out, columns.close, header.column_stride);
+        write_column(out, columns.volume, header.column_stride);
+        out.close();
+        if (!out) {
+            throw OHLCException("Error writing binary series: " + path);
+        }
+    }
+
+    void write_binary(const std::string &path, const ColumnarSeriesOHLCV &series) {
+        write_binary(path, series.columns(), series.symbol());
+    }
+
+    MappedSeriesOHLCV::MappedSeriesOHLCV(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw OHLCException("Cannot open binary series: " + path);
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(BinarySeriesHeader)) {
+            ::close(fd);
+            throw OHLCException("Binary series too short: " + path);
+        }
+        m_length = static_cast<size_t>(st.st_size);
+        void *data = ::mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            m_length = 0;
+            throw OHLCException("Cannot map binary series: " + path);
+        }
+        m_data = static_cast<const unsigned char *>(data);
+
+        BinarySeriesHeader header{};
+        std::memcpy(&header, m_data, sizeof(header));
+        uint64_t stride = column_stride(header.count);
+        if (std::memcmp(header.magic, BinarySeriesHeader::MAGIC, sizeof(header.magic)) != 0
+            || header.version != BinarySeriesHeader::VERSION
+            || header.header_size != sizeof(BinarySeriesHeader)
+            || header.column_count != COLUMN_COUNT
+            || header.column_stride != stride
+            || header.symbol_length > BinarySeriesHeader::SYMBOL_CAPACITY
+            || header.count > (m_length - header.header_size) / 8 / COLUMN_COUNT
+            || header.header_size + stride * COLUMN_COUNT > m_length) {
+            unmap();
+            throw OHLCException("Invalid binary series file: " + path);
+        }
+
+        m_symbol = symbol_t(std::string_view(header.symbol, header.symbol_length));
+        auto count = static_cast<size_t>(header.count);
+        auto column = [&](uint32_t k) { return m_data + header.header_size + k * stride; };
+        m_columns = {{reinterpret_cast<const timestamp_t *>(column(0)), count},
+                     {reinterpret_cast<const double *>(column(1)),      count},
+                     {reinterpret_cast<const double *>(column(2)),      count},
+                     {reinterpret_cast<const double *>(column(3)),      count},
+                     {reinterpret_cast<const double *>(column(4)),      count},
+                     {reinterpret_cast<const size_t *>(column(5)),      count}};
+    }
+
+    MappedSeriesOHLCV::~MappedSeriesOHLCV() {
+        unmap();
+    }
+
+    MappedSeriesOHLCV::MappedSeriesOHLCV(MappedSeriesOHLCV &&other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)),
+              m_length(std::exchange(other.m_length, 0)),
+              m_symbol(std::move(other.m_symbol)),
+              m_columns(std::exchange(other.m_columns, {})) {}
+
+    MappedSeriesOHLCV &MappedSeriesOHLCV::operator=(MappedSeriesOHLCV &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_length = std::exchange(other.m_length, 0);
+            m_symbol = std::move(other.m_symbol);
+            m_columns = std::exchange(other.m_columns, {});
+        }
+        return *this;
+    }
+
+    void MappedSeriesOHLCV::unmap() {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<unsigned char *>(m_data), m_length);
+            m_data = nullptr;
+            m_length = 0;
+            m_columns = {};
+        }
+    }
+
+    const symbol_t &MappedSeriesOHLCV::symbol() const {
+        return m_symbol;
+    }
+
+    bool MappedSeriesOHLCV::empty() const {
+        return m_columns.empty();
+    }
+
+    size_t MappedSeriesOHLCV::size() const {
+        return m_columns.size();
+    }
+
+    MappedSeriesOHLCV::Bar MappedSeriesOHLCV::at(size_t index) const {
+        return {m_columns.timestamp[index], m_columns.open[index], m_columns.high[index], m_columns.low[index],
+                m_columns.close[index], m_columns.volume[index]};
+    }
+
+    ColumnsOHLCV MappedSeriesOHLCV::columns() const {
+        return m_columns;
+    }
+
+    ColumnsOHLCV MappedSeriesOHLCV::range(timestamp_t from, timestamp_t to) const {
+        return m_columns.range(from, to);
+    }
+
+    ColumnarSeriesOHLCV MappedSeriesOHLCV::to_columnar() const {
+        ColumnarSeriesOHLCV series(m_symbol);
+        series.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            series.insert(at(i));
+        }
+        return series;
+    }
+
+    MappedSeriesOHLCV::iterator::iterator(const MappedSeriesOHLCV *s, std::ptrdiff_t i) : series(s), index(i) {}
+
+    MappedSeriesOHLCV::iterator &MappedSeriesOHLCV::iterator::operator++() {
+        ++index;
+        return *this;
+    }
+
+    MappedSeriesOHLCV::iterator &MappedSeriesOHLCV::iterator::operator--() {
+        --index;
+        return *this;
+    }
+
+    bool MappedSeriesOHLCV::iterator::operator==(const iterator &other) const {
+        return index == other.index;
+    }
+
+    bool MappedSeriesOHLCV::iterator::operator!=(const iterator &other) const {
+        return index != other.index;
+    }
+
+    std::pair<const timestamp_t, MappedSeriesOHLCV::Bar> MappedSeriesOHLCV::iterator::operator*() const {
+        auto bar = series->at(static_cast<size_t>(index));
+        return {bar.timestamp, bar};
+    }
+
+    MappedSeriesOHLCV::iterator MappedSeriesOHLCV::begin() const {
+        return {this, 0};
+    }
+
+    MappedSeriesOHLCV::iterator MappedSeriesOHLCV::end() const {
+        return {this, static_cast<std::ptrdiff_t>(size())};
+    }
+
+    MappedSeriesOHLCV::iterator MappedSeriesOHLCV::rbegin() const {
+        return {this, static_cast<std::ptrdiff_t>(size()) - 1};
+    }
+
+    MappedSeriesOHLCV::iterator MappedSeriesOHLCV::rend() const {
+        return {this, -1};
+    }
+
+}
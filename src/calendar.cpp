@@ -0,0 +1,571 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/calendar.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace trading::common {
+
+    namespace {
+
+        constexpr int LAST_RULE_YEAR = 2200;
+
+        uint64_t next_serial() {
+            static std::atomic<uint64_t> serial{0};
+            return ++serial;
+        }
+
+        void write_digits(char *out, unsigned value, int width) {
+            for (int i = width - 1; i >= 0; --i) {
+                out[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        }
+
+        // A day of the year in a POSIX TZ rule: Jn (1-365, no Feb 29), n (0-365) or Mm.w.d
+        struct RuleDate {
+            char kind = 'M';
+            int month = 0;
+            int week = 0;
+            int day = 0;
+            int32_t time = 7200;
+
+            [[nodiscard]] int64_t days(int year) const {
+                if (kind == 'J') {
+                    int64_t days = days_from_civil(year, 1, 1) + day - 1;
+                    return days + (is_leap_year(year) && day >= 60);
+                }
+                if (kind == 'N') {
+                    return days_from_civil(year, 1, 1) + day;
+                }
+                int64_t first = days_from_civil(year, static_cast<unsigned>(month), 1);
+                int64_t result = first + (day - static_cast<int>(weekday_from_days(first)) + 7) % 7 + (week - 1) * 7;
+                int64_t next_month = first + days_in_month(year, static_cast<unsigned>(month));
+                while (result >= next_month) {
+                    result -= 7;
+                }
+                return result;
+            }
+        };
+
+        struct PosixRule {
+            std::string std_name;
+            int32_t std_offset = 0;
+            bool has_dst = false;
+            int32_t dst_offset = 0;
+            RuleDate start;
+            RuleDate end;
+        };
+
+        class RuleParser {
+        private:
+            std::string_view m_text;
+            size_t m_pos = 0;
+
+            [[noreturn]] void fail() const {
+                throw CalendarException("Invalid POSIX TZ rule: " + std::string(m_text));
+            }
+
+            [[nodiscard]] bool at_end() const { return m_pos >= m_text.size(); }
+
+            [[nodiscard]] char peek() const { return at_end() ? '\0' : m_text[m_pos]; }
+
+            bool accept(char c) {
+                if (peek() == c) {
+                    ++m_pos;
+                    return true;
+                }
+                return false;
+            }
+
+            int number(int max_digits) {
+                int value = 0;
+                int digits = 0;
+                while (digits < max_digits && peek() >= '0' && peek() <= '9') {
+                    value = value * 10 + (m_text[m_pos++] - '0');
+                    ++digits;
+                }
+                if (digits == 0) {
+                    fail();
+                }
+                return value;
+            }
+
+            std::string name() {
+                size_t begin = m_pos;
+                if (accept('<')) {
+                    while (!at_end() && peek() != '>') {
+                        ++m_pos;
+                    }
+                    if (!accept('>')) {
+                        fail();
+                    }
+                } else {
+                    while ((peek() >= 'A' && peek() <= 'Z') || (peek() >= 'a' && peek() <= 'z')) {
+                        ++m_pos;
+                    }
+                }
+                if (m_pos - begin < 3) {
+                    fail();
+                }
+                return std::string(m_text.substr(begin, m_pos - begin));
+            }
+
+            // [+-]hh[:mm[:ss]], hours may go up to 167 in rule times
+            int32_t duration() {
+                int sign = 1;
+                if (accept('-')) {
+                    sign = -1;
+                } else {
+                    accept('+');
+                }
+                int32_t seconds = number(3) * 3600;
+                if (accept(':')) {
+                    seconds += number(2) * 60;
+                    if (accept(':')) {
+                        seconds += number(2);
+                    }
+                }
+                return sign * seconds;
+            }
+
+            RuleDate date() {
+                RuleDate result;
+                if (accept('J')) {
+                    result.kind = 'J';
+                    result.day = number(3);
+                    if (result.day < 1 || result.day > 365) fail();
+                } else if (accept('M')) {
+                    result.kind = 'M';
+                    result.month = number(2);
+                    if (!accept('.')) fail();
+                    result.week = number(1);
+                    if (!accept('.')) fail();
+                    result.day = number(1);
+                    if (result.month < 1 || result.month > 12 || result.week < 1 || result.week > 5 || result.day > 6) {
+                        fail();
+                    }
+                } else {
+                    result.kind = 'N';
+                    result.day = number(3);
+                    if (result.day > 365) fail();
+                }
+                if (accept('/')) {
+                    result.time = duration();
+                }
+                return result;
+            }
+
+        public:
+            explicit RuleParser(std::string_view text) : m_text(text) {}
+
+            PosixRule parse() {
+                PosixRule rule;
+                rule.std_name = name();
+                // POSIX offsets are west of Greenwich, the opposite sign of a UTC offset
+                rule.std_offset = -duration();
+                if (at_end()) {
+                    return rule;
+                }
+                name();
+                rule.has_dst = true;
+                rule.dst_offset = rule.std_offset + 3600;
+                if (peek() != ',' && !at_end()) {
+                    rule.dst_offset = -duration();
+                }
+                if (!accept(',')) {
+                    // no rule given, use the current US rule as glibc does
+                    rule.start = {'M', 3, 2, 0, 7200};
+                    rule.end = {'M', 11, 1, 0, 7200};
+                    return rule;
+                }
+                rule.start = date();
+                if (!accept(',')) fail();
+                rule.end = date();
+                if (!at_end()) fail();
+                return rule;
+            }
+        };
+
+        // Appends the transitions of the rule for the years [first_year, LAST_RULE_YEAR] that come after `after`
+        void expand_rule(const PosixRule &rule, int first_year, int64_t after, std::vector<int64_t> &transitions,
+                         std::vector<int32_t> &offsets) {
+            for (int year = first_year; year <= LAST_RULE_YEAR; ++year) {
+                std::pair<int64_t, int32_t> changes[2] = {
+                        {rule.start.days(year) * SECONDS_PER_DAY + rule.start.time - rule.std_offset, rule.dst_offset},
+                        {rule.end.days(year) * SECONDS_PER_DAY + rule.end.time - rule.dst_offset,     rule.std_offset}};
+                if (changes[1].first < changes[0].first) {
+                    std::swap(changes[0], changes[1]);
+                }
+                for (auto &[time, offset]: changes) {
+                    if (time > after) {
+                        transitions.push_back(time);
+                        offsets.push_back(offset);
+                    }
+                }
+            }
+        }
+
+        class TzifReader {
+        private:
+            const std::vector<unsigned char> &m_data;
+            size_t m_pos = 0;
+            const std::string &m_name;
+
+        public:
+            TzifReader(const std::vector<unsigned char> &data, const std::string &name) : m_data(data), m_name(name) {}
+
+            [[noreturn]] void fail() const {
+                throw CalendarException("Invalid TZif file: " + m_name);
+            }
+
+            void need(size_t count) const {
+                if (m_data.size() - m_pos < count) {
+                    fail();
+                }
+            }
+
+            void skip(size_t count) {
+                need(count);
+                m_pos += count;
+            }
+
+            uint8_t u8() {
+                need(1);
+                return m_data[m_pos++];
+            }
+
+            int64_t be(size_t width) {
+                need(width);
+                uint64_t value = 0;
+                for (size_t i = 0; i < width; ++i) {
+                    value = value << 8 | m_data[m_pos++];
+                }
+                if (width == 4) {
+                    return static_cast<int32_t>(static_cast<uint32_t>(value));
+                }
+                return static_cast<int64_t>(value);
+            }
+
+            std::string rest() {
+                std::string text(m_data.begin() + static_cast<std::ptrdiff_t>(m_pos), m_data.end());
+                m_pos = m_data.size();
+                return text;
+            }
+        };
+
+        struct TzifCounts {
+            uint32_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt;
+        };
+
+        TzifCounts read_tzif_header(TzifReader &reader, char &version) {
+            reader.need(44);
+            if (reader.u8() != 'T' || reader.u8() != 'Z' || reader.u8() != 'i' || reader.u8() != 'f') {
+                reader.fail();
+            }
+            version = static_cast<char>(reader.u8());
+            reader.skip(15);
+            TzifCounts counts{};
+            counts.isutcnt = static_cast<uint32_t>(reader.be(4));
+            counts.isstdcnt = static_cast<uint32_t>(reader.be(4));
+            counts.leapcnt = static_cast<uint32_t>(reader.be(4));
+            counts.timecnt = static_cast<uint32_t>(reader.be(4));
+            counts.typecnt = static_cast<uint32_t>(reader.be(4));
+            counts.charcnt = static_cast<uint32_t>(reader.be(4));
+            if (counts.typecnt == 0) {
+                reader.fail();
+            }
+            return counts;
+        }
+    }
+
+    void format_civil(const CivilDate &date, char *out) noexcept {
+        write_digits(out, static_cast<unsigned>(std::clamp(date.year, 0, 9999)), 4);
+        out[4] = '-';
+        write_digits(out + 5, date.month, 2);
+        out[7] = '-';
+        write_digits(out + 8, date.day, 2);
+    }
+
+    std::optional<CivilDate> parse_civil(std::string_view text) noexcept {
+        if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+            return std::nullopt;
+        }
+        unsigned fields[3] = {};
+        const size_t starts[3] = {0, 5, 8};
+        const size_t widths[3] = {4, 2, 2};
+        for (size_t f = 0; f < 3; ++f) {
+            for (size_t i = starts[f]; i < starts[f] + widths[f]; ++i) {
+                if (text[i] < '0' || text[i] > '9') {
+                    return std::nullopt;
+                }
+                fields[f] = fields[f] * 10 + static_cast<unsigned>(text[i] - '0');
+            }
+        }
+        CivilDate date{static_cast<int>(fields[0]), fields[1], fields[2]};
+        if (date.month < 1 || date.month > 12 || date.day < 1 || date.day > days_in_month(date.year, date.month)) {
+            return std::nullopt;
+        }
+        return date;
+    }
+
+    TimeZone::TimeZone(std::string name, std::vector<int64_t> transitions, std::vector<int32_t> offsets)
+            : m_name(std::move(name)), m_transitions(std::move(transitions)), m_offsets(std::move(offsets)),
+              m_serial(next_serial()) {}
+
+    TimeZone TimeZone::utc() {
+        return {"UTC", {}, {0}};
+    }
+
+    TimeZone TimeZone::fixed(int32_t offset, std::string name) {
+        return {std::move(name), {}, {offset}};
+    }
+
+    TimeZone TimeZone::posix(const std::string &rule) {
+        PosixRule parsed = RuleParser(rule).parse();
+        if (!parsed.has_dst) {
+            return fixed(parsed.std_offset, rule);
+        }
+        std::vector<int64_t> transitions;
+        std::vector<int32_t> offsets;
+        expand_rule(parsed, 1900, INT64_MIN, transitions, offsets);
+        // before the first change the offset is the one left at the end of a year
+        int32_t initial = offsets.back();
+        offsets.insert(offsets.begin(), initial);
+        return {rule, std::move(transitions), std::move(offsets)};
+    }
+
+    TimeZone TimeZone::load(const std::string &name) {
+        std::string path = name;
+        if (name.empty() || name[0] != '/') {
+            if (name.find("..") != std::string::npos) {
+                throw CalendarException("Invalid time zone name: " + name);
+            }
+            const char *dir = std::getenv("TZDIR");
+            path = std::string(dir != nullptr && *dir != '\0' ? dir : "/usr/share/zoneinfo") + "/" + name;
+        }
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw CalendarException("Cannot open time zone: " + name);
+        }
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        TzifReader reader(data, name);
+        char version = 0;
+        TzifCounts counts = read_tzif_header(reader, version);
+        size_t time_size = 4;
+        if (version >= '2') {
+            // skip the 32 bit block, the 64 bit one after it has the same data with wider times
+            reader.skip(counts.timecnt * 5 + counts.typecnt * 6 + counts.charcnt + counts.leapcnt * 8
+                        + counts.isstdcnt + counts.isutcnt);
+            counts = read_tzif_header(reader, version);
+            time_size = 8;
+        }
+
+        std::vector<int64_t> transitions(counts.timecnt);
+        std::vector<uint8_t> indexes(counts.timecnt);
+        for (auto &time: transitions) {
+            time = reader.be(time_size);
+        }
+        for (auto &index: indexes) {
+            index = reader.u8();
+            if (index >= counts.typecnt) {
+                reader.fail();
+            }
+        }
+        std::vector<int32_t> type_offsets(counts.typecnt);
+        for (auto &offset: type_offsets) {
+            offset = static_cast<int32_t>(reader.be(4));
+            reader.skip(2);
+        }
+        reader.skip(counts.charcnt + counts.leapcnt * (time_size + 4) + counts.isstdcnt + counts.isutcnt);
+
+        std::vector<int32_t> offsets;
+        offsets.reserve(transitions.size() + 1);
+        offsets.push_back(type_offsets[0]);
+        for (auto index: indexes) {
+            offsets.push_back(type_offsets[index]);
+        }
+
+        std::string footer = version >= '2' ? reader.rest() : std::string{};
+        if (footer.size() > 2 && footer.front() == '\n' && footer.back() == '\n') {
+            PosixRule rule = RuleParser(std::string_view(footer).substr(1, footer.size() - 2)).parse();
+            if (rule.has_dst) {
+                int64_t last = transitions.empty() ? INT64_MIN : transitions.back();
+                int first_year = transitions.empty() ? 1900 : civil_from_days(floor_div(last, SECONDS_PER_DAY)).year;
+                expand_rule(rule, first_year, last, transitions, offsets);
+            } else if (offsets.back() != rule.std_offset && !transitions.empty()) {
+                offsets.back() = rule.std_offset;
+            }
+        }
+        return {name, std::move(transitions), std::move(offsets)};
+    }
+
+    const TimeZone &TimeZone::local() {
+        static const TimeZone zone = [] {
+            const char *env = std::getenv("TZ");
+            std::string name = env == nullptr ? "/etc/localtime" : env;
+            if (!name.empty() && name[0] == ':') {
+                name.erase(0, 1);
+            }
+            if (name.empty()) {
+                return utc();
+            }
+            try {
+                return load(name);
+            } catch (CalendarException &) {
+            }
+            try {
+                return posix(name);
+            } catch (CalendarException &) {
+            }
+            return utc();
+        }();
+        return zone;
+    }
+
+    const std::string &TimeZone::name() const {
+        return m_name;
+    }
+
+    uint64_t TimeZone::serial() const {
+        return m_serial;
+    }
+
+    int32_t TimeZone::offset(int64_t utc) const {
+        auto it = std::upper_bound(m_transitions.begin(), m_transitions.end(), utc);
+        return m_offsets[static_cast<size_t>(it - m_transitions.begin())];
+    }
+
+    int64_t TimeZone::to_local(int64_t utc) const {
+        return utc + offset(utc);
+    }
+
+    int64_t TimeZone::from_local(int64_t local) const {
+        // any transition near the wall clock time is within a day of it
+        const int32_t before = offset(local - SECONDS_PER_DAY);
+        const int32_t after = offset(local + SECONDS_PER_DAY);
+        if (offset(local - before) == before) {
+            return local - before;
+        }
+        if (offset(local - after) == after) {
+            return local - after;
+        }
+        return local - before;
+    }
+
+    int64_t TimeZone::local_day(int64_t utc) const {
+        return floor_div(to_local(utc), SECONDS_PER_DAY);
+    }
+
+    int64_t TimeZone::midnight(int64_t day) const {
+        return from_local(day * SECONDS_PER_DAY);
+    }
+
+    std::pair<int64_t, int64_t> TimeZone::day_bounds(int64_t utc) const {
+        int64_t day = local_day(utc);
+        return {midnight(day), midnight(day + 1)};
+    }
+
+    std::string format_date(timestamp_t timestamp, const TimeZone &zone) {
+        struct DayCache {
+            uint64_t serial = 0;
+            int64_t start = 0;
+            int64_t end = 0;
+            char text[10] = {};
+        };
+        thread_local DayCache cache;
+
+        auto time = static_cast<int64_t>(timestamp);
+        if (cache.serial != zone.serial() || time < cache.start || time >= cache.end) {
+            std::tie(cache.start, cache.end) = zone.day_bounds(time);
+            format_civil(civil_from_days(zone.local_day(time)), cache.text);
+            cache.serial = zone.serial();
+        }
+        return {cache.text, sizeof(cache.text)};
+    }
+
+    std::optional<timestamp_t> parse_date(std::string_view date, const TimeZone &zone) {
+        auto civil = parse_civil(date);
+        if (!civil) {
+            return std::nullopt;
+        }
+        return static_cast<timestamp_t>(zone.midnight(days_from_civil(*civil)));
+    }
+
+    TradingCalendar::TradingCalendar(TimeZone zone, int64_t open, int64_t close, const CivilDate &first,
+                                     const CivilDate &last, std::vector<CivilDate> holidays,
+                                     std::vector<unsigned> weekend)
+            : m_zone(std::move(zone)), m_first_day(days_from_civil(first)), m_last_day(days_from_civil(last)) {
+        if (open >= close) {
+            throw CalendarException("Session must open before it closes");
+        }
+        if (m_last_day < m_first_day) {
+            throw CalendarException("Calendar must end after it starts");
+        }
+        std::vector<int64_t> holiday_days;
+        holiday_days.reserve(holidays.size());
+        for (auto &holiday: holidays) {
+            holiday_days.push_back(days_from_civil(holiday));
+        }
+        std::sort(holiday_days.begin(), holiday_days.end());
+
+        m_sessions.reserve(static_cast<size_t>(m_last_day - m_first_day + 1));
+        for (int64_t day = m_first_day; day <= m_last_day; ++day) {
+            if (std::find(weekend.begin(), weekend.end(), weekday_from_days(day)) != weekend.end()
+                || std::binary_search(holiday_days.begin(), holiday_days.end(), day)) {
+                continue;
+            }
+            int64_t local = day * SECONDS_PER_DAY;
+            m_sessions.push_back({day, static_cast<timestamp_t>(m_zone.from_local(local + open)),
+                                  static_cast<timestamp_t>(m_zone.from_local(local + close))});
+        }
+    }
+
+    const TimeZone &TradingCalendar::zone() const {
+        return m_zone;
+    }
+
+    const std::vector<TradingCalendar::Session> &TradingCalendar::sessions() const {
+        return m_sessions;
+    }
+
+    bool TradingCalendar::is_trading_day(const CivilDate &date) const {
+        int64_t day = days_from_civil(date);
+        if (day < m_first_day || day > m_last_day) {
+            return false;
+        }
+        return std::binary_search(m_sessions.begin(), m_sessions.end(), Session{day},
+                                  [](const Session &a, const Session &b) { return a.day < b.day; });
+    }
+
+    std::optional<TradingCalendar::Session> TradingCalendar::session_at(timestamp_t timestamp) const {
+        auto it = std::upper_bound(m_sessions.begin(), m_sessions.end(), timestamp,
+                                   [](timestamp_t t, const Session &session) { return t < session.open; });
+        if (it == m_sessions.begin() || timestamp >= std::prev(it)->close) {
+            return std::nullopt;
+        }
+        return *std::prev(it);
+    }
+
+    bool TradingCalendar::is_open(timestamp_t timestamp) const {
+        return session_at(timestamp).has_value();
+    }
+
+    std::optional<TradingCalendar::Session> TradingCalendar::next_session(timestamp_t timestamp) const {
+        auto it = std::upper_bound(m_sessions.begin(), m_sessions.end(), timestamp,
+                                   [](timestamp_t t, const Session &session) { return t < session.close; });
+        if (it == m_sessions.end()) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+}
@@ -0,0 +1,188 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/clock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(TRADING_COMMON_X86_KERNELS)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace trading::common {
+
+    namespace {
+        std::atomic<ClockSource> source{ClockSource::SYSTEM};
+
+        // coarse clock: the time and the interval of the background updates
+        std::atomic<int64_t> coarse_time{0};
+        std::atomic<int64_t> coarse_resolution{1'000'000};
+        // the ticker waits on it between updates, so that a stop request or a new resolution wakes it at once
+        std::mutex coarse_mutex;
+        std::condition_variable_any coarse_wake;
+
+        std::atomic<int64_t> simulated_time{0};
+
+        // TSC clock: ns = base_ns + ((counter - base_counter) * scale) >> 32, the three fields published under
+        // a sequence lock so that a recalibration never shows a reader half of a scale
+        std::atomic<uint32_t> tsc_sequence{0};
+        std::atomic<uint64_t> tsc_base_counter{0};
+        std::atomic<int64_t> tsc_base_ns{0};
+        std::atomic<uint64_t> tsc_scale{0};
+        std::once_flag tsc_first_calibration;
+        std::mutex tsc_calibration;
+
+        bool invariant_tsc() {
+#if defined(TRADING_COMMON_X86_KERNELS)
+            unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+            // CPUID 0x80000007, EDX bit 8: the counter ticks at a constant rate through frequency changes and
+            // sleep states
+            return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        uint64_t counter() {
+#if defined(TRADING_COMMON_X86_KERNELS)
+            static const bool use_tsc = invariant_tsc();
+            if (use_tsc) {
+                return __rdtsc();
+            }
+#endif
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void coarse_tick(std::stop_token stop) {
+            std::unique_lock<std::mutex> lock(coarse_mutex);
+            while (!stop.stop_requested()) {
+                coarse_time.store(system_now_ns(), std::memory_order_relaxed);
+                int64_t resolution = coarse_resolution.load(std::memory_order_relaxed);
+                coarse_wake.wait_for(lock, stop, std::chrono::nanoseconds(resolution), [resolution] {
+                    return coarse_resolution.load(std::memory_order_relaxed) != resolution;
+                });
+            }
+        }
+
+        void start_coarse_clock() {
+            // the stop request of the join at exit wakes the ticker, whatever the resolution
+            static std::jthread ticker = [] {
+                coarse_time.store(system_now_ns(), std::memory_order_relaxed);
+                return std::jthread(coarse_tick);
+            }();
+        }
+    }
+
+    void set_clock_source(ClockSource clock) {
+        if (clock == ClockSource::COARSE) {
+            start_coarse_clock();
+        }
+        source.store(clock, std::memory_order_relaxed);
+    }
+
+    ClockSource clock_source() {
+        return source.load(std::memory_order_relaxed);
+    }
+
+    int64_t now_ns() {
+        switch (source.load(std::memory_order_relaxed)) {
+            case ClockSource::COARSE:
+                return coarse_time.load(std::memory_order_relaxed);
+            case ClockSource::TSC:
+                return tsc_now_ns();
+            case ClockSource::SIMULATED:
+                return simulated_time.load(std::memory_order_relaxed);
+            default:
+                return system_now_ns();
+        }
+    }
+
+    timestamp_t now_timestamp() {
+        return static_cast<timestamp_t>(now_ns() / 1'000'000'000);
+    }
+
+    timestamp_t timestamp_from_json(const json &object) {
+        auto found = object.find("timestamp");
+        if (found != object.end() && found->is_number()) {
+            return found->get<timestamp_t>();
+        }
+        return now_timestamp();
+    }
+
+    int64_t system_now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t coarse_now_ns() {
+        start_coarse_clock();
+        return coarse_time.load(std::memory_order_relaxed);
+    }
+
+    int64_t tsc_now_ns() {
+        if (tsc_scale.load(std::memory_order_acquire) == 0) {
+            std::call_once(tsc_first_calibration, [] { calibrate_tsc(); });
+        }
+        uint64_t now = counter();
+        while (true) {
+            uint32_t sequence = tsc_sequence.load(std::memory_order_acquire);
+            uint64_t base_counter = tsc_base_counter.load(std::memory_order_relaxed);
+            int64_t base_ns = tsc_base_ns.load(std::memory_order_relaxed);
+            uint64_t scale = tsc_scale.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((sequence & 1) == 0 && tsc_sequence.load(std::memory_order_relaxed) == sequence) {
+                // a counter read before the base, by a thread that raced a recalibration, counts back
+                auto ticks = static_cast<__int128>(static_cast<int64_t>(now - base_counter));
+                return base_ns + static_cast<int64_t>((ticks * scale) >> 32);
+            }
+        }
+    }
+
+    int64_t simulated_now_ns() {
+        return simulated_time.load(std::memory_order_relaxed);
+    }
+
+    void set_coarse_resolution(std::chrono::nanoseconds resolution) {
+        {
+            std::lock_guard<std::mutex> lock(coarse_mutex);
+            coarse_resolution.store(std::max<int64_t>(resolution.count(), 1), std::memory_order_relaxed);
+        }
+        coarse_wake.notify_all();
+    }
+
+    void calibrate_tsc(std::chrono::nanoseconds window) {
+        std::lock_guard<std::mutex> lock(tsc_calibration);
+        int64_t start_ns = system_now_ns();
+        uint64_t start = counter();
+        std::this_thread::sleep_for(window);
+        int64_t end_ns = system_now_ns();
+        uint64_t end = counter();
+        // nanoseconds per tick in 32.32 fixed point
+        uint64_t scale = end > start && end_ns > start_ns
+                         ? static_cast<uint64_t>((static_cast<unsigned __int128>(end_ns - start_ns) << 32) /
+                                                 (end - start))
+                         : uint64_t{1} << 32;
+
+        tsc_sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        tsc_base_counter.store(end, std::memory_order_relaxed);
+        tsc_base_ns.store(end_ns, std::memory_order_relaxed);
+        tsc_scale.store(scale, std::memory_order_relaxed);
+        tsc_sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    void set_simulated_time(int64_t ns) {
+        simulated_time.store(ns, std::memory_order_relaxed);
+    }
+
+    void advance_simulated_time(int64_t ns) {
+        simulated_time.fetch_add(ns, std::memory_order_relaxed);
+    }
+}
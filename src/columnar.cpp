@@ -0,0 +1,423 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/columnar.h>
+
+#include <algorithm>
+#include "parallel_sort.h"
+
+namespace trading::common {
+
+    ColumnsOHLCV ColumnsOHLCV::subspan(size_t offset, size_t count) const {
+        return {timestamp.subspan(offset, count),
+                open.subspan(offset, count),
+                high.subspan(offset, count),
+                low.subspan(offset, count),
+                close.subspan(offset, count),
+                volume.subspan(offset, count)};
+    }
+
+    ColumnsOHLCV ColumnsOHLCV::range(timestamp_t from, timestamp_t to) const {
+        if (to <= from) {
+            return subspan(0, 0);
+        }
+        auto first = std::lower_bound(timestamp.begin(), timestamp.end(), from);
+        auto last = std::lower_bound(first, timestamp.end(), to);
+        return subspan(first - timestamp.begin(), last - first);
+    }
+
+    ColumnsOHLCV ColumnsOHLCV::last(size_t count) const {
+        count = std::min(count, size());
+        return subspan(size() - count, count);
+    }
+
+    std::optional<size_t> ColumnsOHLCV::find(timestamp_t at) const {
+        auto it = std::lower_bound(timestamp.begin(), timestamp.end(), at);
+        if (it == timestamp.end() || *it != at) {
+            return std::nullopt;
+        }
+        return it - timestamp.begin();
+    }
+
+    std::optional<size_t> ColumnsOHLCV::as_of(timestamp_t at) const {
+        auto it = std::upper_bound(timestamp.begin(), timestamp.end(), at);
+        if (it == timestamp.begin()) {
+            return std::nullopt;
+        }
+        return it - timestamp.begin() - 1;
+    }
+
+    OHLCV ColumnarSeriesOHLCV::Bar::to_ohlcv(const symbol_t &symbol) const {
+        return {symbol, timestamp, open, high, low, close, volume};
+    }
+
+    json ColumnarSeriesOHLCV::Bar::to_json() const {
+        json j;
+        j["timestamp"] = timestamp;
+        j["open"] = open;
+        j["high"] = high;
+        j["low"] = low;
+        j["close"] = close;
+        j["volume"] = volume;
+        return j;
+    }
+
+    ColumnarSeriesOHLCV::Bar ColumnarSeriesOHLCV::BarRef::get() const {
+        return {timestamp, open, high, low, close, volume};
+    }
+
+    ColumnarSeriesOHLCV::ColumnarSeriesOHLCV(symbol_t symbol) : m_symbol(std::move(symbol)) {}
+
+    ColumnarSeriesOHLCV::ColumnarSeriesOHLCV(const json &j) {
+        try {
+            reserve(j.size());
+            for (auto &item: j) {
+                insert(Bar{item.at("timestamp").get<timestamp_t>(),
+                           item.at("open").get<double>(),
+                           item.at("high").get<double>(),
+                           item.at("low").get<double>(),
+                           item.at("close").get<double>(),
+                           item.at("volume").get<size_t>()});
+            }
+        } catch (json::exception &e) {
+            throw OHLCException("Error parsing OHLC json: " + std::string(e.what()));
+        }
+    }
+
+    ColumnarSeriesOHLCV::ColumnarSeriesOHLCV(const SeriesOHLCV &series) {
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            const auto &[timestamp, ohlc] = *it;
+            if (m_symbol->empty()) {
+                m_symbol = ohlc.symbol;
+            }
+            // the map is already sorted, so every bar lands at the back
+            insert_at(m_timestamp.size(), timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume);
+        }
+    }
+
+    ColumnarSeriesOHLCV::ColumnarSeriesOHLCV(symbol_t symbol, std::vector<timestamp_t> timestamp,
+                                             std::vector<double> open, std::vector<double> high,
+                                             std::vector<double> low, std::vector<double> close,
+                                             std::vector<size_t> volume)
+            : m_symbol(std::move(symbol)), m_timestamp(std::move(timestamp)), m_open(std::move(open)),
+              m_high(std::move(high)), m_low(std::move(low)), m_close(std::move(close)),
+              m_volume(std::move(volume)) {
+        const size_t n = m_timestamp.size();
+        if (m_open.size() != n || m_high.size() != n || m_low.size() != n || m_close.size() != n
+            || m_volume.size() != n) {
+            throw OHLCException("Columns of a series must all have the same length");
+        }
+        auto unordered = std::adjacent_find(m_timestamp.begin(), m_timestamp.end(), std::greater_equal<>());
+        if (unordered != m_timestamp.end()) {
+            throw OHLCException("Timestamps of a series must be strictly increasing");
+        }
+    }
+
+    json ColumnarSeriesOHLCV::to_json() const {
+        json j;
+        for (size_t i = 0; i < m_timestamp.size(); ++i) {
+            j.push_back(at(i).to_json());
+        }
+        return j;
+    }
+
+    SeriesOHLCV ColumnarSeriesOHLCV::to_series() const {
+        SeriesOHLCV series;
+        for (size_t i = 0; i < m_timestamp.size(); ++i) {
+            series.insert(at(i).to_ohlcv(m_symbol));
+        }
+        return series;
+    }
+
+    const symbol_t &ColumnarSeriesOHLCV::symbol() const {
+        return m_symbol;
+    }
+
+    bool ColumnarSeriesOHLCV::empty() const {
+        return m_timestamp.empty();
+    }
+
+    size_t ColumnarSeriesOHLCV::size() const {
+        return m_timestamp.size();
+    }
+
+    void ColumnarSeriesOHLCV::reserve(size_t capacity) {
+        m_timestamp.reserve(capacity);
+        m_open.reserve(capacity);
+        m_high.reserve(capacity);
+        m_low.reserve(capacity);
+        m_close.reserve(capacity);
+        m_volume.reserve(capacity);
+    }
+
+    void ColumnarSeriesOHLCV::clear() {
+        m_timestamp.clear();
+        m_open.clear();
+        m_high.clear();
+        m_low.clear();
+        m_close.clear();
+        m_volume.clear();
+    }
+
+    size_t ColumnarSeriesOHLCV::lower_bound(timestamp_t timestamp) const {
+        // fast path for the usual in-order append
+        if (m_timestamp.empty() || m_timestamp.back() < timestamp) {
+            return m_timestamp.size();
+        }
+        return std::lower_bound(m_timestamp.begin(), m_timestamp.end(), timestamp) - m_timestamp.begin();
+    }
+
+    void ColumnarSeriesOHLCV::insert_at(size_t index, timestamp_t timestamp, double open, double high, double low,
+                                        double close, size_t volume) {
+        auto offset = static_cast<std::ptrdiff_t>(index);
+        m_timestamp.insert(m_timestamp.begin() + offset, timestamp);
+        m_open.insert(m_open.begin() + offset, open);
+        m_high.insert(m_high.begin() + offset, high);
+        m_low.insert(m_low.begin() + offset, low);
+        m_close.insert(m_close.begin() + offset, close);
+        m_volume.insert(m_volume.begin() + offset, volume);
+    }
+
+    void ColumnarSeriesOHLCV::apply(size_t index, const Bar &bar, DuplicatePolicy policy) {
+        switch (policy) {
+            case DuplicatePolicy::KEEP:
+                break;
+            case DuplicatePolicy::REPLACE:
+                m_open[index] = bar.open;
+                m_high[index] = bar.high;
+                m_low[index] = bar.low;
+                m_close[index] = bar.close;
+                m_volume[index] = bar.volume;
+                break;
+            case DuplicatePolicy::AGGREGATE:
+                m_high[index] = std::max(m_high[index], bar.high);
+                m_low[index] = std::min(m_low[index], bar.low);
+                m_close[index] = bar.close;
+                m_volume[index] += bar.volume;
+                break;
+        }
+    }
+
+    void ColumnarSeriesOHLCV::append(const Bar &bar, DuplicatePolicy policy) {
+        if (!m_timestamp.empty() && m_timestamp.back() == bar.timestamp) {
+            apply(m_timestamp.size() - 1, bar, policy);
+            return;
+        }
+        m_timestamp.push_back(bar.timestamp);
+        m_open.push_back(bar.open);
+        m_high.push_back(bar.high);
+        m_low.push_back(bar.low);
+        m_close.push_back(bar.close);
+        m_volume.push_back(bar.volume);
+    }
+
+    template<typename F>
+    void ColumnarSeriesOHLCV::merge(size_t count, F bar, DuplicatePolicy policy) {
+        if (count == 0) {
+            return;
+        }
+        const size_t start = lower_bound(bar(0).timestamp);
+        if (start == m_timestamp.size()) {
+            reserve(start + count);
+            for (size_t j = 0; j < count; ++j) {
+                append(bar(j), policy);
+            }
+            return;
+        }
+
+        // the bars from `start` on and the new ones, interleaved; a bar of the series goes before a new one with
+        // the same timestamp, which append() then applies to it
+        ColumnarSeriesOHLCV tail;
+        tail.reserve(m_timestamp.size() - start + count);
+        size_t i = start;
+        for (size_t j = 0; j < count; ++j) {
+            const Bar incoming = bar(j);
+            while (i < m_timestamp.size() && m_timestamp[i] <= incoming.timestamp) {
+                tail.append(at(i++), policy);
+            }
+            tail.append(incoming, policy);
+        }
+        for (; i < m_timestamp.size(); ++i) {
+            tail.append(at(i), policy);
+        }
+
+        auto replace_tail = [start](auto &column, const auto &from) {
+            column.resize(start);
+            column.insert(column.end(), from.begin(), from.end());
+        };
+        replace_tail(m_timestamp, tail.m_timestamp);
+        replace_tail(m_open, tail.m_open);
+        replace_tail(m_high, tail.m_high);
+        replace_tail(m_low, tail.m_low);
+        replace_tail(m_close, tail.m_close);
+        replace_tail(m_volume, tail.m_volume);
+    }
+
+    bool ColumnarSeriesOHLCV::insert(const OHLCV &ohlc, DuplicatePolicy policy) {
+        if (m_symbol->empty()) {
+            m_symbol = ohlc.symbol;
+        }
+        return insert(Bar{ohlc.timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume}, policy);
+    }
+
+    bool ColumnarSeriesOHLCV::insert(const Bar &bar, DuplicatePolicy policy) {
+        try {
+            size_t index = lower_bound(bar.timestamp);
+            if (index < m_timestamp.size() && m_timestamp[index] == bar.timestamp) {
+                apply(index, bar, policy);
+                return true;
+            }
+            insert_at(index, bar.timestamp, bar.open, bar.high, bar.low, bar.close, bar.volume);
+            return true;
+        } catch (std::exception &e) {
+            return false;
+        }
+    }
+
+    bool ColumnarSeriesOHLCV::insert(const ColumnarSeriesOHLCV &series, DuplicatePolicy policy) {
+        if (&series == this) {
+            return true;
+        }
+        if (m_symbol->empty()) {
+            m_symbol = series.m_symbol;
+        }
+        try {
+            merge(series.size(), [&series](size_t j) { return series.at(j); }, policy);
+            return true;
+        } catch (std::exception &e) {
+            return false;
+        }
+    }
+
+    bool ColumnarSeriesOHLCV::insert(std::span<const Bar> bars, DuplicatePolicy policy, size_t threads) {
+        try {
+            auto earlier = [](const Bar &a, const Bar &b) { return a.timestamp < b.timestamp; };
+            if (std::is_sorted(bars.begin(), bars.end(), earlier)) {
+                merge(bars.size(), [bars](size_t j) { return bars[j]; }, policy);
+                return true;
+            }
+            std::vector<const Bar *> sorted;
+            sorted.reserve(bars.size());
+            for (const auto &bar: bars) {
+                sorted.push_back(&bar);
+            }
+            parallel_stable_sort(sorted.begin(), sorted.end(),
+                                 [](const Bar *a, const Bar *b) { return a->timestamp < b->timestamp; }, threads);
+            merge(sorted.size(), [&sorted](size_t j) { return *sorted[j]; }, policy);
+            return true;
+        } catch (std::exception &e) {
+            return false;
+        }
+    }
+
+    ColumnarSeriesOHLCV::BarRef ColumnarSeriesOHLCV::operator[](timestamp_t timestamp) {
+        size_t index = lower_bound(timestamp);
+        if (index == m_timestamp.size() || m_timestamp[index] != timestamp) {
+            insert_at(index, timestamp, 0, 0, 0, 0, 0);
+        }
+        return {m_timestamp[index], m_open[index], m_high[index], m_low[index], m_close[index], m_volume[index]};
+    }
+
+    ColumnarSeriesOHLCV::BarRef ColumnarSeriesOHLCV::operator[](const std::string &date) {
+        return (*this)[date_string_to_epoch(date)];
+    }
+
+    ColumnarSeriesOHLCV::Bar ColumnarSeriesOHLCV::at(size_t index) const {
+        return {m_timestamp[index], m_open[index], m_high[index], m_low[index], m_close[index], m_volume[index]};
+    }
+
+    std::optional<ColumnarSeriesOHLCV::Bar> ColumnarSeriesOHLCV::find(timestamp_t timestamp) const {
+        auto index = columns().find(timestamp);
+        if (!index) {
+            return std::nullopt;
+        }
+        return at(*index);
+    }
+
+    std::optional<ColumnarSeriesOHLCV::Bar> ColumnarSeriesOHLCV::as_of(timestamp_t timestamp) const {
+        auto index = columns().as_of(timestamp);
+        if (!index) {
+            return std::nullopt;
+        }
+        return at(*index);
+    }
+
+    ColumnsOHLCV ColumnarSeriesOHLCV::range(timestamp_t from, timestamp_t to) const {
+        return columns().range(from, to);
+    }
+
+    ColumnsOHLCV ColumnarSeriesOHLCV::last(size_t count) const {
+        return columns().last(count);
+    }
+
+    std::span<const timestamp_t> ColumnarSeriesOHLCV::timestamps() const {
+        return m_timestamp;
+    }
+
+    std::span<const double> ColumnarSeriesOHLCV::open() const {
+        return m_open;
+    }
+
+    std::span<const double> ColumnarSeriesOHLCV::high() const {
+        return m_high;
+    }
+
+    std::span<const double> ColumnarSeriesOHLCV::low() const {
+        return m_low;
+    }
+
+    std::span<const double> ColumnarSeriesOHLCV::close() const {
+        return m_close;
+    }
+
+    std::span<const size_t> ColumnarSeriesOHLCV::volume() const {
+        return m_volume;
+    }
+
+    ColumnsOHLCV ColumnarSeriesOHLCV::columns() const {
+        return {m_timestamp, m_open, m_high, m_low, m_close, m_volume};
+    }
+
+    ColumnarSeriesOHLCV::iterator::iterator(const ColumnarSeriesOHLCV *s, std::ptrdiff_t i) : series(s), index(i) {}
+
+    ColumnarSeriesOHLCV::iterator &ColumnarSeriesOHLCV::iterator::operator++() {
+        ++index;
+        return *this;
+    }
+
+    ColumnarSeriesOHLCV::iterator &ColumnarSeriesOHLCV::iterator::operator--() {
+        --index;
+        return *this;
+    }
+
+    bool ColumnarSeriesOHLCV::iterator::operator==(const iterator &other) const {
+        return index == other.index;
+    }
+
+    bool ColumnarSeriesOHLCV::iterator::operator!=(const iterator &other) const {
+        return index != other.index;
+    }
+
+    std::pair<const timestamp_t, ColumnarSeriesOHLCV::Bar> ColumnarSeriesOHLCV::iterator::operator*() const {
+        auto bar = series->at(static_cast<size_t>(index));
+        return {bar.timestamp, bar};
+    }
+
+    ColumnarSeriesOHLCV::iterator ColumnarSeriesOHLCV::begin() const {
+        return {this, 0};
+    }
+
+    ColumnarSeriesOHLCV::iterator ColumnarSeriesOHLCV::end() const {
+        return {this, static_cast<std::ptrdiff_t>(m_timestamp.size())};
+    }
+
+    ColumnarSeriesOHLCV::iterator ColumnarSeriesOHLCV::rbegin() const {
+        return {this, static_cast<std::ptrdiff_t>(m_timestamp.size()) - 1};
+    }
+
+    ColumnarSeriesOHLCV::iterator ColumnarSeriesOHLCV::rend() const {
+        return {this, -1};
+    }
+
+}
@@ -0,0 +1,370 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/compressed_series.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace trading::common {
+
+    namespace {
+        class BitReader {
+        private:
+            const uint64_t *m_words;
+            size_t m_position = 0;
+
+        public:
+            explicit BitReader(const BitStream &stream) : m_words(stream.words.data()) {}
+
+            // next 64 bits, left aligned; past the end they are zeros
+            [[nodiscard]] uint64_t peek() const {
+                size_t word = m_position >> 6;
+                unsigned offset = m_position & 63;
+                // shifting by 1 then 63 - offset avoids a branch for offset 0
+                return (m_words[word] << offset) | ((m_words[word + 1] >> 1) >> (63 - offset));
+            }
+
+            void skip(unsigned count) {
+                m_position += count;
+            }
+
+            // 1 <= count <= 64
+            uint64_t read(unsigned count) {
+                uint64_t bits = peek() >> (64 - count);
+                m_position += count;
+                return bits;
+            }
+        };
+
+        // delta of delta buckets: 0 | 10 + 7 bits | 110 + 9 bits | 1110 + 12 bits | 1111 + 64 bits
+        void put_timestamp(BitStream &stream, int64_t dod) {
+            if (dod == 0) {
+                stream.write(0, 1);
+            } else if (dod >= -63 && dod <= 64) {
+                stream.write((uint64_t{0b10} << 7) | static_cast<uint64_t>(dod + 63), 9);
+            } else if (dod >= -255 && dod <= 256) {
+                stream.write((uint64_t{0b110} << 9) | static_cast<uint64_t>(dod + 255), 12);
+            } else if (dod >= -2047 && dod <= 2048) {
+                stream.write((uint64_t{0b1110} << 12) | static_cast<uint64_t>(dod + 2047), 16);
+            } else {
+                stream.write(0b1111, 4);
+                stream.write(static_cast<uint64_t>(dod), 64);
+            }
+        }
+
+        int64_t get_timestamp(BitReader &reader) {
+            uint64_t bits = reader.peek();
+            switch (std::countl_one(bits)) {
+                case 0:
+                    reader.skip(1);
+                    return 0;
+                case 1:
+                    reader.skip(9);
+                    return static_cast<int64_t>((bits >> 55) & 0x7f) - 63;
+                case 2:
+                    reader.skip(12);
+                    return static_cast<int64_t>((bits >> 52) & 0x1ff) - 255;
+                case 3:
+                    reader.skip(16);
+                    return static_cast<int64_t>((bits >> 48) & 0xfff) - 2047;
+                default:
+                    reader.skip(4);
+                    return static_cast<int64_t>(reader.read(64));
+            }
+        }
+
+        // 0: same as the reference | 10: meaningful bits in the previous window | 11 + 5 bits leading zeros +
+        // 6 bits length (0 for 64) + meaningful bits
+        class PriceReader {
+        private:
+            BitReader m_reader;
+            unsigned m_leading = 0;
+            unsigned m_trailing = 0;
+
+        public:
+            explicit PriceReader(const BitStream &stream) : m_reader(stream) {}
+
+            double next(double reference) {
+                uint64_t bits = m_reader.peek();
+                if ((bits >> 63) == 0) {
+                    m_reader.skip(1);
+                    return reference;
+                }
+                // both kinds of window are decoded and one picked, prices are too random to predict which comes
+                bool fresh = (bits >> 62) & 1;
+                unsigned leading = (bits >> 57) & 31;
+                unsigned length = (((bits >> 51) - 1) & 63) + 1;
+                m_leading = fresh ? leading : m_leading;
+                m_trailing = fresh ? 64 - leading - length : m_trailing;
+                m_reader.skip(fresh ? 13 : 2);
+                uint64_t x = m_reader.read(64 - m_leading - m_trailing) << m_trailing;
+                return std::bit_cast<double>(std::bit_cast<uint64_t>(reference) ^ x);
+            }
+        };
+
+        void put_volume(BitStream &stream, size_t volume) {
+            while (volume >= 0x80) {
+                stream.write((volume & 0x7f) | 0x80, 8);
+                volume >>= 7;
+            }
+            stream.write(volume, 8);
+        }
+
+        size_t get_volume(BitReader &reader) {
+            size_t volume = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                uint64_t byte = reader.read(8);
+                volume |= (byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return volume;
+                }
+            }
+        }
+
+        void append_columns(CompressedSeriesOHLCV::Buffer &out, const ColumnsOHLCV &columns) {
+            out.timestamp.insert(out.timestamp.end(), columns.timestamp.begin(), columns.timestamp.end());
+            out.open.insert(out.open.end(), columns.open.begin(), columns.open.end());
+            out.high.insert(out.high.end(), columns.high.begin(), columns.high.end());
+            out.low.insert(out.low.end(), columns.low.begin(), columns.low.end());
+            out.close.insert(out.close.end(), columns.close.begin(), columns.close.end());
+            out.volume.insert(out.volume.end(), columns.volume.begin(), columns.volume.end());
+        }
+    }
+
+    void BitStream::write(uint64_t value, unsigned count) {
+        size_t needed = ((bits + count) >> 6) + 2;
+        while (words.size() < needed) {
+            words.push_back(0);
+        }
+        size_t word = bits >> 6;
+        unsigned offset = bits & 63;
+        value <<= 64 - count;
+        words[word] |= value >> offset;
+        if (offset + count > 64) {
+            words[word + 1] |= value << (64 - offset);
+        }
+        bits += count;
+    }
+
+    CompressedSeriesOHLCV::CompressedSeriesOHLCV(symbol_t symbol, size_t block_size)
+            : m_symbol(std::move(symbol)), m_block_size(block_size) {
+        if (block_size == 0) {
+            throw OHLCException("Compressed series block size must be greater than 0");
+        }
+    }
+
+    CompressedSeriesOHLCV::CompressedSeriesOHLCV(const ColumnarSeriesOHLCV &series, size_t block_size)
+            : CompressedSeriesOHLCV(series.symbol(), block_size) {
+        auto columns = series.columns();
+        for (size_t i = 0; i < columns.size(); ++i) {
+            append(Bar{columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i], columns.close[i],
+                       columns.volume[i]});
+        }
+    }
+
+    size_t CompressedSeriesOHLCV::bytes() const {
+        size_t total = m_blocks.capacity() * sizeof(Block);
+        for (const auto &block: m_blocks) {
+            for (const auto &stream: block.streams) {
+                total += stream.words.capacity() * sizeof(uint64_t);
+            }
+        }
+        return total;
+    }
+
+    void CompressedSeriesOHLCV::put_price(BitStream &stream, Window &window, double value, double reference) {
+        uint64_t x = std::bit_cast<uint64_t>(value) ^ std::bit_cast<uint64_t>(reference);
+        if (x == 0) {
+            stream.write(0, 1);
+            return;
+        }
+        auto leading = std::min<unsigned>(std::countl_zero(x), 31);
+        auto trailing = static_cast<unsigned>(std::countr_zero(x));
+        unsigned length = 64 - leading - trailing;
+        // reuse the previous window when it holds the bits and is not longer than describing a new one
+        if (leading >= window.leading && trailing >= window.trailing &&
+            64 - window.leading - window.trailing <= length + 11) {
+            stream.write(0b10, 2);
+            stream.write(x >> window.trailing, 64 - window.leading - window.trailing);
+            return;
+        }
+        stream.write((uint64_t{0b11} << 11) | (leading << 6) | (length & 63), 13);
+        stream.write(x >> trailing, length);
+        window = {leading, trailing};
+    }
+
+    bool CompressedSeriesOHLCV::append(const Bar &bar) {
+        if (m_size > 0 && bar.timestamp <= m_last.timestamp) {
+            return false;
+        }
+        if (m_blocks.empty() || m_blocks.back().count == m_block_size) {
+            if (!m_blocks.empty()) {
+                for (auto &stream: m_blocks.back().streams) {
+                    stream.words.shrink_to_fit();
+                }
+            }
+            m_blocks.emplace_back();
+            m_blocks.back().first = bar.timestamp;
+            m_delta = 0;
+            m_windows = {};
+        }
+        Block &block = m_blocks.back();
+        // every block starts from zero references so it decodes on its own
+        Bar previous = block.count > 0 ? m_last : Bar{};
+        if (block.count > 0) {
+            auto delta = static_cast<int64_t>(bar.timestamp - previous.timestamp);
+            put_timestamp(block.streams[TIMESTAMP], delta - m_delta);
+            m_delta = delta;
+        }
+        put_price(block.streams[OPEN], m_windows[OPEN], bar.open, previous.close);
+        put_price(block.streams[HIGH], m_windows[HIGH], bar.high, previous.high);
+        put_price(block.streams[LOW], m_windows[LOW], bar.low, previous.low);
+        put_price(block.streams[CLOSE], m_windows[CLOSE], bar.close, previous.close);
+        put_volume(block.streams[VOLUME], bar.volume);
+        block.last = bar.timestamp;
+        ++block.count;
+        ++m_size;
+        m_last = bar;
+        return true;
+    }
+
+    bool CompressedSeriesOHLCV::append(const OHLCV &ohlc) {
+        if (m_symbol->empty()) {
+            m_symbol = ohlc.symbol;
+        }
+        return append(Bar{ohlc.timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+    }
+
+    ColumnsOHLCV CompressedSeriesOHLCV::decode(size_t index, Buffer &buffer) const {
+        return decode(index, buffer, std::numeric_limits<timestamp_t>::max());
+    }
+
+    ColumnsOHLCV CompressedSeriesOHLCV::decode(size_t index, Buffer &buffer, timestamp_t until) const {
+        const Block &block = m_blocks.at(index);
+        size_t count = block.count;
+        buffer.timestamp.resize(count);
+        buffer.open.resize(count);
+        buffer.high.resize(count);
+        buffer.low.resize(count);
+        buffer.close.resize(count);
+        buffer.volume.resize(count);
+
+        // one loop over all the columns: each stream is a serial chain of reads, so decoding them side by side
+        // lets the chains overlap
+        BitReader timestamps(block.streams[TIMESTAMP]);
+        PriceReader opens(block.streams[OPEN]);
+        PriceReader highs(block.streams[HIGH]);
+        PriceReader lows(block.streams[LOW]);
+        PriceReader closes(block.streams[CLOSE]);
+        BitReader volumes(block.streams[VOLUME]);
+        timestamp_t timestamp = block.first;
+        int64_t delta = 0;
+        double open = 0, high = 0, low = 0, close = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) {
+                delta += get_timestamp(timestamps);
+                timestamp += static_cast<timestamp_t>(delta);
+            }
+            open = opens.next(close);
+            high = highs.next(high);
+            low = lows.next(low);
+            close = closes.next(close);
+            buffer.timestamp[i] = timestamp;
+            buffer.open[i] = open;
+            buffer.high[i] = high;
+            buffer.low[i] = low;
+            buffer.close[i] = close;
+            buffer.volume[i] = get_volume(volumes);
+            if (timestamp >= until) {
+                count = i + 1;
+                break;
+            }
+        }
+        return ColumnsOHLCV{buffer.timestamp, buffer.open, buffer.high, buffer.low, buffer.close, buffer.volume}
+                .subspan(0, count);
+    }
+
+    CompressedSeriesOHLCV::Bar CompressedSeriesOHLCV::at(size_t index) const {
+        if (index >= m_size) {
+            throw OHLCException("Compressed series index " + std::to_string(index) + " is out of range");
+        }
+        Buffer buffer;
+        auto columns = decode(index / m_block_size, buffer);
+        size_t i = index % m_block_size;
+        return {columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i], columns.close[i],
+                columns.volume[i]};
+    }
+
+    CompressedSeriesOHLCV::Bar CompressedSeriesOHLCV::back() const {
+        if (m_size == 0) {
+            throw OHLCException("Empty compressed series has no last bar");
+        }
+        return m_last;
+    }
+
+    std::optional<size_t> CompressedSeriesOHLCV::block_of(timestamp_t timestamp) const {
+        // last block starting at or before the timestamp
+        auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), timestamp,
+                                   [](timestamp_t t, const Block &block) { return t < block.first; });
+        if (it == m_blocks.begin()) {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(it - m_blocks.begin()) - 1;
+    }
+
+    std::optional<CompressedSeriesOHLCV::Bar> CompressedSeriesOHLCV::find(timestamp_t timestamp) const {
+        auto block = block_of(timestamp);
+        if (!block || timestamp > m_blocks[*block].last) {
+            return std::nullopt;
+        }
+        Buffer buffer;
+        auto columns = decode(*block, buffer, timestamp);
+        auto i = columns.find(timestamp);
+        if (!i) {
+            return std::nullopt;
+        }
+        return Bar{timestamp, columns.open[*i], columns.high[*i], columns.low[*i], columns.close[*i],
+                   columns.volume[*i]};
+    }
+
+    std::optional<CompressedSeriesOHLCV::Bar> CompressedSeriesOHLCV::as_of(timestamp_t timestamp) const {
+        auto block = block_of(timestamp);
+        if (!block) {
+            return std::nullopt;
+        }
+        if (timestamp >= m_blocks[*block].last && *block + 1 == m_blocks.size()) {
+            return m_last;
+        }
+        Buffer buffer;
+        auto columns = decode(*block, buffer, timestamp);
+        size_t i = *columns.as_of(timestamp);
+        return Bar{columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i], columns.close[i],
+                   columns.volume[i]};
+    }
+
+    ColumnarSeriesOHLCV CompressedSeriesOHLCV::range(timestamp_t from, timestamp_t to) const {
+        Buffer result;
+        if (from < to && !m_blocks.empty()) {
+            Buffer buffer;
+            for (size_t b = block_of(from).value_or(0); b < m_blocks.size() && m_blocks[b].first < to; ++b) {
+                append_columns(result, decode(b, buffer).range(from, to));
+            }
+        }
+        return {m_symbol, std::move(result.timestamp), std::move(result.open), std::move(result.high),
+                std::move(result.low), std::move(result.close), std::move(result.volume)};
+    }
+
+    ColumnarSeriesOHLCV CompressedSeriesOHLCV::to_columnar() const {
+        Buffer result;
+        Buffer buffer;
+        for (size_t b = 0; b < m_blocks.size(); ++b) {
+            append_columns(result, decode(b, buffer));
+        }
+        return {m_symbol, std::move(result.timestamp), std::move(result.open), std::move(result.high),
+                std::move(result.low), std::move(result.close), std::move(result.volume)};
+    }
+
+}
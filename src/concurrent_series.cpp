@@ -0,0 +1,220 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/concurrent_series.h>
+
+#include <algorithm>
+
+namespace trading::common {
+
+    ConcurrentSeriesOHLCV::ConcurrentSeriesOHLCV() : ConcurrentSeriesOHLCV(symbol_t{}) {}
+
+    ConcurrentSeriesOHLCV::ConcurrentSeriesOHLCV(symbol_t symbol) : m_storage(std::make_shared<Storage>()) {
+        m_storage->symbol = std::move(symbol);
+    }
+
+    ConcurrentSeriesOHLCV::Chunk *ConcurrentSeriesOHLCV::chunk_for_append(size_t index) {
+        size_t chunk_index = index >> CHUNK_BITS;
+        auto &storage = *m_storage;
+        if (chunk_index < storage.chunks.size()) {
+            return storage.chunks[chunk_index].get();
+        }
+
+        // new chunk, left uninitialized on purpose: every slot is written before it is published
+        storage.chunks.emplace_back(new Chunk);
+        Chunk *chunk = storage.chunks.back().get();
+
+        Directory *directory = storage.directory.load(std::memory_order_relaxed);
+        if (directory == nullptr || chunk_index >= directory->capacity) {
+            // readers may still hold the old directory, so it is retired instead of freed
+            auto grown = std::make_unique<Directory>();
+            grown->capacity = directory == nullptr ? 16 : directory->capacity * 2;
+            grown->chunks = std::make_unique<Chunk *[]>(grown->capacity);
+            if (directory != nullptr) {
+                std::copy_n(directory->chunks.get(), directory->capacity, grown->chunks.get());
+            }
+            directory = grown.get();
+            storage.directories.push_back(std::move(grown));
+            directory->chunks[chunk_index] = chunk;
+            storage.directory.store(directory, std::memory_order_release);
+        } else {
+            // the slot is beyond every published size, no reader looks at it yet
+            directory->chunks[chunk_index] = chunk;
+        }
+        return chunk;
+    }
+
+    bool ConcurrentSeriesOHLCV::append(const OHLCV &ohlc) {
+        return append(Bar{ohlc.timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+    }
+
+    bool ConcurrentSeriesOHLCV::append(const Bar &bar) {
+        size_t index = m_storage->size.load(std::memory_order_relaxed);
+        if (index != 0 && bar.timestamp <= m_last_timestamp) {
+            return false;
+        }
+        Chunk *chunk = chunk_for_append(index);
+        size_t slot = index & CHUNK_MASK;
+        chunk->timestamp[slot] = bar.timestamp;
+        chunk->open[slot] = bar.open;
+        chunk->high[slot] = bar.high;
+        chunk->low[slot] = bar.low;
+        chunk->close[slot] = bar.close;
+        chunk->volume[slot] = bar.volume;
+        m_last_timestamp = bar.timestamp;
+        m_storage->size.store(index + 1, std::memory_order_release);
+        return true;
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot ConcurrentSeriesOHLCV::snapshot() const {
+        // size first: the release store on size orders every directory and chunk write before it
+        size_t size = m_storage->size.load(std::memory_order_acquire);
+        const Directory *directory = m_storage->directory.load(std::memory_order_acquire);
+        return {m_storage, directory, size};
+    }
+
+    std::optional<ConcurrentSeriesOHLCV::Bar> ConcurrentSeriesOHLCV::last() const {
+        // same order as snapshot()
+        size_t size = m_storage->size.load(std::memory_order_acquire);
+        if (size == 0) {
+            return std::nullopt;
+        }
+        const Directory *directory = m_storage->directory.load(std::memory_order_acquire);
+        size_t index = size - 1;
+        const Chunk *chunk = directory->chunks[index >> CHUNK_BITS];
+        size_t slot = index & CHUNK_MASK;
+        return Bar{chunk->timestamp[slot], chunk->open[slot], chunk->high[slot], chunk->low[slot], chunk->close[slot],
+                   chunk->volume[slot]};
+    }
+
+    size_t ConcurrentSeriesOHLCV::size() const {
+        return m_storage->size.load(std::memory_order_acquire);
+    }
+
+    bool ConcurrentSeriesOHLCV::empty() const {
+        return size() == 0;
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::Snapshot(std::shared_ptr<const Storage> storage, const Directory *directory,
+                                              size_t size) : m_storage(std::move(storage)),
+                                                             m_directory(directory),
+                                                             m_size(size) {}
+
+    bool ConcurrentSeriesOHLCV::Snapshot::empty() const {
+        return m_size == 0;
+    }
+
+    size_t ConcurrentSeriesOHLCV::Snapshot::size() const {
+        return m_size;
+    }
+
+    size_t ConcurrentSeriesOHLCV::Snapshot::version() const {
+        return m_size;
+    }
+
+    const symbol_t &ConcurrentSeriesOHLCV::Snapshot::symbol() const {
+        if (!m_storage) {
+            throw OHLCException("Empty snapshot has no symbol");
+        }
+        return m_storage->symbol;
+    }
+
+    timestamp_t ConcurrentSeriesOHLCV::Snapshot::timestamp(size_t index) const {
+        return m_directory->chunks[index >> CHUNK_BITS]->timestamp[index & CHUNK_MASK];
+    }
+
+    ConcurrentSeriesOHLCV::Bar ConcurrentSeriesOHLCV::Snapshot::at(size_t index) const {
+        if (index >= m_size) {
+            throw OHLCException("Snapshot index out of range: " + std::to_string(index));
+        }
+        const Chunk *chunk = m_directory->chunks[index >> CHUNK_BITS];
+        size_t slot = index & CHUNK_MASK;
+        return {chunk->timestamp[slot], chunk->open[slot], chunk->high[slot], chunk->low[slot], chunk->close[slot],
+                chunk->volume[slot]};
+    }
+
+    ConcurrentSeriesOHLCV::Bar ConcurrentSeriesOHLCV::Snapshot::back() const {
+        if (m_size == 0) {
+            throw OHLCException("Empty snapshot has no last bar");
+        }
+        return at(m_size - 1);
+    }
+
+    std::vector<ColumnsOHLCV> ConcurrentSeriesOHLCV::Snapshot::segments() const {
+        std::vector<ColumnsOHLCV> result;
+        result.reserve((m_size + CHUNK_SIZE - 1) >> CHUNK_BITS);
+        for (size_t offset = 0; offset < m_size; offset += CHUNK_SIZE) {
+            const Chunk *chunk = m_directory->chunks[offset >> CHUNK_BITS];
+            size_t count = std::min(CHUNK_SIZE, m_size - offset);
+            result.push_back({{chunk->timestamp, count},
+                              {chunk->open,      count},
+                              {chunk->high,      count},
+                              {chunk->low,       count},
+                              {chunk->close,     count},
+                              {chunk->volume,    count}});
+        }
+        return result;
+    }
+
+    ColumnarSeriesOHLCV ConcurrentSeriesOHLCV::Snapshot::to_columnar() const {
+        ColumnarSeriesOHLCV series(m_storage ? m_storage->symbol : symbol_t{});
+        series.reserve(m_size);
+        for (size_t i = 0; i < m_size; ++i) {
+            series.insert(at(i));
+        }
+        return series;
+    }
+
+    json ConcurrentSeriesOHLCV::Snapshot::to_json() const {
+        json j;
+        for (size_t i = 0; i < m_size; ++i) {
+            j.push_back(at(i).to_json());
+        }
+        return j;
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator::iterator(const Snapshot *s, std::ptrdiff_t i) : snapshot(s),
+                                                                                                index(i) {}
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator &ConcurrentSeriesOHLCV::Snapshot::iterator::operator++() {
+        ++index;
+        return *this;
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator &ConcurrentSeriesOHLCV::Snapshot::iterator::operator--() {
+        --index;
+        return *this;
+    }
+
+    bool ConcurrentSeriesOHLCV::Snapshot::iterator::operator==(const iterator &other) const {
+        return index == other.index;
+    }
+
+    bool ConcurrentSeriesOHLCV::Snapshot::iterator::operator!=(const iterator &other) const {
+        return index != other.index;
+    }
+
+    std::pair<const timestamp_t, ConcurrentSeriesOHLCV::Bar>
+    ConcurrentSeriesOHLCV::Snapshot::iterator::operator*() const {
+        auto bar = snapshot->at(static_cast<size_t>(index));
+        return {bar.timestamp, bar};
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator ConcurrentSeriesOHLCV::Snapshot::begin() const {
+        return {this, 0};
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator ConcurrentSeriesOHLCV::Snapshot::end() const {
+        return {this, static_cast<std::ptrdiff_t>(m_size)};
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator ConcurrentSeriesOHLCV::Snapshot::rbegin() const {
+        return {this, static_cast<std::ptrdiff_t>(m_size) - 1};
+    }
+
+    ConcurrentSeriesOHLCV::Snapshot::iterator ConcurrentSeriesOHLCV::Snapshot::rend() const {
+        return {this, -1};
+    }
+
+}
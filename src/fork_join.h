@@ -0,0 +1,68 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Fork/join over a fixed number of threads, used by parallel_stable_sort, MarketDataStore and the alignment of
+// series.
+//
+
+#ifndef TRADING_COMMON_FORK_JOIN_H
+#define TRADING_COMMON_FORK_JOIN_H
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace trading::common {
+
+    // Threads to use for `work` independent items: the requested count, 0 for one per hardware thread, never
+    // more than the items and at least one
+    inline size_t worker_count(size_t requested, size_t work) {
+        if (requested == 0) {
+            requested = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        return std::max<size_t>(1, std::min(requested, work));
+    }
+
+    // Runs fn(worker) for worker in [0, workers), worker 0 on the calling thread, and returns when all are done.
+    // An exception thrown by a worker is kept until every thread has been joined, and the one of the lowest
+    // worker is then rethrown; the other workers still run to the end.
+    template<typename F>
+    void fork_join(size_t workers, F &&fn) {
+        std::vector<std::exception_ptr> errors(workers);
+        auto run = [&fn, &errors](size_t worker) {
+            try {
+                fn(worker);
+            } catch (...) {
+                errors[worker] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> pool;
+        std::exception_ptr failed_to_start;
+        try {
+            pool.reserve(workers > 0 ? workers - 1 : 0);
+            for (size_t worker = 1; worker < workers; ++worker) {
+                pool.emplace_back(run, worker);
+            }
+        } catch (...) {
+            // the threads already started are joined before this goes up
+            failed_to_start = std::current_exception();
+        }
+        if (!failed_to_start && workers > 0) {
+            run(0);
+        }
+        for (auto &thread: pool) {
+            thread.join();
+        }
+        if (failed_to_start) {
+            std::rethrow_exception(failed_to_start);
+        }
+        for (const auto &error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+#endif //TRADING_COMMON_FORK_JOIN_H
@@ -0,0 +1,134 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/heikin_ashi.h>
+
+#include <algorithm>
+
+namespace trading::common {
+
+    void heikin_ashi(const ColumnsOHLCV &in, std::span<double> open, std::span<double> high,
+                     std::span<double> low, std::span<double> close) {
+        const size_t n = in.size();
+        if (open.size() != n || high.size() != n || low.size() != n || close.size() != n) {
+            throw OHLCException("Heikin-Ashi output columns must have " + std::to_string(n) + " elements");
+        }
+        if (n == 0) {
+            return;
+        }
+        // the open is the only carried dependency; keeping it in registers instead of reloading it from the
+        // output leaves one add and one multiply per bar on the critical path
+        double previous_open = in.open[0];
+        double previous_close = (in.open[0] + in.high[0] + in.low[0] + in.close[0]) / 4;
+        for (size_t i = 0; i < n; ++i) {
+            double candle_close = (in.open[i] + in.high[i] + in.low[i] + in.close[i]) / 4;
+            double candle_open = i == 0 ? previous_open : (previous_open + previous_close) / 2;
+            high[i] = std::max(std::max(in.high[i], candle_open), candle_close);
+            low[i] = std::min(std::min(in.low[i], candle_open), candle_close);
+            open[i] = candle_open;
+            close[i] = candle_close;
+            previous_open = candle_open;
+            previous_close = candle_close;
+        }
+    }
+
+    ColumnarSeriesOHLCV heikin_ashi(const ColumnarSeriesOHLCV &series) {
+        const size_t n = series.size();
+        std::vector<double> open(n), high(n), low(n), close(n);
+        heikin_ashi(series.columns(), open, high, low, close);
+        auto timestamps = series.timestamps();
+        auto volumes = series.volume();
+        return {series.symbol(), std::vector<timestamp_t>(timestamps.begin(), timestamps.end()), std::move(open),
+                std::move(high), std::move(low), std::move(close),
+                std::vector<size_t>(volumes.begin(), volumes.end())};
+    }
+
+    HeikinAshiState::HeikinAshiState(const ColumnsOHLCV &candles) : m_count(candles.size()) {
+        auto candle = [&candles](size_t i) {
+            HeikinAshi result;
+            result.open = candles.open[i];
+            result.high = candles.high[i];
+            result.low = candles.low[i];
+            result.close = candles.close[i];
+            return result;
+        };
+        if (m_count > 0) {
+            m_last = candle(m_count - 1);
+        }
+        if (m_count > 1) {
+            m_previous = candle(m_count - 2);
+        }
+    }
+
+    const HeikinAshi &HeikinAshiState::update(const OHLC &bar) {
+        m_previous = m_last;
+        m_last = m_count == 0 ? HeikinAshi(bar) : HeikinAshi(bar, m_previous);
+        ++m_count;
+        return m_last;
+    }
+
+    const HeikinAshi &HeikinAshiState::revise(const OHLC &bar) {
+        if (m_count == 0) {
+            return update(bar);
+        }
+        m_last = m_count == 1 ? HeikinAshi(bar) : HeikinAshi(bar, m_previous);
+        return m_last;
+    }
+
+    const HeikinAshi &HeikinAshiState::update(const ColumnarSeriesOHLCV::Bar &bar) {
+        return update(OHLC(bar.open, bar.high, bar.low, bar.close));
+    }
+
+    const HeikinAshi &HeikinAshiState::revise(const ColumnarSeriesOHLCV::Bar &bar) {
+        return revise(OHLC(bar.open, bar.high, bar.low, bar.close));
+    }
+
+    void HeikinAshiState::reset() {
+        m_last = HeikinAshi();
+        m_previous = HeikinAshi();
+        m_count = 0;
+    }
+
+    HeikinAshiView::HeikinAshiView(const SeriesOHLCV &series) : m_series(series) {}
+
+    HeikinAshiView::iterator::iterator(SeriesOHLCV::iterator it, SeriesOHLCV::iterator end)
+            : m_iter(std::move(it)), m_end(std::move(end)) {
+        load(true);
+    }
+
+    void HeikinAshiView::iterator::load(bool first) {
+        if (!(m_iter != m_end)) {
+            return;
+        }
+        const auto &[timestamp, bar] = *m_iter;
+        m_current.first = timestamp;
+        m_current.second = first ? HeikinAshi(bar) : HeikinAshi(bar, m_current.second);
+    }
+
+    HeikinAshiView::iterator &HeikinAshiView::iterator::operator++() {
+        ++m_iter;
+        load(false);
+        return *this;
+    }
+
+    bool HeikinAshiView::iterator::operator!=(const iterator &other) const {
+        return m_iter != other.m_iter;
+    }
+
+    const std::pair<timestamp_t, HeikinAshi> &HeikinAshiView::iterator::operator*() const {
+        return m_current;
+    }
+
+    const std::pair<timestamp_t, HeikinAshi> *HeikinAshiView::iterator::operator->() const {
+        return &m_current;
+    }
+
+    HeikinAshiView::iterator HeikinAshiView::begin() const {
+        return {m_series.begin(), m_series.end()};
+    }
+
+    HeikinAshiView::iterator HeikinAshiView::end() const {
+        return {m_series.end(), m_series.end()};
+    }
+}
@@ -0,0 +1,153 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/id.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+
+namespace trading::common {
+
+    namespace {
+        constexpr int SEQUENCE_BITS = 16;
+        constexpr int BLOCK_BITS = 38;
+        constexpr uint64_t BLOCK_MASK = (uint64_t{1} << BLOCK_BITS) - 1;
+        constexpr uint64_t NODE_MASK = (uint64_t{1} << (64 - BLOCK_BITS - SEQUENCE_BITS)) - 1;
+
+        // 2024-01-01T00:00:00Z
+        constexpr int64_t BLOCK_EPOCH = 1704067200;
+
+        uint64_t first_block() {
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count() - BLOCK_EPOCH;
+            // never 0, so that node 0 never gives id 0
+            return seconds > 0 ? static_cast<uint64_t>(seconds) << 6 : 1;
+        }
+
+        // a function static, so that orders built during static initialization elsewhere find it ready
+        std::atomic<uint64_t> &next_block() {
+            static std::atomic<uint64_t> counter{first_block()};
+            return counter;
+        }
+
+        std::atomic<uint64_t> node_bits{0};
+
+        std::atomic<id_generator_t> generator{nullptr};
+
+        // The block of this thread: the next id and the end of the block
+        struct Block {
+            uint64_t next = 0;
+            uint64_t end = 0;
+        };
+
+        thread_local Block block;
+
+        size_t digits(uint64_t number) {
+            size_t count = 1;
+            while (number >= 10) {
+                number /= 10;
+                ++count;
+            }
+            return count;
+        }
+    }
+
+    Id Id::from_number(uint64_t number) {
+        Id id;
+        id.m_number = number;
+        return id;
+    }
+
+    size_t Id::size() const {
+        return m_number != 0 ? digits(m_number) : m_text.size();
+    }
+
+    char *Id::format(char *out) const {
+        if (m_number != 0) {
+            return std::to_chars(out, out + MAX_DIGITS, m_number).ptr;
+        }
+        return std::copy(m_text.begin(), m_text.end(), out);
+    }
+
+    std::string Id::str() const {
+        if (m_number == 0) {
+            return m_text;
+        }
+        char text[MAX_DIGITS];
+        return {text, format(text)};
+    }
+
+    void Id::assign(std::string_view text) {
+        m_number = 0;
+        m_text.assign(text);
+    }
+
+    bool Id::operator==(const Id &other) const {
+        if (m_number != 0 && other.m_number != 0) {
+            return m_number == other.m_number;
+        }
+        if (m_number == 0 && other.m_number == 0) {
+            return m_text == other.m_text;
+        }
+        const Id &number = m_number != 0 ? *this : other;
+        const Id &text = m_number != 0 ? other : *this;
+        char digits[MAX_DIGITS];
+        return std::string_view(digits, number.format(digits)) == text.m_text;
+    }
+
+    size_t Id::hash() const {
+        uint64_t number = m_number;
+        // the text of a number is its digits, without leading zeros, and fits in 64 bits
+        if (number == 0 && !m_text.empty() && m_text.front() != '0') {
+            auto [end, error] = std::from_chars(m_text.data(), m_text.data() + m_text.size(), number);
+            if (error != std::errc() || end != m_text.data() + m_text.size()) {
+                number = 0;
+            }
+        }
+        if (number != 0) {
+            return std::hash<uint64_t>{}(number);
+        }
+        return std::hash<std::string>{}(m_text);
+    }
+
+    void to_json(nlohmann::json &j, const Id &id) {
+        j = id.str();
+    }
+
+    void from_json(const nlohmann::json &j, Id &id) {
+        id.assign(j.get_ref<const std::string &>());
+    }
+
+    Id id_from_json(const nlohmann::json &object) {
+        auto found = object.find("id");
+        if (found != object.end() && found->is_string()) {
+            return found->get_ref<const std::string &>();
+        }
+        return generate_id();
+    }
+
+    Id generate_id() {
+        id_generator_t custom = generator.load(std::memory_order_acquire);
+        return custom != nullptr ? custom() : next_id();
+    }
+
+    void set_id_generator(id_generator_t custom) {
+        generator.store(custom, std::memory_order_release);
+    }
+
+    Id next_id() {
+        if (block.next == block.end) {
+            uint64_t number = next_block().fetch_add(1, std::memory_order_relaxed) & BLOCK_MASK;
+            block.next = node_bits.load(std::memory_order_relaxed) | number << SEQUENCE_BITS;
+            block.end = block.next + (uint64_t{1} << SEQUENCE_BITS);
+        }
+        return Id::from_number(block.next++);
+    }
+
+    void set_node_id(uint16_t node) {
+        node_bits.store((node & NODE_MASK) << (BLOCK_BITS + SEQUENCE_BITS), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,22 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Check of the window length, shared by the indicators and the rolling statistics.
+//
+
+#ifndef TRADING_COMMON_INDICATOR_PERIOD_H
+#define TRADING_COMMON_INDICATOR_PERIOD_H
+
+#include <trading_common/indicators.h>
+
+namespace trading::indicators {
+
+    // Throws IndicatorException for a period of 0
+    inline void check_period(size_t period) {
+        if (period == 0) {
+            throw IndicatorException("Indicator period must be greater than 0");
+        }
+    }
+}
+
+#endif //TRADING_COMMON_INDICATOR_PERIOD_H
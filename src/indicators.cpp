@@ -0,0 +1,291 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/indicators.h>
+#include "indicator_period.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trading::indicators {
+
+    SMA::SMA(size_t period) {
+        check_period(period);
+        m_window.resize(period);
+    }
+
+    void SMA::update(price_t value) {
+        const size_t period = m_window.size();
+        if (m_count >= period) {
+            price_t oldest = m_window[m_head];
+            m_sum -= oldest;
+            m_sum_squares -= oldest * oldest;
+        }
+        m_window[m_head] = value;
+        m_sum += value;
+        m_sum_squares += value * value;
+        ++m_count;
+        if (++m_head == period) {
+            m_head = 0;
+            // sums are rebuilt once per window so rounding errors do not pile up
+            m_sum = 0;
+            m_sum_squares = 0;
+            for (price_t v: m_window) {
+                m_sum += v;
+                m_sum_squares += v * v;
+            }
+        }
+    }
+
+    void SMA::revise(price_t value) {
+        if (m_count == 0) {
+            update(value);
+            return;
+        }
+        size_t last = (m_head == 0 ? m_window.size() : m_head) - 1;
+        price_t old = m_window[last];
+        m_window[last] = value;
+        m_sum += value - old;
+        m_sum_squares += value * value - old * old;
+    }
+
+    price_t SMA::value() const {
+        size_t n = std::min(m_count, m_window.size());
+        return n == 0 ? 0 : m_sum / static_cast<double>(n);
+    }
+
+    EMA::EMA(size_t period) : m_period(period), m_alpha(2.0 / (static_cast<double>(period) + 1)) {
+        check_period(period);
+    }
+
+    void EMA::apply(price_t value) {
+        ++m_state.count;
+        if (m_state.count <= m_period) {
+            // running mean, equal to the SMA seed once count reaches the period
+            m_state.value += (value - m_state.value) / static_cast<double>(m_state.count);
+        } else {
+            m_state.value += m_alpha * (value - m_state.value);
+        }
+    }
+
+    void EMA::update(price_t value) {
+        m_previous = m_state;
+        apply(value);
+    }
+
+    void EMA::revise(price_t value) {
+        if (m_state.count == 0) {
+            update(value);
+            return;
+        }
+        m_state = m_previous;
+        apply(value);
+    }
+
+    MACD::MACD(size_t fast, size_t slow, size_t signal) : m_fast(fast), m_slow(slow), m_signal(signal) {
+        if (fast >= slow) {
+            throw IndicatorException("MACD fast period must be shorter than the slow one");
+        }
+    }
+
+    void MACD::update(price_t value) {
+        m_fast.update(value);
+        m_slow.update(value);
+        if (m_slow.ready()) {
+            m_signal.update(this->value());
+        }
+    }
+
+    void MACD::revise(price_t value) {
+        // a revision does not change how many values were seen, so the signal took the last one iff slow is ready
+        m_fast.revise(value);
+        m_slow.revise(value);
+        if (m_slow.ready()) {
+            m_signal.revise(this->value());
+        }
+    }
+
+    RSI::RSI(size_t period) : m_period(period) {
+        check_period(period);
+    }
+
+    void RSI::apply(price_t value) {
+        if (m_state.count++ == 0) {
+            m_state.last = value;
+            return;
+        }
+        double change = value - m_state.last;
+        m_state.last = value;
+        double gain = std::max(change, 0.0);
+        double loss = std::max(-change, 0.0);
+        auto period = static_cast<double>(m_period);
+        if (m_state.count <= m_period + 1) {
+            // the first `period` changes are averaged plainly
+            m_state.gain += gain / period;
+            m_state.loss += loss / period;
+        } else {
+            m_state.gain = (m_state.gain * (period - 1) + gain) / period;
+            m_state.loss = (m_state.loss * (period - 1) + loss) / period;
+        }
+    }
+
+    void RSI::update(price_t value) {
+        m_previous = m_state;
+        apply(value);
+    }
+
+    void RSI::revise(price_t value) {
+        if (m_state.count == 0) {
+            update(value);
+            return;
+        }
+        m_state = m_previous;
+        apply(value);
+    }
+
+    double RSI::value() const {
+        if (m_state.loss == 0) {
+            return m_state.gain == 0 ? 50.0 : 100.0;
+        }
+        return 100.0 - 100.0 / (1.0 + m_state.gain / m_state.loss);
+    }
+
+    ATR::ATR(size_t period) : m_period(period) {
+        check_period(period);
+    }
+
+    void ATR::apply(const Bar &bar) {
+        double range = bar.high - bar.low;
+        if (m_state.count > 0) {
+            range = std::max({range, std::abs(bar.high - m_state.close), std::abs(bar.low - m_state.close)});
+        }
+        m_state.close = bar.close;
+        ++m_state.count;
+        if (m_state.count <= m_period) {
+            m_state.value += (range - m_state.value) / static_cast<double>(m_state.count);
+        } else {
+            auto period = static_cast<double>(m_period);
+            m_state.value = (m_state.value * (period - 1) + range) / period;
+        }
+    }
+
+    void ATR::update(const Bar &bar) {
+        m_previous = m_state;
+        apply(bar);
+    }
+
+    void ATR::revise(const Bar &bar) {
+        if (m_state.count == 0) {
+            update(bar);
+            return;
+        }
+        m_state = m_previous;
+        apply(bar);
+    }
+
+    Bollinger::Bollinger(size_t period, double width) : m_average(period), m_width(width) {}
+
+    double Bollinger::deviation() const {
+        size_t n = std::min(m_average.m_count, m_average.m_window.size());
+        if (n == 0) {
+            return 0;
+        }
+        double mean = m_average.m_sum / static_cast<double>(n);
+        double variance = m_average.m_sum_squares / static_cast<double>(n) - mean * mean;
+        if (variance <= 0) {
+            return 0;
+        }
+        // E[x^2] - E[x]^2 cancels badly when the spread is tiny next to the price, fall back to a direct pass
+        if (variance < 1e-9 * mean * mean) {
+            variance = 0;
+            for (size_t i = 0; i < n; ++i) {
+                double d = m_average.m_window[i] - mean;
+                variance += d * d;
+            }
+            variance /= static_cast<double>(n);
+        }
+        return std::sqrt(variance);
+    }
+
+    template<typename T, typename... Args>
+    size_t IndicatorEngine::add(std::vector<T> &indicators, Args... args) {
+        indicators.emplace_back(args...);
+        return indicators.size() - 1;
+    }
+
+    size_t IndicatorEngine::add_sma(size_t period) {
+        return add(m_sma, period);
+    }
+
+    size_t IndicatorEngine::add_ema(size_t period) {
+        return add(m_ema, period);
+    }
+
+    size_t IndicatorEngine::add_macd(size_t fast, size_t slow, size_t signal) {
+        return add(m_macd, fast, slow, signal);
+    }
+
+    size_t IndicatorEngine::add_rsi(size_t period) {
+        return add(m_rsi, period);
+    }
+
+    size_t IndicatorEngine::add_atr(size_t period) {
+        return add(m_atr, period);
+    }
+
+    size_t IndicatorEngine::add_bollinger(size_t period, double width) {
+        return add(m_bollinger, period, width);
+    }
+
+    bool IndicatorEngine::on_bar(const Bar &bar) {
+        if (m_count > 0 && bar.timestamp <= m_last) {
+            if (bar.timestamp < m_last) {
+                return false;
+            }
+            for (auto &indicator: m_sma) indicator.revise(bar);
+            for (auto &indicator: m_ema) indicator.revise(bar);
+            for (auto &indicator: m_macd) indicator.revise(bar);
+            for (auto &indicator: m_rsi) indicator.revise(bar);
+            for (auto &indicator: m_atr) indicator.revise(bar);
+            for (auto &indicator: m_bollinger) indicator.revise(bar);
+            return true;
+        }
+        for (auto &indicator: m_sma) indicator.update(bar);
+        for (auto &indicator: m_ema) indicator.update(bar);
+        for (auto &indicator: m_macd) indicator.update(bar);
+        for (auto &indicator: m_rsi) indicator.update(bar);
+        for (auto &indicator: m_atr) indicator.update(bar);
+        for (auto &indicator: m_bollinger) indicator.update(bar);
+        m_last = bar.timestamp;
+        ++m_count;
+        return true;
+    }
+
+    void IndicatorEngine::replay(const trading::common::ColumnsOHLCV &columns) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            on_bar({columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i], columns.close[i],
+                    columns.volume[i]});
+        }
+    }
+
+    void IndicatorEngine::replay(const trading::common::ColumnarSeriesOHLCV &series) {
+        replay(series.columns());
+    }
+
+    void IndicatorEngine::replay(const trading::common::SeriesOHLCV &series) {
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            const auto &[timestamp, ohlc] = *it;
+            on_bar({timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+        }
+    }
+
+    trading::common::BarAggregator::callback_t IndicatorEngine::callback(timestamp_t timeframe) {
+        return [this, timeframe](timestamp_t bar_timeframe, const Bar &bar) {
+            if (bar_timeframe == timeframe) {
+                on_bar(bar);
+            }
+        };
+    }
+
+}
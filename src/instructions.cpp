@@ -5,19 +5,19 @@
 
 namespace trading::instructions {
 
-    type_t get_type_name(Type type) {
-        return TypeNames.at(type);
+    std::string_view get_type_name(Type type) {
+        return TypeNames.name(type);
     }
 
-    Type get_type_from_string(const type_t &type){
-        return ::common::find_key_from_value(TypeNames, type, Type::NONE);
+    Type get_type_from_string(std::string_view type) {
+        return TypeNames.parse(type, Type::NONE);
     }
 
-    selector_t get_selector_name(Selector selector) {
-        return SelectorNames.at(selector);
+    std::string_view get_selector_name(Selector selector) {
+        return SelectorNames.name(selector);
     }
 
-    Selector get_selector_from_string(const selector_t &selector){
-        return ::common::find_key_from_value(SelectorNames, selector, Selector::NONE);
+    Selector get_selector_from_string(std::string_view selector) {
+        return SelectorNames.parse(selector, Selector::NONE);
     }
 }
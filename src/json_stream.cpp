@@ -0,0 +1,206 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/json_stream.h>
+
+#include <fstream>
+
+namespace trading::common {
+
+    namespace {
+
+        enum Field : unsigned {
+            TIMESTAMP = 0, OPEN, HIGH, LOW, CLOSE, VOLUME, UNKNOWN
+        };
+
+        constexpr unsigned ALL_FIELDS = (1u << UNKNOWN) - 1;
+
+        Field field_from_key(const std::string &key) {
+            switch (key.size()) {
+                case 3:
+                    return key == "low" ? LOW : UNKNOWN;
+                case 4:
+                    if (key == "open") return OPEN;
+                    return key == "high" ? HIGH : UNKNOWN;
+                case 5:
+                    return key == "close" ? CLOSE : UNKNOWN;
+                case 6:
+                    return key == "volume" ? VOLUME : UNKNOWN;
+                case 9:
+                    return key == "timestamp" ? TIMESTAMP : UNKNOWN;
+                default:
+                    return UNKNOWN;
+            }
+        }
+
+        // Handler for nlohmann::json::sax_parse. Depth 1 is the top level array, depth 2 one bar object;
+        // anything nested deeper belongs to an unknown key and is ignored.
+        template<typename Sink>
+        class BarSaxHandler {
+        private:
+            Sink &m_sink;
+            size_t m_depth = 0;
+            size_t m_count = 0;
+            Field m_field = UNKNOWN;
+            unsigned m_seen = 0;
+            ColumnarSeriesOHLCV::Bar m_bar{};
+
+            template<typename T>
+            bool value(T v) {
+                if (m_depth != 2) {
+                    return m_depth > 2 || fail("unexpected value outside a bar object");
+                }
+                switch (m_field) {
+                    case TIMESTAMP:
+                        m_bar.timestamp = static_cast<timestamp_t>(v);
+                        break;
+                    case OPEN:
+                        m_bar.open = static_cast<double>(v);
+                        break;
+                    case HIGH:
+                        m_bar.high = static_cast<double>(v);
+                        break;
+                    case LOW:
+                        m_bar.low = static_cast<double>(v);
+                        break;
+                    case CLOSE:
+                        m_bar.close = static_cast<double>(v);
+                        break;
+                    case VOLUME:
+                        m_bar.volume = static_cast<size_t>(v);
+                        break;
+                    default:
+                        return true;
+                }
+                m_seen |= 1u << m_field;
+                return true;
+            }
+
+            bool other() {
+                if (m_depth == 2 && m_field != UNKNOWN) {
+                    return fail("bar field is not a number");
+                }
+                return m_depth >= 2 || fail("unexpected value outside a bar object");
+            }
+
+            static bool fail(const std::string &message) {
+                throw OHLCException("Error parsing OHLC json: " + message);
+            }
+
+        public:
+            explicit BarSaxHandler(Sink &sink) : m_sink(sink) {}
+
+            [[nodiscard]] size_t count() const { return m_count; }
+
+            // a top level null is what SeriesOHLCV::to_json() produces for an empty series
+            bool null() { return m_depth == 0 || other(); }
+
+            bool boolean(bool) { return other(); }
+
+            bool number_integer(json::number_integer_t v) { return value(v); }
+
+            bool number_unsigned(json::number_unsigned_t v) { return value(v); }
+
+            bool number_float(json::number_float_t v, const json::string_t &) { return value(v); }
+
+            bool string(json::string_t &) { return other(); }
+
+            bool binary(json::binary_t &) { return other(); }
+
+            bool start_object(std::size_t) {
+                if (m_depth == 1) {
+                    m_seen = 0;
+                    m_field = UNKNOWN;
+                } else if (m_depth == 0) {
+                    return fail("expected an array of bars");
+                } else if (m_depth == 2 && m_field != UNKNOWN) {
+                    return fail("bar field is not a number");
+                }
+                ++m_depth;
+                return true;
+            }
+
+            bool key(json::string_t &key) {
+                if (m_depth == 2) {
+                    m_field = field_from_key(key);
+                }
+                return true;
+            }
+
+            bool end_object() {
+                if (--m_depth == 1) {
+                    if (m_seen != ALL_FIELDS) {
+                        return fail("bar " + std::to_string(m_count) + " is missing fields");
+                    }
+                    m_sink(m_bar);
+                    ++m_count;
+                }
+                return true;
+            }
+
+            bool start_array(std::size_t) {
+                if (m_depth == 1) {
+                    return fail("expected a bar object");
+                } else if (m_depth == 2 && m_field != UNKNOWN) {
+                    return fail("bar field is not a number");
+                }
+                ++m_depth;
+                return true;
+            }
+
+            bool end_array() {
+                --m_depth;
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &e) {
+                return fail(e.what());
+            }
+        };
+
+        template<typename Input, typename Sink>
+        size_t parse(Input &&input, Sink &sink) {
+            BarSaxHandler<Sink> handler(sink);
+            json::sax_parse(std::forward<Input>(input), &handler);
+            return handler.count();
+        }
+
+        std::ifstream open_file(const std::string &path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                throw OHLCException("Cannot open json file: " + path);
+            }
+            return in;
+        }
+
+        auto columnar_sink(ColumnarSeriesOHLCV &series) {
+            return [&series](const ColumnarSeriesOHLCV::Bar &bar) { series.insert(bar); };
+        }
+    }
+
+    size_t load_json(std::istream &in, const bar_callback_t &callback) {
+        return parse(in, callback);
+    }
+
+    size_t load_json(std::istream &in, ColumnarSeriesOHLCV &series) {
+        auto sink = columnar_sink(series);
+        return parse(in, sink);
+    }
+
+    size_t load_json(std::istream &in, SeriesOHLCV &series, const symbol_t &symbol) {
+        auto sink = [&](const ColumnarSeriesOHLCV::Bar &bar) { series.insert(bar.to_ohlcv(symbol)); };
+        return parse(in, sink);
+    }
+
+    size_t load_json_file(const std::string &path, const bar_callback_t &callback) {
+        auto in = open_file(path);
+        return load_json(in, callback);
+    }
+
+    size_t load_json_file(const std::string &path, ColumnarSeriesOHLCV &series) {
+        auto in = open_file(path);
+        return load_json(in, series);
+    }
+
+}
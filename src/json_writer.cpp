@@ -0,0 +1,219 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/json_writer.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace trading::common {
+
+    namespace {
+        // Escape of a character that json does not copy as it is, or nullptr
+        const char *escape(unsigned char c) {
+            switch (c) {
+                case '"':
+                    return "\\\"";
+                case '\\':
+                    return "\\\\";
+                case '\b':
+                    return "\\b";
+                case '\f':
+                    return "\\f";
+                case '\n':
+                    return "\\n";
+                case '\r':
+                    return "\\r";
+                case '\t':
+                    return "\\t";
+                default:
+                    return nullptr;
+            }
+        }
+
+        bool needs_escape(unsigned char c) {
+            return c < 0x20 || c == '"' || c == '\\';
+        }
+    }
+
+    JsonWriter::JsonWriter(size_t capacity) : m_buffer(capacity, '\0') {}
+
+    char *JsonWriter::reserve(size_t count) {
+        if (m_buffer.size() - m_size < count) {
+            m_buffer.resize(std::max(2 * m_buffer.size(), m_size + count));
+        }
+        return m_buffer.data() + m_size;
+    }
+
+    void JsonWriter::raw(std::string_view text) {
+        std::memcpy(reserve(text.size()), text.data(), text.size());
+        m_size += text.size();
+    }
+
+    void JsonWriter::string(std::string_view text) {
+        // the worst case is every character written as \u00XX
+        char *out = reserve(6 * text.size() + 2);
+        char *first = out;
+        *out++ = '"';
+        size_t run = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            auto c = static_cast<unsigned char>(text[i]);
+            if (!needs_escape(c)) {
+                continue;
+            }
+            std::memcpy(out, text.data() + run, i - run);
+            out += i - run;
+            run = i + 1;
+            if (const char *sequence = escape(c)) {
+                *out++ = sequence[0];
+                *out++ = sequence[1];
+            } else {
+                static constexpr char HEX[] = "0123456789abcdef";
+                std::memcpy(out, "\\u00", 4);
+                out[4] = HEX[c >> 4];
+                out[5] = HEX[c & 0xf];
+                out += 6;
+            }
+        }
+        std::memcpy(out, text.data() + run, text.size() - run);
+        out += text.size() - run;
+        *out++ = '"';
+        m_size += out - first;
+    }
+
+    void JsonWriter::number(double value) {
+        if (!std::isfinite(value)) {
+            raw("null");
+            return;
+        }
+        // json's own conversion: std::to_chars gives the shortest digits, which json's Grisu2 now and then
+        // misses by one, so it would not match dump()
+        char *first = reserve(32);
+        m_size += nlohmann::detail::to_chars(first, first + 32, value) - first;
+    }
+
+    void JsonWriter::write(const Id &id) {
+        if (!id.is_number()) {
+            string(id.text());
+            return;
+        }
+        char *first = reserve(Id::MAX_DIGITS + 2);
+        *first = '"';
+        char *last = id.format(first + 1);
+        *last++ = '"';
+        m_size += last - first;
+    }
+
+    void JsonWriter::write(const OHLCV &ohlcv) {
+        raw("{\"close\":");
+        number(ohlcv.close);
+        raw(",\"high\":");
+        number(ohlcv.high);
+        raw(",\"low\":");
+        number(ohlcv.low);
+        raw(",\"open\":");
+        number(ohlcv.open);
+        raw(",\"timestamp\":");
+        number(ohlcv.timestamp);
+        raw(",\"volume\":");
+        number(ohlcv.volume);
+        raw("}");
+    }
+
+    void JsonWriter::write(const SeriesOHLCV &series) {
+        size_t start = m_size;
+        for (const auto &item: series) {
+            raw(m_size == start ? "[" : ",");
+            write(item.second);
+        }
+        raw(m_size == start ? "null" : "]");
+    }
+
+    void JsonWriter::write(const ColumnarSeriesOHLCV::Bar &bar) {
+        raw("{\"close\":");
+        number(bar.close);
+        raw(",\"high\":");
+        number(bar.high);
+        raw(",\"low\":");
+        number(bar.low);
+        raw(",\"open\":");
+        number(bar.open);
+        raw(",\"timestamp\":");
+        number(bar.timestamp);
+        raw(",\"volume\":");
+        number(bar.volume);
+        raw("}");
+    }
+
+    void JsonWriter::write(const ColumnarSeriesOHLCV &series) {
+        ColumnsOHLCV columns = series.columns();
+        if (columns.empty()) {
+            raw("null");
+            return;
+        }
+        for (size_t i = 0; i < columns.size(); ++i) {
+            raw(i == 0 ? "[" : ",");
+            write(ColumnarSeriesOHLCV::Bar{columns.timestamp[i], columns.open[i], columns.high[i], columns.low[i],
+                                           columns.close[i], columns.volume[i]});
+        }
+        raw("]");
+    }
+
+    template<typename P>
+    void JsonWriter::write(const trading::order::BasicOrder<P> &order) {
+        raw("{\"filled\":");
+        number(order.filled);
+        raw(",\"filled_at_price\":");
+        number(price_to_double(order.filled_at_price));
+        raw(",\"id\":");
+        write(order.id);
+        raw(",\"limit_price\":");
+        number(price_to_double(order.limit_price));
+        raw(",\"quantity\":");
+        number(order.quantity);
+        raw(",\"side\":");
+        string(trading::order::SideNames.name(order.side));
+        raw(",\"status\":");
+        string(trading::order::StatusNames.name(order.status));
+        raw(",\"symbol\":");
+        string(*order.symbol);
+        raw(",\"timestamp\":");
+        number(order.timestamp);
+        raw(",\"type\":");
+        string(trading::order::TypeNames.name(order.type));
+        raw("}");
+    }
+
+    template<typename P>
+    void JsonWriter::write(const trading::position::BasicPosition<P> &position) {
+        raw("{\"balance\":");
+        number(position.balance);
+        raw(",\"current_price\":");
+        number(price_to_double(position.current_price));
+        raw(",\"entry_price\":");
+        number(price_to_double(position.entry_price));
+        raw(",\"id\":");
+        write(position.id);
+        raw(",\"pnl\":");
+        number(price_to_double(position.pnl));
+        raw(",\"side\":");
+        string(trading::position::SideNames.name(position.side));
+        raw(",\"symbol\":");
+        string(*position.symbol);
+        raw(",\"timestamp\":");
+        number(position.timestamp);
+        raw("}");
+    }
+
+#define TRADING_COMMON_JSON_WRITER_INSTANTIATE(P)                                                              \
+    template void JsonWriter::write(const trading::order::BasicOrder<P> &);                                    \
+    template void JsonWriter::write(const trading::position::BasicPosition<P> &);
+
+    TRADING_COMMON_JSON_WRITER_INSTANTIATE(price_t)
+    TRADING_COMMON_JSON_WRITER_INSTANTIATE(FixedPrice<2>)
+    TRADING_COMMON_JSON_WRITER_INSTANTIATE(FixedPrice<4>)
+    TRADING_COMMON_JSON_WRITER_INSTANTIATE(FixedPrice<8>)
+
+#undef TRADING_COMMON_JSON_WRITER_INSTANTIATE
+}
@@ -0,0 +1,270 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/kernels.h>
+#include "kernels_isa.h"
+#include "kernels_simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace trading::kernels {
+
+    namespace {
+        struct Scalar {
+            static constexpr size_t WIDTH = 1;
+            using vec = double;
+
+            static vec load(const double *p) { return *p; }
+
+            static void store(double *p, vec v) { *p = v; }
+
+            static vec set1(double v) { return v; }
+
+            static vec add(vec a, vec b) { return a + b; }
+
+            static vec sub(vec a, vec b) { return a - b; }
+
+            static vec mul(vec a, vec b) { return a * b; }
+
+            static vec div(vec a, vec b) { return a / b; }
+
+            static vec max(vec a, vec b) { return a > b ? a : b; }
+
+            static vec min(vec a, vec b) { return a < b ? a : b; }
+
+            static vec abs(vec a) { return std::fabs(a); }
+
+            static vec log(vec a) { return std::log(a); }
+        };
+    }
+
+    namespace scalar {
+        void rolling_sum(const double *in, size_t n, size_t window, double scale, double *out) {
+            rolling_sum_impl<Scalar>(in, n, window, scale, out);
+        }
+
+        void rolling_max_combine(const double *suffix, size_t n, size_t window, double *out) {
+            rolling_extreme_combine_impl<Scalar, true>(suffix, n, window, out);
+        }
+
+        void rolling_min_combine(const double *suffix, size_t n, size_t window, double *out) {
+            rolling_extreme_combine_impl<Scalar, false>(suffix, n, window, out);
+        }
+
+        void rolling_max_direct(const double *in, size_t n, size_t window, double *out) {
+            rolling_extreme_direct_impl<Scalar, true>(in, n, window, out);
+        }
+
+        void rolling_min_direct(const double *in, size_t n, size_t window, double *out) {
+            rolling_extreme_direct_impl<Scalar, false>(in, n, window, out);
+        }
+
+        void true_range(const double *high, const double *low, const double *close, size_t n, double *out) {
+            true_range_impl<Scalar>(high, low, close, n, out);
+        }
+
+        void returns(const double *in, size_t n, double *out) {
+            returns_impl<Scalar, false>(in, n, out);
+        }
+
+        void log_returns(const double *in, size_t n, double *out) {
+            returns_impl<Scalar, true>(in, n, out);
+        }
+    }
+
+#if !defined(TRADING_COMMON_X86_KERNELS)
+    namespace avx2 = scalar;
+    namespace avx512 = scalar;
+#endif
+
+    namespace {
+        Isa detect_isa() {
+#if defined(TRADING_COMMON_X86_KERNELS)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return Isa::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return Isa::AVX2;
+            }
+#endif
+            return Isa::SCALAR;
+        }
+
+        std::atomic<Isa> &current_isa() {
+            static std::atomic<Isa> isa{supported_isa()};
+            return isa;
+        }
+
+        template<typename F>
+        F select(F scalar_kernel, F avx2_kernel, F avx512_kernel) {
+            switch (active_isa()) {
+                case Isa::AVX512:
+                    return avx512_kernel;
+                case Isa::AVX2:
+                    return avx2_kernel;
+                default:
+                    return scalar_kernel;
+            }
+        }
+
+        void check_size(size_t in, size_t out, const char *kernel) {
+            if (in != out) {
+                throw KernelException(std::string(kernel) + ": output has " + std::to_string(out)
+                                      + " elements, input " + std::to_string(in));
+            }
+        }
+
+        void check_window(size_t window, const char *kernel) {
+            if (window == 0) {
+                throw KernelException(std::string(kernel) + ": window must be greater than 0");
+            }
+        }
+
+        // windows up to this many vectors long go through the direct kernel, longer ones through van Herk
+        constexpr size_t DIRECT_WINDOW_VECTORS = 8;
+
+        size_t isa_width(Isa isa) {
+            switch (isa) {
+                case Isa::AVX512:
+                    return 8;
+                case Isa::AVX2:
+                    return 4;
+                default:
+                    return 1;
+            }
+        }
+
+        template<bool MAX>
+        void rolling_extreme_blocks(std::span<const double> in, size_t window, std::span<double> out) {
+            const size_t n = in.size();
+            // out gets the extreme from each block start, suffix the one to each block end; both scans run in
+            // the same loop so their dependency chains overlap
+            std::vector<double> suffix(n);
+            for (size_t block = 0; block < n; block += window) {
+                const size_t end = std::min(block + window, n);
+                out[block] = in[block];
+                suffix[end - 1] = in[end - 1];
+                for (size_t i = block + 1, j = end - 1; i < end; ++i, --j) {
+                    out[i] = MAX ? std::max(out[i - 1], in[i]) : std::min(out[i - 1], in[i]);
+                    suffix[j - 1] = MAX ? std::max(suffix[j], in[j - 1]) : std::min(suffix[j], in[j - 1]);
+                }
+            }
+            if (n >= window) {
+                auto combine = MAX ? select(scalar::rolling_max_combine, avx2::rolling_max_combine,
+                                            avx512::rolling_max_combine)
+                                   : select(scalar::rolling_min_combine, avx2::rolling_min_combine,
+                                            avx512::rolling_min_combine);
+                combine(suffix.data(), n, window, out.data());
+            }
+        }
+
+        template<bool MAX>
+        void rolling_extreme(std::span<const double> in, size_t window, std::span<double> out, const char *kernel) {
+            check_size(in.size(), out.size(), kernel);
+            check_window(window, kernel);
+            const size_t n = in.size();
+            if (n >= window && window <= DIRECT_WINDOW_VECTORS * isa_width(active_isa())) {
+                auto direct = MAX ? select(scalar::rolling_max_direct, avx2::rolling_max_direct,
+                                           avx512::rolling_max_direct)
+                                  : select(scalar::rolling_min_direct, avx2::rolling_min_direct,
+                                           avx512::rolling_min_direct);
+                direct(in.data(), n, window, out.data());
+            } else {
+                rolling_extreme_blocks<MAX>(in, window, out);
+            }
+            std::fill(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min(window - 1, n)),
+                      std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+
+    Isa supported_isa() {
+        static const Isa isa = detect_isa();
+        return isa;
+    }
+
+    Isa active_isa() {
+        return current_isa().load(std::memory_order_relaxed);
+    }
+
+    Isa set_isa(Isa isa) {
+        isa = std::min(isa, supported_isa());
+        current_isa().store(isa, std::memory_order_relaxed);
+        return isa;
+    }
+
+    const char *isa_name(Isa isa) {
+        switch (isa) {
+            case Isa::AVX512:
+                return "avx512";
+            case Isa::AVX2:
+                return "avx2";
+            default:
+                return "scalar";
+        }
+    }
+
+    void rolling_sum(std::span<const double> in, size_t window, std::span<double> out) {
+        check_size(in.size(), out.size(), "rolling_sum");
+        check_window(window, "rolling_sum");
+        select(scalar::rolling_sum, avx2::rolling_sum, avx512::rolling_sum)(in.data(), in.size(), window, 1.0,
+                                                                            out.data());
+    }
+
+    void rolling_mean(std::span<const double> in, size_t window, std::span<double> out) {
+        check_size(in.size(), out.size(), "rolling_mean");
+        check_window(window, "rolling_mean");
+        select(scalar::rolling_sum, avx2::rolling_sum, avx512::rolling_sum)(
+                in.data(), in.size(), window, 1.0 / static_cast<double>(window), out.data());
+    }
+
+    void ema(std::span<const double> in, size_t period, std::span<double> out) {
+        check_size(in.size(), out.size(), "ema");
+        check_window(period, "ema");
+        const double alpha = 2.0 / (static_cast<double>(period) + 1);
+        double value = 0;
+        for (size_t i = 0; i < in.size(); ++i) {
+            if (i < period) {
+                // running mean, the same seed as indicators::EMA
+                value += (in[i] - value) / static_cast<double>(i + 1);
+                out[i] = i + 1 < period ? std::numeric_limits<double>::quiet_NaN() : value;
+            } else {
+                value += alpha * (in[i] - value);
+                out[i] = value;
+            }
+        }
+    }
+
+    void rolling_max(std::span<const double> in, size_t window, std::span<double> out) {
+        rolling_extreme<true>(in, window, out, "rolling_max");
+    }
+
+    void rolling_min(std::span<const double> in, size_t window, std::span<double> out) {
+        rolling_extreme<false>(in, window, out, "rolling_min");
+    }
+
+    void true_range(std::span<const double> high, std::span<const double> low, std::span<const double> close,
+                    std::span<double> out) {
+        check_size(high.size(), low.size(), "true_range");
+        check_size(high.size(), close.size(), "true_range");
+        check_size(high.size(), out.size(), "true_range");
+        select(scalar::true_range, avx2::true_range, avx512::true_range)(high.data(), low.data(), close.data(),
+                                                                         high.size(), out.data());
+    }
+
+    void returns(std::span<const double> in, std::span<double> out) {
+        check_size(in.size(), out.size(), "returns");
+        select(scalar::returns, avx2::returns, avx512::returns)(in.data(), in.size(), out.data());
+    }
+
+    void log_returns(std::span<const double> in, std::span<double> out) {
+        check_size(in.size(), out.size(), "log_returns");
+        select(scalar::log_returns, avx2::log_returns, avx512::log_returns)(in.data(), in.size(), out.data());
+    }
+
+}
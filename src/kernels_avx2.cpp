@@ -0,0 +1,114 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Built with -mavx2 -mfma and only called after kernels.cpp has checked the CPU supports both.
+//
+
+#include "kernels_isa.h"
+#include "kernels_simd.h"
+
+#include <immintrin.h>
+
+namespace trading::kernels::avx2 {
+
+    namespace {
+        struct Avx2 {
+            static constexpr size_t WIDTH = 4;
+            using vec = __m256d;
+
+            static vec load(const double *p) { return _mm256_loadu_pd(p); }
+
+            static void store(double *p, vec v) { _mm256_storeu_pd(p, v); }
+
+            static vec set1(double v) { return _mm256_set1_pd(v); }
+
+            static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+
+            static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+
+            static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+
+            static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+
+            static vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+
+            static vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+
+            static vec abs(vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+            // Natural log of positive normal numbers: x = 2^e * m with m in [sqrt(1/2), sqrt(2)) and
+            // log(m) = 2 atanh(s), s = (m - 1) / (m + 1), from its series up to s^17. Lanes out of that
+            // range (zero, negative, subnormal, inf, NaN) make the whole vector go through libm.
+            static vec log(vec x) {
+                const vec valid = _mm256_and_pd(_mm256_cmp_pd(x, set1(0x1p-1022), _CMP_GE_OQ),
+                                                _mm256_cmp_pd(x, set1(0x1.fffffffffffffp+1023), _CMP_LE_OQ));
+                if (_mm256_movemask_pd(valid) != 0xF) {
+                    alignas(32) double lanes[WIDTH];
+                    _mm256_store_pd(lanes, x);
+                    for (double &lane: lanes) {
+                        lane = __builtin_log(lane);
+                    }
+                    return _mm256_load_pd(lanes);
+                }
+                const __m256i bits = _mm256_castpd_si256(x);
+                // 2^52 + biased exponent, read back as a double and unbiased
+                vec exponent = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52),
+                                                                   _mm256_set1_epi64x(0x4330000000000000)));
+                exponent = sub(exponent, set1(0x1p52 + 1023));
+                vec mantissa = _mm256_castsi256_pd(
+                        _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)),
+                                        _mm256_set1_epi64x(0x3FF0000000000000)));
+                const vec large = _mm256_cmp_pd(mantissa, set1(1.4142135623730951), _CMP_GT_OQ);
+                mantissa = _mm256_blendv_pd(mantissa, mul(mantissa, set1(0.5)), large);
+                exponent = add(exponent, _mm256_and_pd(large, set1(1.0)));
+
+                const vec one = set1(1.0);
+                const vec s = div(sub(mantissa, one), add(mantissa, one));
+                const vec z = mul(s, s);
+                vec poly = set1(2.0 / 17);
+                static constexpr double COEFFICIENTS[] = {2.0 / 15, 2.0 / 13, 2.0 / 11, 2.0 / 9, 2.0 / 7, 2.0 / 5,
+                                                          2.0 / 3, 2.0};
+                for (double c: COEFFICIENTS) {
+                    poly = _mm256_fmadd_pd(poly, z, set1(c));
+                }
+                const vec log_mantissa = mul(s, poly);
+                // ln 2 split in a high part exact for any exponent and a low correction
+                return _mm256_fmadd_pd(exponent, set1(6.93147180369123816490e-01),
+                                       _mm256_fmadd_pd(exponent, set1(1.90821492927058770002e-10), log_mantissa));
+            }
+        };
+    }
+
+    void rolling_sum(const double *in, size_t n, size_t window, double scale, double *out) {
+        rolling_sum_impl<Avx2>(in, n, window, scale, out);
+    }
+
+    void rolling_max_combine(const double *suffix, size_t n, size_t window, double *out) {
+        rolling_extreme_combine_impl<Avx2, true>(suffix, n, window, out);
+    }
+
+    void rolling_min_combine(const double *suffix, size_t n, size_t window, double *out) {
+        rolling_extreme_combine_impl<Avx2, false>(suffix, n, window, out);
+    }
+
+    void rolling_max_direct(const double *in, size_t n, size_t window, double *out) {
+        rolling_extreme_direct_impl<Avx2, true>(in, n, window, out);
+    }
+
+    void rolling_min_direct(const double *in, size_t n, size_t window, double *out) {
+        rolling_extreme_direct_impl<Avx2, false>(in, n, window, out);
+    }
+
+    void true_range(const double *high, const double *low, const double *close, size_t n, double *out) {
+        true_range_impl<Avx2>(high, low, close, n, out);
+    }
+
+    void returns(const double *in, size_t n, double *out) {
+        returns_impl<Avx2, false>(in, n, out);
+    }
+
+    void log_returns(const double *in, size_t n, double *out) {
+        returns_impl<Avx2, true>(in, n, out);
+    }
+
+}
@@ -0,0 +1,112 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Built with -mavx512f and only called after kernels.cpp has checked the CPU supports it.
+//
+
+#include "kernels_isa.h"
+#include "kernels_simd.h"
+
+#include <immintrin.h>
+
+namespace trading::kernels::avx512 {
+
+    namespace {
+        struct Avx512 {
+            static constexpr size_t WIDTH = 8;
+            using vec = __m512d;
+
+            static vec load(const double *p) { return _mm512_loadu_pd(p); }
+
+            static void store(double *p, vec v) { _mm512_storeu_pd(p, v); }
+
+            static vec set1(double v) { return _mm512_set1_pd(v); }
+
+            static vec add(vec a, vec b) { return _mm512_add_pd(a, b); }
+
+            static vec sub(vec a, vec b) { return _mm512_sub_pd(a, b); }
+
+            static vec mul(vec a, vec b) { return _mm512_mul_pd(a, b); }
+
+            static vec div(vec a, vec b) { return _mm512_div_pd(a, b); }
+
+            // The masked forms with every lane selected: GCC 12's unmasked ones pass an uninitialized
+            // placeholder as the source and warn with -Wmaybe-uninitialized once inlined
+            static vec max(vec a, vec b) { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+
+            static vec min(vec a, vec b) { return _mm512_mask_min_pd(a, 0xFF, a, b); }
+
+            static vec abs(vec a) { return _mm512_abs_pd(a); }
+
+            // Same reduction as the AVX2 one in kernels_avx2.cpp, with mask registers for the selects
+            static vec log(vec x) {
+                const __mmask8 valid = _mm512_cmp_pd_mask(x, set1(0x1p-1022), _CMP_GE_OQ)
+                                       & _mm512_cmp_pd_mask(x, set1(0x1.fffffffffffffp+1023), _CMP_LE_OQ);
+                if (valid != 0xFF) {
+                    alignas(64) double lanes[WIDTH];
+                    _mm512_store_pd(lanes, x);
+                    for (double &lane: lanes) {
+                        lane = __builtin_log(lane);
+                    }
+                    return _mm512_load_pd(lanes);
+                }
+                const __m512i bits = _mm512_castpd_si512(x);
+                const __m512i biased = _mm512_mask_srli_epi64(bits, 0xFF, bits, 52);
+                vec exponent = _mm512_castsi512_pd(_mm512_or_si512(biased, _mm512_set1_epi64(0x4330000000000000)));
+                exponent = sub(exponent, set1(0x1p52 + 1023));
+                vec mantissa = _mm512_castsi512_pd(
+                        _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFF)),
+                                        _mm512_set1_epi64(0x3FF0000000000000)));
+                const __mmask8 large = _mm512_cmp_pd_mask(mantissa, set1(1.4142135623730951), _CMP_GT_OQ);
+                mantissa = _mm512_mask_mul_pd(mantissa, large, mantissa, set1(0.5));
+                exponent = _mm512_mask_add_pd(exponent, large, exponent, set1(1.0));
+
+                const vec one = set1(1.0);
+                const vec s = div(sub(mantissa, one), add(mantissa, one));
+                const vec z = mul(s, s);
+                vec poly = set1(2.0 / 17);
+                static constexpr double COEFFICIENTS[] = {2.0 / 15, 2.0 / 13, 2.0 / 11, 2.0 / 9, 2.0 / 7, 2.0 / 5,
+                                                          2.0 / 3, 2.0};
+                for (double c: COEFFICIENTS) {
+                    poly = _mm512_fmadd_pd(poly, z, set1(c));
+                }
+                const vec log_mantissa = mul(s, poly);
+                return _mm512_fmadd_pd(exponent, set1(6.93147180369123816490e-01),
+                                       _mm512_fmadd_pd(exponent, set1(1.90821492927058770002e-10), log_mantissa));
+            }
+        };
+    }
+
+    void rolling_sum(const double *in, size_t n, size_t window, double scale, double *out) {
+        rolling_sum_impl<Avx512>(in, n, window, scale, out);
+    }
+
+    void rolling_max_combine(const double *suffix, size_t n, size_t window, double *out) {
+        rolling_extreme_combine_impl<Avx512, true>(suffix, n, window, out);
+    }
+
+    void rolling_min_combine(const double *suffix, size_t n, size_t window, double *out) {
+        rolling_extreme_combine_impl<Avx512, false>(suffix, n, window, out);
+    }
+
+    void rolling_max_direct(const double *in, size_t n, size_t window, double *out) {
+        rolling_extreme_direct_impl<Avx512, true>(in, n, window, out);
+    }
+
+    void rolling_min_direct(const double *in, size_t n, size_t window, double *out) {
+        rolling_extreme_direct_impl<Avx512, false>(in, n, window, out);
+    }
+
+    void true_range(const double *high, const double *low, const double *close, size_t n, double *out) {
+        true_range_impl<Avx512>(high, low, close, n, out);
+    }
+
+    void returns(const double *in, size_t n, double *out) {
+        returns_impl<Avx512, false>(in, n, out);
+    }
+
+    void log_returns(const double *in, size_t n, double *out) {
+        returns_impl<Avx512, true>(in, n, out);
+    }
+
+}
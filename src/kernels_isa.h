@@ -0,0 +1,39 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Entry points of each instruction set, defined in kernels.cpp (scalar), kernels_avx2.cpp and
+// kernels_avx512.cpp. The vector units are only built on x86-64 (TRADING_COMMON_X86_KERNELS).
+//
+
+#ifndef TRADING_COMMON_KERNELS_ISA_H
+#define TRADING_COMMON_KERNELS_ISA_H
+
+#include <cstddef>
+
+#define TRADING_COMMON_KERNEL_DECLARATIONS                                                                    \
+    void rolling_sum(const double *in, size_t n, size_t window, double scale, double *out);                  \
+    void rolling_max_combine(const double *suffix, size_t n, size_t window, double *out);                    \
+    void rolling_min_combine(const double *suffix, size_t n, size_t window, double *out);                    \
+    void rolling_max_direct(const double *in, size_t n, size_t window, double *out);                        \
+    void rolling_min_direct(const double *in, size_t n, size_t window, double *out);                        \
+    void true_range(const double *high, const double *low, const double *close, size_t n, double *out);      \
+    void returns(const double *in, size_t n, double *out);                                                   \
+    void log_returns(const double *in, size_t n, double *out);
+
+namespace trading::kernels::scalar {
+    TRADING_COMMON_KERNEL_DECLARATIONS
+}
+
+#if defined(TRADING_COMMON_X86_KERNELS)
+namespace trading::kernels::avx2 {
+    TRADING_COMMON_KERNEL_DECLARATIONS
+}
+
+namespace trading::kernels::avx512 {
+    TRADING_COMMON_KERNEL_DECLARATIONS
+}
+#endif
+
+#undef TRADING_COMMON_KERNEL_DECLARATIONS
+
+#endif //TRADING_COMMON_KERNELS_ISA_H
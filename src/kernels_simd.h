@@ -0,0 +1,159 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Kernel bodies written once against a vector type V and instantiated by each instruction set translation
+// unit behind the entry points of kernels_isa.h. V provides WIDTH, vec, load, store, set1, add, sub, mul,
+// div, max, min, abs and log. Everything here sits in an anonymous namespace: the units are compiled with
+// different target flags and their copies must not be merged by the linker. For the same reason the bodies
+// take raw pointers and avoid std templates.
+//
+
+#ifndef TRADING_COMMON_KERNELS_SIMD_H
+#define TRADING_COMMON_KERNELS_SIMD_H
+
+#include <cstddef>
+
+namespace trading::kernels {
+    namespace {
+
+        // running sums are recomputed from scratch this often so rounding errors do not accumulate
+        constexpr size_t ANCHOR = 8192;
+
+        template<typename V>
+        void rolling_sum_impl(const double *in, size_t n, size_t window, double scale, double *out) {
+            constexpr size_t W = V::WIDTH;
+            const double nan = __builtin_nan("");
+            for (size_t i = 0; i < n && i + 1 < window; ++i) {
+                out[i] = nan;
+            }
+            for (size_t begin = window - 1; begin < n; begin += ANCHOR) {
+                const size_t end = begin + ANCHOR < n ? begin + ANCHOR : n;
+                double sum = 0;
+                for (size_t k = begin + 1 - window; k <= begin; ++k) {
+                    sum += in[k];
+                }
+                out[begin] = sum * scale;
+                size_t i = begin + 1;
+                if (end - begin >= 2 * W) {
+                    // lane l holds the sum ending at j + l and moves W places per step
+                    double lanes[W];
+                    lanes[0] = sum;
+                    for (size_t l = 1; l < W; ++l) {
+                        sum += in[begin + l] - in[begin + l - window];
+                        lanes[l] = sum;
+                        out[begin + l] = sum * scale;
+                    }
+                    typename V::vec sums = V::load(lanes);
+                    const typename V::vec factor = V::set1(scale);
+                    size_t j = begin;
+                    for (; j + 2 * W <= end; j += W) {
+                        typename V::vec added = V::load(in + j + 1);
+                        typename V::vec removed = V::load(in + j + 1 - window);
+                        for (size_t k = 2; k <= W; ++k) {
+                            added = V::add(added, V::load(in + j + k));
+                            removed = V::add(removed, V::load(in + j + k - window));
+                        }
+                        sums = V::add(sums, V::sub(added, removed));
+                        V::store(out + j + W, V::mul(sums, factor));
+                    }
+                    V::store(lanes, sums);
+                    sum = lanes[W - 1];
+                    i = j + W;
+                }
+                for (; i < end; ++i) {
+                    sum += in[i] - in[i - window];
+                    out[i] = sum * scale;
+                }
+            }
+        }
+
+        // out holds the running extreme since each block start and suffix the one up to each block end;
+        // the extreme of the window ending at i is op(suffix[i - window + 1], out[i])
+        template<typename V, bool MAX>
+        void rolling_extreme_combine_impl(const double *suffix, size_t n, size_t window, double *out) {
+            constexpr size_t W = V::WIDTH;
+            size_t i = window - 1;
+            for (; i + W <= n; i += W) {
+                typename V::vec a = V::load(suffix + i + 1 - window);
+                typename V::vec b = V::load(out + i);
+                V::store(out + i, MAX ? V::max(a, b) : V::min(a, b));
+            }
+            for (; i < n; ++i) {
+                double a = suffix[i + 1 - window];
+                out[i] = MAX ? (a > out[i] ? a : out[i]) : (a < out[i] ? a : out[i]);
+            }
+        }
+
+        // max/min over the window by brute force, `window` vector operations per WIDTH outputs; beats van Herk
+        // for windows up to a few vectors long
+        template<typename V, bool MAX>
+        void rolling_extreme_direct_impl(const double *in, size_t n, size_t window, double *out) {
+            constexpr size_t W = V::WIDTH;
+            size_t i = window - 1;
+            for (; i + W <= n; i += W) {
+                const double *first = in + i + 1 - window;
+                typename V::vec extreme = V::load(first);
+                for (size_t k = 1; k < window; ++k) {
+                    extreme = MAX ? V::max(extreme, V::load(first + k)) : V::min(extreme, V::load(first + k));
+                }
+                V::store(out + i, extreme);
+            }
+            for (; i < n; ++i) {
+                double extreme = in[i];
+                for (size_t k = i + 1 - window; k < i; ++k) {
+                    extreme = MAX ? (in[k] > extreme ? in[k] : extreme) : (in[k] < extreme ? in[k] : extreme);
+                }
+                out[i] = extreme;
+            }
+        }
+
+        template<typename V>
+        void true_range_impl(const double *high, const double *low, const double *close, size_t n, double *out) {
+            constexpr size_t W = V::WIDTH;
+            if (n == 0) {
+                return;
+            }
+            out[0] = high[0] - low[0];
+            size_t i = 1;
+            for (; i + W <= n; i += W) {
+                typename V::vec h = V::load(high + i);
+                typename V::vec l = V::load(low + i);
+                typename V::vec c = V::load(close + i - 1);
+                typename V::vec range = V::max(V::sub(h, l), V::abs(V::sub(h, c)));
+                V::store(out + i, V::max(range, V::abs(V::sub(l, c))));
+            }
+            for (; i < n; ++i) {
+                double range = high[i] - low[i];
+                double up = high[i] - close[i - 1];
+                double down = low[i] - close[i - 1];
+                up = up < 0 ? -up : up;
+                down = down < 0 ? -down : down;
+                range = range > up ? range : up;
+                out[i] = range > down ? range : down;
+            }
+        }
+
+        template<typename V, bool LOG>
+        void returns_impl(const double *in, size_t n, double *out) {
+            constexpr size_t W = V::WIDTH;
+            if (n == 0) {
+                return;
+            }
+            out[0] = __builtin_nan("");
+            const typename V::vec one = V::set1(1.0);
+            size_t i = 1;
+            for (; i + W <= n; i += W) {
+                typename V::vec ratio = V::div(V::load(in + i), V::load(in + i - 1));
+                V::store(out + i, LOG ? V::log(ratio) : V::sub(ratio, one));
+            }
+            for (; i < n; ++i) {
+                typename V::vec ratio = V::div(V::set1(in[i]), V::set1(in[i - 1]));
+                double lanes[W];
+                V::store(lanes, LOG ? V::log(ratio) : V::sub(ratio, one));
+                out[i] = lanes[0];
+            }
+        }
+    }
+}
+
+#endif //TRADING_COMMON_KERNELS_SIMD_H
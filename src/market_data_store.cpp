@@ -0,0 +1,196 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/market_data_store.h>
+#include "fork_join.h"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace trading::common {
+
+    MarketDataStore::MarketDataStore(size_t shards) {
+        if (shards == 0) {
+            shards = 4 * std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        shards = std::bit_ceil(shards);
+        m_shards = std::make_unique<Shard[]>(shards);
+        m_shard_mask = shards - 1;
+        m_directory = std::make_unique<std::atomic<Chunk *>[]>(MAX_CHUNKS);
+    }
+
+    MarketDataStore::~MarketDataStore() {
+        for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+            delete m_directory[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    MarketDataStore::Shard &MarketDataStore::shard_of(symbol_id_t id) const {
+        return m_shards[id & m_shard_mask];
+    }
+
+    MarketDataStore::Entry *MarketDataStore::lookup(symbol_id_t id) const {
+        size_t chunk_index = id >> CHUNK_BITS;
+        if (chunk_index >= MAX_CHUNKS) {
+            return nullptr;
+        }
+        const Chunk *chunk = m_directory[chunk_index].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        return chunk->entries[id & (CHUNK_SIZE - 1)].load(std::memory_order_acquire);
+    }
+
+    MarketDataStore::Entry &MarketDataStore::entry(const symbol_t &symbol) {
+        symbol_id_t id = symbol.id();
+        if (Entry *found = lookup(id)) {
+            return *found;
+        }
+        size_t chunk_index = id >> CHUNK_BITS;
+        if (chunk_index >= MAX_CHUNKS) {
+            throw OHLCException("Symbol id " + std::to_string(id) + " is out of the store directory");
+        }
+
+        Shard &shard = shard_of(id);
+        std::unique_lock lock(shard.mutex);
+        if (Entry *found = lookup(id)) {
+            return *found;
+        }
+        // chunks are shared by all shards, so two of them may race to create one
+        Chunk *chunk = m_directory[chunk_index].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            auto *created = new Chunk();
+            if (m_directory[chunk_index].compare_exchange_strong(chunk, created, std::memory_order_acq_rel)) {
+                chunk = created;
+            } else {
+                delete created;
+            }
+        }
+        shard.entries.push_back(std::make_unique<Entry>(symbol));
+        Entry *created = shard.entries.back().get();
+        chunk->entries[id & (CHUNK_SIZE - 1)].store(created, std::memory_order_release);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        return *created;
+    }
+
+    size_t MarketDataStore::shards() const {
+        return m_shard_mask + 1;
+    }
+
+    size_t MarketDataStore::size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    bool MarketDataStore::contains(const symbol_t &symbol) const {
+        return lookup(symbol.id()) != nullptr;
+    }
+
+    bool MarketDataStore::append(const OHLCV &ohlc) {
+        return append(ohlc.symbol, Bar{ohlc.timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+    }
+
+    bool MarketDataStore::append(const symbol_t &symbol, const Bar &bar) {
+        Entry &target = entry(symbol);
+        std::lock_guard lock(target.writer);
+        return target.series.append(bar);
+    }
+
+    size_t MarketDataStore::ingest(std::span<const OHLCV> bars, size_t threads) {
+        const size_t shard_count = shards();
+        const size_t workers = worker_count(threads, std::min(bars.size(), shard_count));
+        if (workers == 1) {
+            size_t appended = 0;
+            for (const auto &bar: bars) {
+                appended += append(bar);
+            }
+            return appended;
+        }
+
+        // counting sort of the bar indexes by worker, stable so each symbol keeps its order
+        std::vector<size_t> offsets(workers + 1, 0);
+        auto worker_of = [&](const OHLCV &bar) { return (bar.symbol.id() & (shard_count - 1)) % workers; };
+        for (const auto &bar: bars) {
+            ++offsets[worker_of(bar) + 1];
+        }
+        for (size_t w = 0; w < workers; ++w) {
+            offsets[w + 1] += offsets[w];
+        }
+        std::vector<size_t> order(bars.size());
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            order[next[worker_of(bars[i])]++] = i;
+        }
+
+        std::vector<size_t> appended(workers, 0);
+        fork_join(workers, [&](size_t worker) {
+            size_t count = 0;
+            for (size_t k = offsets[worker]; k < offsets[worker + 1]; ++k) {
+                count += append(bars[order[k]]);
+            }
+            appended[worker] = count;
+        });
+        size_t total = 0;
+        for (size_t count: appended) {
+            total += count;
+        }
+        return total;
+    }
+
+    const ConcurrentSeriesOHLCV *MarketDataStore::series(const symbol_t &symbol) const {
+        Entry *found = lookup(symbol.id());
+        return found == nullptr ? nullptr : &found->series;
+    }
+
+    std::optional<MarketDataStore::Snapshot> MarketDataStore::snapshot(const symbol_t &symbol) const {
+        Entry *found = lookup(symbol.id());
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        return found->series.snapshot();
+    }
+
+    std::optional<MarketDataStore::Bar> MarketDataStore::last(const symbol_t &symbol) const {
+        Entry *found = lookup(symbol.id());
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        return found->series.last();
+    }
+
+    std::vector<const MarketDataStore::Entry *> MarketDataStore::entries(size_t shard) const {
+        // copied so the lock is not held while callers work on them; entries are never removed
+        std::shared_lock lock(m_shards[shard].mutex);
+        std::vector<const Entry *> result;
+        result.reserve(m_shards[shard].entries.size());
+        for (const auto &entry: m_shards[shard].entries) {
+            result.push_back(entry.get());
+        }
+        return result;
+    }
+
+    std::vector<symbol_t> MarketDataStore::symbols() const {
+        std::vector<symbol_t> result;
+        result.reserve(size());
+        for (size_t s = 0; s < shards(); ++s) {
+            for (const Entry *entry: entries(s)) {
+                result.push_back(entry->series.snapshot().symbol());
+            }
+        }
+        return result;
+    }
+
+    void MarketDataStore::for_each(const visitor_t &visitor, size_t threads) const {
+        const size_t shard_count = shards();
+        const size_t workers = worker_count(threads, shard_count);
+        fork_join(workers, [&](size_t worker) {
+            for (size_t s = worker; s < shard_count; s += workers) {
+                for (const Entry *entry: entries(s)) {
+                    auto snapshot = entry->series.snapshot();
+                    visitor(snapshot.symbol(), snapshot);
+                }
+            }
+        });
+    }
+}
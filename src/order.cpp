@@ -14,76 +14,51 @@ namespace trading::order {
         return message.c_str();
     }
 
-    Order::Order(timestamp_t timestamp, size_t quantity, symbol_t symbol, Side side,
-                 size_t filled, price_t filled_at_price, price_t limit_price, id_t_ id,
-                 Type type, Status status) : timestamp(timestamp),
-                                             quantity(quantity),
-                                             symbol(std::move(symbol)),
-                                             side(side),
-                                             filled(filled),
-                                             filled_at_price(filled_at_price),
-                                             limit_price(limit_price),
-                                             id(std::move(id)),
-                                             type(type),
-                                             status(status) {}
-
-    Order::Order(json &j) {
+    template<typename P>
+    BasicOrder<P>::BasicOrder(timestamp_t timestamp, size_t quantity, symbol_t symbol, Side side,
+                              size_t filled, P filled_at_price, P limit_price, id_t_ id,
+                              Type type, Status status) : timestamp(timestamp),
+                                                          quantity(quantity),
+                                                          symbol(std::move(symbol)),
+                                                          side(side),
+                                                          filled(filled),
+                                                          filled_at_price(filled_at_price),
+                                                          limit_price(limit_price),
+                                                          id(std::move(id)),
+                                                          type(type),
+                                                          status(status) {}
+
+    template<typename P>
+    BasicOrder<P>::BasicOrder(json &j) : id(id_from_json(j)), timestamp(timestamp_from_json(j)) {
         try {
-            if (j.contains("timestamp") && j["timestamp"].is_number()) {
-                timestamp = j.at("timestamp").get<timestamp_t>();
-            }
-            if (j.contains("id") && j["id"].is_string()) {
-                id = j.at("id").get<id_t_>();
-            }
 
             quantity = j.at("quantity").get<size_t>();
-            *symbol = j.at("symbol").get<symbol_value_t>();
+            symbol = symbol_t(j.at("symbol").get<symbol_value_t>());
             filled = j.at("filled").get<size_t>();
-            filled_at_price = j.at("filled_at_price").get<price_t>();
-            limit_price = j.at("limit_price").get<price_t>();
-
-            std::string side_str = ::common::to_upper(j["side"]);
-            if (side_str == "BUY") {
-                side = Side::BUY;
-            } else if (side_str == "SELL") {
-                side = Side::SELL;
-            } else {
-                side = Side::NONE;
-            }
-            std::string type_str = ::common::to_upper(j.at("type").get<std::string>());
-            if (type_str == "MARKET") {
-                type = Type::MARKET;
-            } else if (type_str == "LIMIT") {
-                type = Type::LIMIT;
-            } else {
-                type = Type::NONE;
-            }
-            std::string status_str = ::common::to_upper(j.at("status").get<std::string>());
-            if (status_str == "OPEN") {
-                status = Status::OPEN;
-            } else if (status_str == "CLOSED") {
-                status = Status::CLOSED;
-            } else if (status_str == "FILLED") {
-                status = Status::FILLED;
-            } else if (status_str == "CANCELED") {
-                status = Status::CANCELED;
-            } else {
-                status = Status::NONE;
-            }
+            filled_at_price = j.at("filled_at_price").get<P>();
+            limit_price = j.at("limit_price").get<P>();
+
+            side = SideNames.parse(j.at("side").get_ref<const std::string &>(), Side::NONE);
+            type = TypeNames.parse(j.at("type").get_ref<const std::string &>(), Type::NONE);
+            status = StatusNames.parse(j.at("status").get_ref<const std::string &>(), Status::NONE);
         } catch (json::exception &e) {
             throw OrderException("Error parsing Order json: " + std::string(e.what()));
         }
     }
 
-    void Order::check_match_price(OHLC &ohlc) {
-        if (ohlc.low <= this->limit_price <= ohlc.high && type == Type::LIMIT) {
+    template<typename P>
+    void BasicOrder<P>::check_match_price(OHLC &ohlc) {
+        double limit = price_to_double(this->limit_price);
+        if (type == Type::LIMIT && ohlc.low <= limit && limit <= ohlc.high) {
             this->filled_at_price = this->limit_price;
             status = Status::FILLED;
         }
     }
 
-    void Order::check_match_price(OHLCV &ohlc) {
-        if (ohlc.low <= this->limit_price <= ohlc.high && type == Type::LIMIT) {
+    template<typename P>
+    void BasicOrder<P>::check_match_price(OHLCV &ohlc) {
+        double limit = price_to_double(this->limit_price);
+        if (type == Type::LIMIT && ohlc.low <= limit && limit <= ohlc.high) {
             this->filled_at_price = this->limit_price;
             if (ohlc.volume >= this->quantity) {
                 this->filled = this->quantity;
@@ -94,7 +69,8 @@ namespace trading::order {
         }
     }
 
-    json Order::to_json() const {
+    template<typename P>
+    json BasicOrder<P>::to_json() const {
         json j;
         j["timestamp"] = timestamp;
         j["quantity"] = quantity;
@@ -103,62 +79,28 @@ namespace trading::order {
         j["filled_at_price"] = filled_at_price;
         j["limit_price"] = limit_price;
         j["id"] = id;
-        switch (side) {
-            case Side::BUY:
-                j["side"] = "BUY";
-                break;
-            case Side::SELL:
-                j["side"] = "SELL";
-                break;
-            default:
-                j["side"] = "NONE";
-                break;
-        }
-        switch (type) {
-            case Type::MARKET:
-                j["type"] = "MARKET";
-                break;
-            case Type::LIMIT:
-                j["type"] = "LIMIT";
-                break;
-            default:
-                j["type"] = "NONE";
-                break;
-        }
-        switch (status) {
-            case Status::OPEN:
-                j["status"] = "OPEN";
-                break;
-            case Status::CLOSED:
-                j["status"] = "CLOSED";
-                break;
-            case Status::FILLED:
-                j["status"] = "FILLED";
-                break;
-            case Status::CANCELED:
-                j["status"] = "CANCELED";
-                break;
-            default:
-                j["status"] = "NONE";
-                break;
-        }
+        j["side"] = SideNames.name(side);
+        j["type"] = TypeNames.name(type);
+        j["status"] = StatusNames.name(status);
         return j;
     }
 
-    bool Order::is_empty_order() const {
+    template<typename P>
+    bool BasicOrder<P>::is_empty_order() const {
         return (timestamp > 0
                 && quantity == 0
                 && symbol && symbol->empty()
                 && side == Side::NONE
                 && filled == 0
-                && filled_at_price == 0
-                && limit_price == 0
+                && filled_at_price == P{}
+                && limit_price == P{}
                 && !id.empty()
                 && type == Type::NONE
                 && status == Status::NONE);
     }
 
-    ValidateResult Order::check_symbol() const {
+    template<typename P>
+    ValidateResult BasicOrder<P>::check_symbol() const {
         if (symbol == nullptr) {
             return {false, "Symbol is null"};
         } else if (symbol->empty()) {
@@ -167,11 +109,13 @@ namespace trading::order {
         return {true, ""};
     }
 
-    ValidateResult Order::check_quantity() const {
+    template<typename P>
+    ValidateResult BasicOrder<P>::check_quantity() const {
         return (quantity == 0) ? ValidateResult{false,"Quantity is 0"} : ValidateResult{true,""};
     }
 
-    ValidateResult Order::validate() const {
+    template<typename P>
+    ValidateResult BasicOrder<P>::validate() const {
         ValidateResult result{true,""};
 
         if (is_empty_order()) return {true, ""};
@@ -188,16 +132,16 @@ namespace trading::order {
         if (status == Status::NONE) {
             return {false, "Status is NONE"};
         }
-        if ( type == Type::LIMIT && limit_price == 0) {
+        if ( type == Type::LIMIT && limit_price == P{}) {
             return {false, "Type is LIMIT but limit_price is 0"};
         }
-        if (limit_price != 0 && type != Type::LIMIT) {
+        if (limit_price != P{} && type != Type::LIMIT) {
             return {false, "Type is not LIMIT but limit_price is not 0"};
         }
-        if (filled != 0 && filled_at_price == 0) {
+        if (filled != 0 && filled_at_price == P{}) {
             return {false, "Filled is not 0 but filled_at_price is 0"};
         }
-        if (filled_at_price != 0 && filled == 0) {
+        if (filled_at_price != P{} && filled == 0) {
             return {false, "Filled_at_price is not 0 but filled is 0"};
         }
 
@@ -223,4 +167,9 @@ namespace trading::order {
 
         return result;
     }
+
+    template struct BasicOrder<price_t>;
+    template struct BasicOrder<FixedPrice<2>>;
+    template struct BasicOrder<FixedPrice<4>>;
+    template struct BasicOrder<FixedPrice<8>>;
 }
\ No newline at end of file
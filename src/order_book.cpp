@@ -0,0 +1,393 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/order_book.h>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace trading::order {
+
+    namespace {
+        // 2^64 / golden ratio, spreads ids that share their low bits over the index
+        constexpr uint64_t HASH_MULTIPLIER = 0x9e3779b97f4a7c15;
+
+        template<typename P>
+        BasicOrder<P> execution(const BasicOrder<P> &order, size_t quantity, P price, timestamp_t timestamp) {
+            return {timestamp, quantity, order.symbol, order.side, quantity, price, order.limit_price, order.id,
+                    order.type, Status::FILLED};
+        }
+
+        template<typename P>
+        void fill(BasicOrder<P> &order, size_t quantity, P price) {
+            order.filled_at_price = order.filled == 0
+                                    ? price
+                                    : (order.filled_at_price * order.filled + price * quantity) /
+                                      (order.filled + quantity);
+            order.filled += quantity;
+            if (order.filled == order.quantity) {
+                order.status = Status::FILLED;
+            }
+        }
+    }
+
+    template<typename P>
+    BasicOrder<P> BasicFill<P>::taker_execution() const {
+        return execution(*taker, quantity, price, taker->timestamp);
+    }
+
+    template<typename P>
+    BasicOrder<P> BasicFill<P>::maker_execution() const {
+        return execution(*maker, quantity, price, taker->timestamp);
+    }
+
+    template<typename P>
+    BasicOrderBook<P>::BasicOrderBook(symbol_t symbol) : m_symbol(std::move(symbol)) {}
+
+    template<typename P>
+    void BasicOrderBook<P>::on_fill(callback_t callback) {
+        m_callback = std::move(callback);
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::reserve(size_t orders) {
+        m_nodes.reserve(orders);
+        m_orders.reserve(orders);
+        m_free_orders.reserve(orders);
+        if (orders * 2 > m_index.size()) {
+            grow_index(std::bit_ceil(orders * 2));
+        }
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::home(uint64_t hash) const {
+        return static_cast<size_t>((hash * HASH_MULTIPLIER) >> m_index_shift);
+    }
+
+    template<typename P>
+    uint32_t BasicOrderBook<P>::lookup(const id_t_ &id) const {
+        if (m_size == 0) {
+            return NONE;
+        }
+        uint64_t hash = id.hash();
+        size_t mask = m_index.size() - 1;
+        for (size_t slot = home(hash);; slot = (slot + 1) & mask) {
+            const Entry &entry = m_index[slot];
+            if (entry.order == NONE || (entry.hash == hash && m_orders[entry.order].id == id)) {
+                return entry.order;
+            }
+        }
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::grow_index(size_t capacity) {
+        std::vector<Entry> entries(capacity);
+        std::swap(entries, m_index);
+        m_index_shift = 64 - std::countr_zero(capacity);
+        size_t mask = capacity - 1;
+        for (const Entry &entry: entries) {
+            if (entry.order != NONE) {
+                size_t slot = home(entry.hash);
+                while (m_index[slot].order != NONE) {
+                    slot = (slot + 1) & mask;
+                }
+                m_index[slot] = entry;
+            }
+        }
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::add_to_index(uint64_t hash, uint32_t order) {
+        if ((m_size + 1) * 2 > m_index.size()) {
+            grow_index(std::max<size_t>(m_index.size() * 2, 16));
+        }
+        size_t mask = m_index.size() - 1;
+        size_t slot = home(hash);
+        while (m_index[slot].order != NONE) {
+            slot = (slot + 1) & mask;
+        }
+        m_index[slot] = Entry{hash, order};
+        ++m_size;
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::remove_from_index(uint64_t hash, uint32_t order) {
+        size_t mask = m_index.size() - 1;
+        size_t hole = home(hash);
+        while (m_index[hole].order != order) {
+            hole = (hole + 1) & mask;
+        }
+        // an entry after the hole moves into it unless its home lies between the two, where a lookup
+        // starting from its home would no longer pass the hole
+        for (size_t next = (hole + 1) & mask; m_index[next].order != NONE; next = (next + 1) & mask) {
+            if (((next - home(m_index[next].hash)) & mask) >= ((next - hole) & mask)) {
+                m_index[hole] = m_index[next];
+                hole = next;
+            }
+        }
+        m_index[hole] = Entry{};
+        --m_size;
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::position(Side side, P price) const {
+        const auto &rungs = ladder(side);
+        auto found = side == Side::BUY
+                     ? std::lower_bound(rungs.begin(), rungs.end(), price,
+                                        [](const Rung &rung, P value) { return rung.price < value; })
+                     : std::lower_bound(rungs.begin(), rungs.end(), price,
+                                        [](const Rung &rung, P value) { return rung.price > value; });
+        return static_cast<size_t>(found - rungs.begin());
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::execute(Order &order) {
+        auto &opposite = ladder(order.side == Side::BUY ? Side::SELL : Side::BUY);
+        size_t remaining = order.quantity - order.filled;
+        size_t start = remaining;
+        while (remaining > 0 && !opposite.empty()) {
+            const Rung top = opposite.back();
+            if (order.type == Type::LIMIT &&
+                (order.side == Side::BUY ? order.limit_price < top.price : order.limit_price > top.price)) {
+                break;
+            }
+            Level &level = m_levels[top.level];
+            while (remaining > 0 && level.head != NONE) {
+                uint32_t index = level.head;
+                Node &node = m_nodes[index];
+                Order &maker = m_orders[index];
+                size_t quantity = std::min(remaining, node.remaining);
+                node.remaining -= quantity;
+                level.quantity -= quantity;
+                remaining -= quantity;
+                fill(maker, quantity, top.price);
+                fill(order, quantity, top.price);
+                if (m_callback) {
+                    m_callback(Fill{&order, &maker, quantity, top.price});
+                }
+                if (node.remaining == 0) {
+                    level.head = node.next;
+                    if (level.head == NONE) {
+                        level.tail = NONE;
+                    } else {
+                        m_nodes[level.head].previous = NONE;
+                    }
+                    remove_from_index(node.hash, index);
+                    m_free_orders.push_back(index);
+                }
+            }
+            if (level.head == NONE) {
+                opposite.pop_back();
+                m_free_levels.push_back(top.level);
+            }
+        }
+        return start - remaining;
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::rest(Order &&order) {
+        auto &rungs = ladder(order.side);
+        size_t at = position(order.side, order.limit_price);
+        uint32_t level;
+        if (at < rungs.size() && rungs[at].price == order.limit_price) {
+            level = rungs[at].level;
+        } else {
+            if (m_free_levels.empty()) {
+                level = static_cast<uint32_t>(m_levels.size());
+                m_levels.emplace_back();
+            } else {
+                level = m_free_levels.back();
+                m_free_levels.pop_back();
+                m_levels[level] = Level{};
+            }
+            rungs.insert(rungs.begin() + static_cast<std::ptrdiff_t>(at), Rung{order.limit_price, level});
+        }
+
+        Level &queue = m_levels[level];
+        Node rested{order.quantity - order.filled, order.id.hash(), level, queue.tail, NONE};
+        uint32_t index;
+        if (m_free_orders.empty()) {
+            // a new slot is made from the order itself: a default BasicOrder would draw an id and read the clock
+            index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.push_back(rested);
+            m_orders.push_back(std::move(order));
+        } else {
+            index = m_free_orders.back();
+            m_free_orders.pop_back();
+            m_nodes[index] = rested;
+            m_orders[index] = std::move(order);
+        }
+
+        Node &node = m_nodes[index];
+        if (queue.tail == NONE) {
+            queue.head = index;
+        } else {
+            m_nodes[queue.tail].next = index;
+        }
+        queue.tail = index;
+        queue.quantity += node.remaining;
+        add_to_index(node.hash, index);
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::remove(uint32_t index) {
+        Node &node = m_nodes[index];
+        Level &level = m_levels[node.level];
+        if (node.previous == NONE) {
+            level.head = node.next;
+        } else {
+            m_nodes[node.previous].next = node.next;
+        }
+        if (node.next == NONE) {
+            level.tail = node.previous;
+        } else {
+            m_nodes[node.next].previous = node.previous;
+        }
+        level.quantity -= node.remaining;
+        if (level.head == NONE) {
+            const Order &order = m_orders[index];
+            remove_level(order.side, order.limit_price, node.level);
+        }
+        remove_from_index(node.hash, index);
+        m_free_orders.push_back(index);
+    }
+
+    template<typename P>
+    void BasicOrderBook<P>::remove_level(Side side, P price, uint32_t level) {
+        auto &rungs = ladder(side);
+        rungs.erase(rungs.begin() + static_cast<std::ptrdiff_t>(position(side, price)));
+        m_free_levels.push_back(level);
+    }
+
+    template<typename P>
+    typename BasicOrderBook<P>::AddResult BasicOrderBook<P>::add(Order order) {
+        AddResult result;
+        // what validate() checks of an open order, without building its messages unless it fails
+        bool priced = order.type == Type::LIMIT ? order.limit_price != P{}
+                                                : order.type == Type::MARKET && order.limit_price == P{};
+        if (order.quantity == 0) {
+            result.message = "Quantity is 0";
+        } else if (order.status != Status::OPEN || order.filled != 0 || order.filled_at_price != P{}) {
+            result.message = "Order is not OPEN and unfilled";
+        } else if ((order.side != Side::BUY && order.side != Side::SELL) || !priced || !order.symbol) {
+            result.message = order.validate().message;
+        } else if (order.symbol != m_symbol) {
+            result.message = "Symbol is not the book's " + *m_symbol;
+        } else if (order.id.empty()) {
+            result.message = "Id is empty";
+        } else if (lookup(order.id) != NONE) {
+            result.message = "An order with the same id is resting";
+        }
+        if (!result.message.empty()) {
+            return result;
+        }
+
+        result.success = true;
+        result.filled = execute(order);
+        if (order.filled < order.quantity) {
+            if (order.type == Type::LIMIT) {
+                rest(std::move(order));
+                result.resting = true;
+            } else {
+                result.canceled = order.quantity - order.filled;
+            }
+        }
+        return result;
+    }
+
+    template<typename P>
+    bool BasicOrderBook<P>::cancel(const id_t_ &id) {
+        uint32_t index = lookup(id);
+        if (index == NONE) {
+            return false;
+        }
+        remove(index);
+        return true;
+    }
+
+    template<typename P>
+    bool BasicOrderBook<P>::amend(const id_t_ &id, size_t quantity, P limit_price) {
+        uint32_t index = lookup(id);
+        if (index == NONE || limit_price == P{}) {
+            return false;
+        }
+        Order &order = m_orders[index];
+        if (quantity <= order.filled) {
+            remove(index);
+            return true;
+        }
+        if (limit_price == order.limit_price && quantity <= order.quantity) {
+            size_t reduction = order.quantity - quantity;
+            m_nodes[index].remaining -= reduction;
+            m_levels[m_nodes[index].level].quantity -= reduction;
+            order.quantity = quantity;
+            return true;
+        }
+
+        // loses its place: out of the book, then in again as if new, keeping what it has filled
+        remove(index);
+        Order amended = std::move(m_orders[index]);
+        amended.quantity = quantity;
+        amended.limit_price = limit_price;
+        execute(amended);
+        if (amended.filled < amended.quantity) {
+            rest(std::move(amended));
+        }
+        return true;
+    }
+
+    template<typename P>
+    const typename BasicOrderBook<P>::Order *BasicOrderBook<P>::find(const id_t_ &id) const {
+        uint32_t index = lookup(id);
+        return index == NONE ? nullptr : &m_orders[index];
+    }
+
+    template<typename P>
+    P BasicOrderBook<P>::best_bid() const {
+        return m_bids.empty() ? P{} : m_bids.back().price;
+    }
+
+    template<typename P>
+    P BasicOrderBook<P>::best_ask() const {
+        return m_asks.empty() ? P{} : m_asks.back().price;
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::volume_at(Side side, P price) const {
+        const auto &rungs = ladder(side);
+        size_t at = position(side, price);
+        return at < rungs.size() && rungs[at].price == price ? m_levels[rungs[at].level].quantity : 0;
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::levels(Side side) const {
+        return ladder(side).size();
+    }
+
+    template<typename P>
+    size_t BasicOrderBook<P>::size() const {
+        return m_size;
+    }
+
+    template<typename P>
+    bool BasicOrderBook<P>::empty() const {
+        return m_size == 0;
+    }
+
+    template<typename P>
+    const symbol_t &BasicOrderBook<P>::symbol() const {
+        return m_symbol;
+    }
+
+    template struct BasicFill<price_t>;
+    template struct BasicFill<FixedPrice<2>>;
+    template struct BasicFill<FixedPrice<4>>;
+    template struct BasicFill<FixedPrice<8>>;
+
+    template class BasicOrderBook<price_t>;
+    template class BasicOrderBook<FixedPrice<2>>;
+    template class BasicOrderBook<FixedPrice<4>>;
+    template class BasicOrderBook<FixedPrice<8>>;
+}
@@ -0,0 +1,45 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+// Stable sort split over threads, used by the bulk inserts of SeriesOHLCV and ColumnarSeriesOHLCV.
+//
+
+#ifndef TRADING_COMMON_PARALLEL_SORT_H
+#define TRADING_COMMON_PARALLEL_SORT_H
+
+#include <algorithm>
+#include <iterator>
+#include "fork_join.h"
+
+namespace trading::common {
+
+    // Sorts [first, last) keeping the order of equal elements. The range is cut in one chunk per thread (0 for
+    // one per hardware thread), the chunks are sorted at the same time and then merged pairwise, each level of
+    // merges in parallel.
+    template<typename It, typename Compare>
+    void parallel_stable_sort(It first, It last, Compare compare, size_t threads) {
+        // below this a chunk is not worth a thread
+        constexpr size_t MIN_CHUNK = 16'384;
+        const auto size = static_cast<size_t>(std::distance(first, last));
+        const size_t chunks = worker_count(threads, size / MIN_CHUNK);
+        if (chunks == 1) {
+            std::stable_sort(first, last, compare);
+            return;
+        }
+        auto bound = [&](size_t chunk) {
+            return first + static_cast<std::ptrdiff_t>(size * std::min(chunk, chunks) / chunks);
+        };
+
+        fork_join(chunks, [&](size_t chunk) { std::stable_sort(bound(chunk), bound(chunk + 1), compare); });
+        for (size_t width = 1; width < chunks; width *= 2) {
+            // each merge joins a pair of runs of `width` chunks, the second one possibly shorter
+            const size_t merges = (chunks + width - 1) / (2 * width);
+            fork_join(merges, [&, width](size_t merge) {
+                const size_t chunk = merge * 2 * width;
+                std::inplace_merge(bound(chunk), bound(chunk + width), bound(chunk + 2 * width), compare);
+            });
+        }
+    }
+}
+
+#endif //TRADING_COMMON_PARALLEL_SORT_H
@@ -5,32 +5,45 @@
 
 namespace trading::pnl {
 
-    void PnL::add_position(const Position& position) {
+    template<typename P>
+    void BasicPnL<P>::add_position(const Position& position) {
         this->add_position(std::make_shared<Position>(position));
     }
 
-    void PnL::add_position(const std::shared_ptr<Position>& position) {
-        positions[*position->symbol] = position;
+    template<typename P>
+    void BasicPnL<P>::add_position(const std::shared_ptr<Position>& position) {
+        positions[position->symbol.id()] = position;
     }
 
-    void PnL::delete_position(const symbol_t& symbol) {
-        positions.erase(*symbol);
+    template<typename P>
+    void BasicPnL<P>::delete_position(const symbol_t& symbol) {
+        positions.erase(symbol.id());
     }
 
-    void PnL::delete_position(const symbol_value_t& symbol) {
-        positions.erase(symbol);
+    template<typename P>
+    void BasicPnL<P>::delete_position(const symbol_value_t& symbol) {
+        // a name that was never interned cannot have a position
+        if (auto id = SymbolTable::global().find(symbol)) {
+            positions.erase(*id);
+        }
     }
 
-    void PnL::add_cash(price_t cashAmount) {
+    template<typename P>
+    void BasicPnL<P>::add_cash(P cashAmount) {
         cash += cashAmount;
     }
 
-    price_t PnL::calculate_total_value() const  {
-        price_t totalValue = cash;
+    template<typename P>
+    P BasicPnL<P>::calculate_total_value() const  {
+        P totalValue = cash;
         for (const auto& [symbol, position] : positions) {
             totalValue += position->get_pnl();
         }
         return totalValue;
     }
 
+    template class BasicPnL<price_t>;
+    template class BasicPnL<FixedPrice<2>>;
+    template class BasicPnL<FixedPrice<4>>;
+    template class BasicPnL<FixedPrice<8>>;
 }
\ No newline at end of file
@@ -8,44 +8,35 @@
 
 namespace trading::position {
 
-    Position::Position(id_t_ id, timestamp_t timestamp, size_t balance, symbol_t symbol, Side side, price_t entry_price,
-                       price_t current_price, price_t pnl) : id(std::move(id)), timestamp(timestamp), balance(balance),
-                                                             symbol(std::move(symbol)),
-                                                             side(side), entry_price(entry_price),
-                                                             current_price(current_price),
-                                                             pnl(pnl) {}
-
-    Position::Position(json &j) {
-        if (j.contains("timestamp") && j["timestamp"].is_number()) {
-            timestamp = j.at("timestamp").get<timestamp_t>();
-        }
-        if (j.contains("id") && j["id"].is_string()) {
-            id = j.at("id").get<id_t_>();
-        }
+    template<typename P>
+    BasicPosition<P>::BasicPosition(id_t_ id, timestamp_t timestamp, size_t balance, symbol_t symbol, Side side,
+                                    P entry_price, P current_price, P pnl) : id(std::move(id)), timestamp(timestamp),
+                                                                             balance(balance),
+                                                                             symbol(std::move(symbol)),
+                                                                             side(side), entry_price(entry_price),
+                                                                             current_price(current_price),
+                                                                             pnl(pnl) {}
+
+    template<typename P>
+    BasicPosition<P>::BasicPosition(json &j) : id(id_from_json(j)), timestamp(timestamp_from_json(j)) {
 
         balance = j.at("balance").get<size_t>();
-        *symbol = j.at("symbol").get<symbol_value_t>();
-        entry_price = j.at("entry_price").get<price_t>();
-        current_price = j.at("current_price").get<price_t>();
-        pnl = j.at("pnl").get<price_t>();
-
-        std::string side_str = j.at("side").get<std::string>();
-        if (side_str == "LONG") {
-            this->side = Side::LONG;
-        } else if (side_str == "SHORT") {
-            this->side = Side::SHORT;
-        } else {
-            this->side = Side::NONE;
-        }
+        symbol = symbol_t(j.at("symbol").get<symbol_value_t>());
+        entry_price = j.at("entry_price").get<P>();
+        current_price = j.at("current_price").get<P>();
+        pnl = j.at("pnl").get<P>();
+
+        side = SideNames.parse(j.at("side").get_ref<const std::string &>(), Side::NONE);
     }
 
-    bool Position::validate() const {
+    template<typename P>
+    bool BasicPosition<P>::validate() const {
         if (timestamp > 0
             && balance == 0
             && symbol->empty()
             && side == Side::NONE
-            && current_price == 0
-            && entry_price == 0
+            && current_price == P{}
+            && entry_price == P{}
             && !id.empty()) {
             return true;
         }
@@ -53,30 +44,33 @@ namespace trading::position {
             return false;
         if (symbol->empty())
             return false;
-        if (balance != 0 && entry_price == 0)
+        if (balance != 0 && entry_price == P{})
             return false;
 
         return true;
     }
 
-    void Position::set_current_price(price_t cp) {
+    template<typename P>
+    void BasicPosition<P>::set_current_price(P cp) {
         this->current_price = cp;
         this->pnl = get_pnl();
     }
 
-    price_t Position::get_pnl() const {
-        if (current_price == 0 && side != Side::NONE)
+    template<typename P>
+    P BasicPosition<P>::get_pnl() const {
+        if (current_price == P{} && side != Side::NONE)
             throw std::runtime_error("Current price is 0");
         if (side == Side::LONG) {
-            return (price_t) balance * (current_price - entry_price);
+            return (current_price - entry_price) * balance;
         } else if (side == Side::SHORT) {
-            return (price_t) balance * (entry_price - current_price);
+            return (entry_price - current_price) * balance;
         } else {
-            return 0;
+            return P{};
         }
     }
 
-    [[nodiscard]] json Position::to_json() const {
+    template<typename P>
+    json BasicPosition<P>::to_json() const {
         json j;
         j["id"] = id;
         j["timestamp"] = timestamp;
@@ -86,21 +80,12 @@ namespace trading::position {
         j["current_price"] = current_price;
         j["pnl"] = pnl;
 
-        switch (side) {
-            case Side::LONG:
-                j["side"] = "LONG";
-                break;
-            case Side::SHORT:
-                j["side"] = "SHORT";
-                break;
-            default:
-                j["side"] = "NONE";
-                break;
-        }
+        j["side"] = SideNames.name(side);
         return j;
     }
 
-    Position::ApplyOrderResult Position::validateOrder(const trading::order::Order &order) {
+    template<typename P>
+    typename BasicPosition<P>::ApplyOrderResult BasicPosition<P>::validateOrder(const Order &order) {
         ApplyOrderResult result;
         result.success = true;
         if (!order.validate().success) {
@@ -116,7 +101,8 @@ namespace trading::position {
         return result;
     }
 
-    Position::ApplyOrderResult Position::apply_order_for_empty_position(const trading::order::Order &order) {
+    template<typename P>
+    typename BasicPosition<P>::ApplyOrderResult BasicPosition<P>::apply_order_for_empty_position(const Order &order) {
         // ... code for balance == 0
         ApplyOrderResult result;
         if (order.side == trading::order::Side::BUY) {
@@ -138,25 +124,24 @@ namespace trading::position {
         return result;
     }
 
-    Position::ApplyOrderResult Position::apply_order_for_long_position(const trading::order::Order &order) {
+    template<typename P>
+    typename BasicPosition<P>::ApplyOrderResult BasicPosition<P>::apply_order_for_long_position(const Order &order) {
 // ... code for side == Side::LONG
         ApplyOrderResult result;
         if (order.side == trading::order::Side::BUY) {
             auto new_balance = balance + order.filled;
-            entry_price = (entry_price * (price_t) balance + order.filled_at_price * (price_t) order.filled) /
-                          (price_t) new_balance;
+            entry_price = (entry_price * balance + order.filled_at_price * order.filled) / new_balance;
             balance = new_balance;
             result.pnl = pnl = get_pnl();
             result.success = true;
         } else if (order.side == trading::order::Side::SELL) {
             if (balance >= order.filled) {
-                entry_price = (entry_price * (price_t) balance - order.filled_at_price * (price_t) order.filled) /
-                              (price_t) order.filled;
+                entry_price = (entry_price * balance - order.filled_at_price * order.filled) / order.filled;
                 balance = balance - order.filled;
                 result.pnl = pnl = get_pnl();
                 result.success = true;
             } else {
-                price_t add_to_pnl = (order.filled_at_price - entry_price) * (price_t) balance;
+                P add_to_pnl = (order.filled_at_price - entry_price) * balance;
                 entry_price = order.filled_at_price;
                 balance = -(balance - order.filled);
                 side = Side::SHORT;
@@ -170,19 +155,19 @@ namespace trading::position {
         return result;
     }
 
-    Position::ApplyOrderResult Position::apply_order_for_short_position(const trading::order::Order &order) {
+    template<typename P>
+    typename BasicPosition<P>::ApplyOrderResult BasicPosition<P>::apply_order_for_short_position(const Order &order) {
         // ... code for side == Side::SHORT
         ApplyOrderResult result;
         if (order.side == trading::order::Side::BUY) {
             if (balance >= order.filled) {
-                entry_price = (entry_price * (price_t) balance - order.filled_at_price * (price_t) order.filled) /
-                              (price_t) order.filled;
+                entry_price = (entry_price * balance - order.filled_at_price * order.filled) / order.filled;
                 balance -= order.filled;
                 result.pnl = pnl = get_pnl();
                 result.success = true;
             } else {
                 // Change side from short to long
-                price_t add_to_pnl = (entry_price - order.filled_at_price) * (price_t) balance;
+                P add_to_pnl = (entry_price - order.filled_at_price) * balance;
                 entry_price = order.filled_at_price;
                 balance = order.filled - balance;
                 side = Side::LONG;
@@ -191,8 +176,7 @@ namespace trading::position {
             }
         } else if (order.side == trading::order::Side::SELL) {
             auto new_balance = balance + order.filled;
-            entry_price = (entry_price * (price_t) balance + order.filled_at_price * (price_t) order.filled) /
-                          (price_t) new_balance;
+            entry_price = (entry_price * balance + order.filled_at_price * order.filled) / new_balance;
             balance = new_balance;
             result.pnl = pnl = get_pnl();
             result.success = true;
@@ -203,7 +187,8 @@ namespace trading::position {
         return result;
     }
 
-    Position::ApplyOrderResult Position::apply_order(const trading::order::Order &order) {
+    template<typename P>
+    typename BasicPosition<P>::ApplyOrderResult BasicPosition<P>::apply_order(const Order &order) {
         ApplyOrderResult result = validateOrder(order);
         if (!result.success) {
             return result;
@@ -211,7 +196,7 @@ namespace trading::position {
 
         if (symbol->empty()) {
             symbol = order.symbol;
-        } else if (*symbol != *order.symbol) {
+        } else if (symbol != order.symbol) {
             result.message = "Symbol is not the same" + *symbol + "!=" + *order.symbol;
             result.success = false;
             return result;
@@ -228,4 +213,9 @@ namespace trading::position {
         }
         return result;
     }
+
+    template class BasicPosition<price_t>;
+    template class BasicPosition<FixedPrice<2>>;
+    template class BasicPosition<FixedPrice<4>>;
+    template class BasicPosition<FixedPrice<8>>;
 }
\ No newline at end of file
@@ -0,0 +1,146 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/resample.h>
+#include <trading_common/aggregator.h>
+#include <trading_common/calendar.h>
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace trading::common {
+
+    namespace {
+
+        double reduce_max(const double *data, size_t count) {
+            size_t i = 0;
+            double result = data[0];
+#if defined(__SSE2__)
+            if (count >= 4) {
+                __m128d a = _mm_loadu_pd(data);
+                __m128d b = _mm_loadu_pd(data + 2);
+                for (i = 4; i + 4 <= count; i += 4) {
+                    a = _mm_max_pd(a, _mm_loadu_pd(data + i));
+                    b = _mm_max_pd(b, _mm_loadu_pd(data + i + 2));
+                }
+                a = _mm_max_pd(a, b);
+                a = _mm_max_sd(a, _mm_unpackhi_pd(a, a));
+                result = _mm_cvtsd_f64(a);
+            }
+#endif
+            for (; i < count; ++i) {
+                result = std::max(result, data[i]);
+            }
+            return result;
+        }
+
+        double reduce_min(const double *data, size_t count) {
+            size_t i = 0;
+            double result = data[0];
+#if defined(__SSE2__)
+            if (count >= 4) {
+                __m128d a = _mm_loadu_pd(data);
+                __m128d b = _mm_loadu_pd(data + 2);
+                for (i = 4; i + 4 <= count; i += 4) {
+                    a = _mm_min_pd(a, _mm_loadu_pd(data + i));
+                    b = _mm_min_pd(b, _mm_loadu_pd(data + i + 2));
+                }
+                a = _mm_min_pd(a, b);
+                a = _mm_min_sd(a, _mm_unpackhi_pd(a, a));
+                result = _mm_cvtsd_f64(a);
+            }
+#endif
+            for (; i < count; ++i) {
+                result = std::min(result, data[i]);
+            }
+            return result;
+        }
+
+        size_t reduce_sum(const size_t *data, size_t count) {
+            size_t i = 0;
+            size_t result = 0;
+#if defined(__SSE2__)
+            static_assert(sizeof(size_t) == 8);
+            if (count >= 4) {
+                __m128i a = _mm_setzero_si128();
+                __m128i b = _mm_setzero_si128();
+                for (; i + 4 <= count; i += 4) {
+                    a = _mm_add_epi64(a, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+                    b = _mm_add_epi64(b, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 2)));
+                }
+                a = _mm_add_epi64(a, b);
+                alignas(16) size_t lanes[2];
+                _mm_store_si128(reinterpret_cast<__m128i *>(lanes), a);
+                result = lanes[0] + lanes[1];
+            }
+#endif
+            for (; i < count; ++i) {
+                result += data[i];
+            }
+            return result;
+        }
+
+        // [start, end) of the group of `days` local days that contains timestamp
+        std::pair<timestamp_t, timestamp_t> local_day_bucket(timestamp_t timestamp, timestamp_t days) {
+            const TimeZone &zone = TimeZone::local();
+            int64_t local_day = zone.local_day(static_cast<int64_t>(timestamp));
+            int64_t first_day = local_day - local_day % static_cast<int64_t>(days);
+            return {static_cast<timestamp_t>(zone.midnight(first_day)),
+                    static_cast<timestamp_t>(zone.midnight(first_day + static_cast<int64_t>(days)))};
+        }
+    }
+
+    ColumnarSeriesOHLCV resample(const ColumnsOHLCV &columns, timestamp_t timeframe, Alignment alignment,
+                                 symbol_t symbol) {
+        if (timeframe == 0) {
+            throw OHLCException("Resample timeframe must be greater than 0");
+        }
+        if (alignment == Alignment::CALENDAR_DAY && timeframe % timeframes::DAY != 0) {
+            throw OHLCException("Calendar day resample needs a whole number of days: " + std::to_string(timeframe));
+        }
+
+        ColumnarSeriesOHLCV result(std::move(symbol));
+        const size_t size = columns.size();
+        if (size != 0) {
+            auto span = columns.timestamp.back() - columns.timestamp.front();
+            result.reserve(std::min<size_t>(size, span / timeframe + 2));
+        }
+        size_t begin = 0;
+        while (begin < size) {
+            timestamp_t start, end;
+            if (alignment == Alignment::CALENDAR_DAY) {
+                std::tie(start, end) = local_day_bucket(columns.timestamp[begin], timeframe / timeframes::DAY);
+            } else {
+                start = columns.timestamp[begin] - columns.timestamp[begin] % timeframe;
+                end = start + timeframe;
+            }
+            // buckets are short compared to the series, a forward scan beats a binary search here
+            size_t last = begin + 1;
+            while (last < size && columns.timestamp[last] < end) {
+                ++last;
+            }
+            size_t count = last - begin;
+            result.insert(ColumnarSeriesOHLCV::Bar{start,
+                                                   columns.open[begin],
+                                                   reduce_max(columns.high.data() + begin, count),
+                                                   reduce_min(columns.low.data() + begin, count),
+                                                   columns.close[last - 1],
+                                                   reduce_sum(columns.volume.data() + begin, count)});
+            begin = last;
+        }
+        return result;
+    }
+
+    ColumnarSeriesOHLCV resample(const ColumnarSeriesOHLCV &series, timestamp_t timeframe, Alignment alignment) {
+        return resample(series.columns(), timeframe, alignment, series.symbol());
+    }
+
+    SeriesOHLCV resample(const SeriesOHLCV &series, timestamp_t timeframe, Alignment alignment) {
+        return resample(ColumnarSeriesOHLCV(series), timeframe, alignment).to_series();
+    }
+
+}
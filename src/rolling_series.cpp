@@ -0,0 +1,207 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/rolling_series.h>
+
+#include <algorithm>
+
+namespace trading::common {
+
+    RollingSeriesOHLCV::RollingSeriesOHLCV(size_t capacity, symbol_t symbol) : m_symbol(std::move(symbol)) {
+        if (capacity == 0) {
+            throw OHLCException("Rolling series capacity must be greater than 0");
+        }
+        m_timestamp.resize(capacity);
+        m_open.resize(capacity);
+        m_high.resize(capacity);
+        m_low.resize(capacity);
+        m_close.resize(capacity);
+        m_volume.resize(capacity);
+    }
+
+    size_t RollingSeriesOHLCV::physical(size_t index) const {
+        size_t position = m_head + index;
+        return position >= m_timestamp.size() ? position - m_timestamp.size() : position;
+    }
+
+    const symbol_t &RollingSeriesOHLCV::symbol() const {
+        return m_symbol;
+    }
+
+    size_t RollingSeriesOHLCV::capacity() const {
+        return m_timestamp.size();
+    }
+
+    size_t RollingSeriesOHLCV::size() const {
+        return m_size;
+    }
+
+    bool RollingSeriesOHLCV::empty() const {
+        return m_size == 0;
+    }
+
+    bool RollingSeriesOHLCV::full() const {
+        return m_size == m_timestamp.size();
+    }
+
+    void RollingSeriesOHLCV::clear() {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    bool RollingSeriesOHLCV::insert(const OHLCV &ohlc) {
+        if (m_symbol->empty()) {
+            m_symbol = ohlc.symbol;
+        }
+        return insert(Bar{ohlc.timestamp, ohlc.open, ohlc.high, ohlc.low, ohlc.close, ohlc.volume});
+    }
+
+    bool RollingSeriesOHLCV::insert(const Bar &bar) {
+        if (m_size > 0 && bar.timestamp <= m_timestamp[physical(m_size - 1)]) {
+            // same as std::map::insert, an existing bar is kept
+            return find(bar.timestamp).has_value();
+        }
+        size_t slot;
+        if (full()) {
+            slot = m_head;
+            m_head = physical(1);
+        } else {
+            slot = physical(m_size);
+            ++m_size;
+        }
+        m_timestamp[slot] = bar.timestamp;
+        m_open[slot] = bar.open;
+        m_high[slot] = bar.high;
+        m_low[slot] = bar.low;
+        m_close[slot] = bar.close;
+        m_volume[slot] = bar.volume;
+        return true;
+    }
+
+    RollingSeriesOHLCV::Bar RollingSeriesOHLCV::at(size_t index) const {
+        size_t i = physical(index);
+        return {m_timestamp[i], m_open[i], m_high[i], m_low[i], m_close[i], m_volume[i]};
+    }
+
+    RollingSeriesOHLCV::Bar RollingSeriesOHLCV::front() const {
+        if (m_size == 0) {
+            throw OHLCException("Empty rolling series has no first bar");
+        }
+        return at(0);
+    }
+
+    RollingSeriesOHLCV::Bar RollingSeriesOHLCV::back() const {
+        if (m_size == 0) {
+            throw OHLCException("Empty rolling series has no last bar");
+        }
+        return at(m_size - 1);
+    }
+
+    std::optional<RollingSeriesOHLCV::Bar> RollingSeriesOHLCV::find(timestamp_t timestamp) const {
+        auto [older, newer] = segments();
+        std::optional<size_t> index;
+        if (!newer.empty() && newer.timestamp.front() <= timestamp) {
+            index = newer.find(timestamp);
+            if (index) {
+                *index += older.size();
+            }
+        } else {
+            index = older.find(timestamp);
+        }
+        if (!index) {
+            return std::nullopt;
+        }
+        return at(*index);
+    }
+
+    std::optional<RollingSeriesOHLCV::Bar> RollingSeriesOHLCV::as_of(timestamp_t timestamp) const {
+        auto [older, newer] = segments();
+        if (!newer.empty() && newer.timestamp.front() <= timestamp) {
+            return at(older.size() + *newer.as_of(timestamp));
+        }
+        auto index = older.as_of(timestamp);
+        if (!index) {
+            return std::nullopt;
+        }
+        return at(*index);
+    }
+
+    std::array<ColumnsOHLCV, 2> RollingSeriesOHLCV::segments() const {
+        ColumnsOHLCV ring{m_timestamp, m_open, m_high, m_low, m_close, m_volume};
+        size_t first = std::min(m_size, capacity() - m_head);
+        return {ring.subspan(m_head, first), ring.subspan(0, m_size - first)};
+    }
+
+    ColumnarSeriesOHLCV RollingSeriesOHLCV::to_columnar() const {
+        std::vector<timestamp_t> timestamp;
+        std::vector<double> open, high, low, close;
+        std::vector<size_t> volume;
+        timestamp.reserve(m_size);
+        open.reserve(m_size);
+        high.reserve(m_size);
+        low.reserve(m_size);
+        close.reserve(m_size);
+        volume.reserve(m_size);
+        for (const auto &segment: segments()) {
+            timestamp.insert(timestamp.end(), segment.timestamp.begin(), segment.timestamp.end());
+            open.insert(open.end(), segment.open.begin(), segment.open.end());
+            high.insert(high.end(), segment.high.begin(), segment.high.end());
+            low.insert(low.end(), segment.low.begin(), segment.low.end());
+            close.insert(close.end(), segment.close.begin(), segment.close.end());
+            volume.insert(volume.end(), segment.volume.begin(), segment.volume.end());
+        }
+        return {m_symbol, std::move(timestamp), std::move(open), std::move(high), std::move(low), std::move(close),
+                std::move(volume)};
+    }
+
+    json RollingSeriesOHLCV::to_json() const {
+        json j;
+        for (size_t i = 0; i < m_size; ++i) {
+            j.push_back(at(i).to_json());
+        }
+        return j;
+    }
+
+    RollingSeriesOHLCV::iterator::iterator(const RollingSeriesOHLCV *s, std::ptrdiff_t i) : series(s), index(i) {}
+
+    RollingSeriesOHLCV::iterator &RollingSeriesOHLCV::iterator::operator++() {
+        ++index;
+        return *this;
+    }
+
+    RollingSeriesOHLCV::iterator &RollingSeriesOHLCV::iterator::operator--() {
+        --index;
+        return *this;
+    }
+
+    bool RollingSeriesOHLCV::iterator::operator==(const iterator &other) const {
+        return index == other.index;
+    }
+
+    bool RollingSeriesOHLCV::iterator::operator!=(const iterator &other) const {
+        return index != other.index;
+    }
+
+    std::pair<const timestamp_t, RollingSeriesOHLCV::Bar> RollingSeriesOHLCV::iterator::operator*() const {
+        auto bar = series->at(static_cast<size_t>(index));
+        return {bar.timestamp, bar};
+    }
+
+    RollingSeriesOHLCV::iterator RollingSeriesOHLCV::begin() const {
+        return {this, 0};
+    }
+
+    RollingSeriesOHLCV::iterator RollingSeriesOHLCV::end() const {
+        return {this, static_cast<std::ptrdiff_t>(m_size)};
+    }
+
+    RollingSeriesOHLCV::iterator RollingSeriesOHLCV::rbegin() const {
+        return {this, static_cast<std::ptrdiff_t>(m_size) - 1};
+    }
+
+    RollingSeriesOHLCV::iterator RollingSeriesOHLCV::rend() const {
+        return {this, -1};
+    }
+
+}
@@ -0,0 +1,259 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/rolling_stats.h>
+#include "indicator_period.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trading::indicators {
+
+    namespace {
+        double typical_price(const Bar &bar) {
+            return (bar.high + bar.low + bar.close) / 3;
+        }
+    }
+
+    RollingVariance::RollingVariance(size_t period) {
+        check_period(period);
+        m_window.resize(period);
+    }
+
+    void RollingVariance::replace(double removed, double added, size_t n) {
+        double change = added - removed;
+        double mean = m_mean;
+        m_mean += change / static_cast<double>(n);
+        m_m2 += change * (added - m_mean + removed - mean);
+        m_m2 = std::max(m_m2, 0.0);
+    }
+
+    void RollingVariance::update(double value) {
+        const size_t period = m_window.size();
+        if (m_count >= period) {
+            replace(m_window[m_head], value, period);
+        } else {
+            double delta = value - m_mean;
+            m_mean += delta / static_cast<double>(m_count + 1);
+            m_m2 += delta * (value - m_mean);
+        }
+        m_window[m_head] = value;
+        ++m_count;
+        if (++m_head == period) {
+            m_head = 0;
+            // recomputed once per window so rounding errors of the replacements do not pile up
+            double sum = 0;
+            for (double v: m_window) {
+                sum += v;
+            }
+            m_mean = sum / static_cast<double>(period);
+            m_m2 = 0;
+            for (double v: m_window) {
+                m_m2 += (v - m_mean) * (v - m_mean);
+            }
+        }
+    }
+
+    void RollingVariance::revise(double value) {
+        if (m_count == 0) {
+            update(value);
+            return;
+        }
+        size_t last = (m_head == 0 ? m_window.size() : m_head) - 1;
+        replace(m_window[last], value, std::min(m_count, m_window.size()));
+        m_window[last] = value;
+    }
+
+    double RollingVariance::variance() const {
+        size_t n = std::min(m_count, m_window.size());
+        return n == 0 ? 0 : m_m2 / static_cast<double>(n);
+    }
+
+    double RollingVariance::sample_variance() const {
+        size_t n = std::min(m_count, m_window.size());
+        return n < 2 ? 0 : m_m2 / static_cast<double>(n - 1);
+    }
+
+    double RollingVariance::stddev() const {
+        return std::sqrt(variance());
+    }
+
+    template<bool MAX>
+    RollingExtreme<MAX>::RollingExtreme(size_t period) : m_period(period) {
+        check_period(period);
+        m_deque.resize(period);
+    }
+
+    template<bool MAX>
+    size_t RollingExtreme<MAX>::slot(size_t offset) const {
+        size_t position = m_front + offset;
+        return position >= m_deque.size() ? position - m_deque.size() : position;
+    }
+
+    template<bool MAX>
+    void RollingExtreme<MAX>::update(price_t value) {
+        if (m_count > 0) {
+            // settle the last value: entries it beats can never be the extreme again
+            while (m_size > 0 && !better(m_deque[slot(m_size - 1)].value, m_last)) {
+                --m_size;
+            }
+            m_deque[slot(m_size)] = {m_count - 1, m_last};
+            ++m_size;
+        }
+        m_last = value;
+        ++m_count;
+        while (m_size > 0 && m_deque[m_front].index + m_period < m_count) {
+            m_front = slot(1);
+            --m_size;
+        }
+    }
+
+    template<bool MAX>
+    void RollingExtreme<MAX>::revise(price_t value) {
+        if (m_count == 0) {
+            update(value);
+            return;
+        }
+        m_last = value;
+    }
+
+    template<bool MAX>
+    price_t RollingExtreme<MAX>::value() const {
+        if (m_size == 0) {
+            return m_last;
+        }
+        price_t front = m_deque[m_front].value;
+        return better(front, m_last) ? front : m_last;
+    }
+
+    template class RollingExtreme<true>;
+
+    template class RollingExtreme<false>;
+
+    Donchian::Donchian(size_t period) : m_upper(period), m_lower(period) {}
+
+    void Donchian::update(const Bar &bar) {
+        m_upper.update(bar);
+        m_lower.update(bar);
+    }
+
+    void Donchian::revise(const Bar &bar) {
+        m_upper.revise(bar);
+        m_lower.revise(bar);
+    }
+
+    VWAP::VWAP(size_t period) {
+        check_period(period);
+        m_value.resize(period);
+        m_volume.resize(period);
+    }
+
+    void VWAP::update(const Bar &bar) {
+        const size_t period = m_value.size();
+        if (m_count >= period) {
+            m_sum_value -= m_value[m_head];
+            m_sum_volume -= m_volume[m_head];
+        }
+        m_typical = typical_price(bar);
+        m_value[m_head] = m_typical * static_cast<double>(bar.volume);
+        m_volume[m_head] = bar.volume;
+        m_sum_value += m_value[m_head];
+        m_sum_volume += bar.volume;
+        ++m_count;
+        if (++m_head == period) {
+            m_head = 0;
+            m_sum_value = 0;
+            for (double v: m_value) {
+                m_sum_value += v;
+            }
+        }
+    }
+
+    void VWAP::revise(const Bar &bar) {
+        if (m_count == 0) {
+            update(bar);
+            return;
+        }
+        size_t last = (m_head == 0 ? m_value.size() : m_head) - 1;
+        m_typical = typical_price(bar);
+        double value = m_typical * static_cast<double>(bar.volume);
+        m_sum_value += value - m_value[last];
+        m_sum_volume = m_sum_volume - m_volume[last] + bar.volume;
+        m_value[last] = value;
+        m_volume[last] = bar.volume;
+    }
+
+    price_t VWAP::value() const {
+        return m_sum_volume == 0 ? m_typical : m_sum_value / static_cast<double>(m_sum_volume);
+    }
+
+    SessionVWAP::SessionVWAP(trading::common::TimeZone zone) : m_zone(std::move(zone)) {}
+
+    void SessionVWAP::apply(const Bar &bar) {
+        int64_t day = m_zone.local_day(static_cast<int64_t>(bar.timestamp));
+        if (m_state.count == 0 || day != m_state.day) {
+            m_state = State{};
+            m_state.day = day;
+        }
+        m_state.typical = typical_price(bar);
+        m_state.value += m_state.typical * static_cast<double>(bar.volume);
+        m_state.volume += bar.volume;
+        ++m_state.count;
+    }
+
+    void SessionVWAP::update(const Bar &bar) {
+        m_previous = m_state;
+        apply(bar);
+    }
+
+    void SessionVWAP::revise(const Bar &bar) {
+        if (m_state.count == 0) {
+            update(bar);
+            return;
+        }
+        m_state = m_previous;
+        apply(bar);
+    }
+
+    void SessionVWAP::reset() {
+        m_state = State{};
+        m_previous = State{};
+    }
+
+    price_t SessionVWAP::value() const {
+        return m_state.volume == 0 ? m_state.typical : m_state.value / static_cast<double>(m_state.volume);
+    }
+
+    RealizedVolatility::RealizedVolatility(size_t period, double annualization)
+            : m_returns(period), m_annualization(annualization) {
+        if (period < 2) {
+            throw IndicatorException("Realized volatility needs a period of at least 2 returns");
+        }
+    }
+
+    void RealizedVolatility::update(price_t value) {
+        if (m_count > 0) {
+            m_returns.update(std::log(value / m_last));
+        }
+        m_before = m_last;
+        m_last = value;
+        ++m_count;
+    }
+
+    void RealizedVolatility::revise(price_t value) {
+        if (m_count == 0) {
+            update(value);
+            return;
+        }
+        if (m_count > 1) {
+            m_returns.revise(std::log(value / m_before));
+        }
+        m_last = value;
+    }
+
+    double RealizedVolatility::value() const {
+        return std::sqrt(m_returns.sample_variance() * m_annualization);
+    }
+
+}
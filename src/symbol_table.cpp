@@ -0,0 +1,89 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/symbol_table.h>
+
+#include <stdexcept>
+
+namespace trading::common {
+
+    SymbolTable &SymbolTable::global() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable::SymbolTable() : m_chunks(std::make_unique<std::atomic<Chunk *>[]>(MAX_CHUNKS)) {
+        intern("");
+    }
+
+    SymbolTable::~SymbolTable() {
+        for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+            delete m_chunks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    symbol_id_t SymbolTable::intern(std::string_view name) {
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_ids.find(name);
+            if (it != m_ids.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+        size_t id = m_size.load(std::memory_order_relaxed);
+        size_t chunk_index = id >> CHUNK_BITS;
+        if (chunk_index >= MAX_CHUNKS) {
+            throw std::length_error("SymbolTable is full");
+        }
+        Chunk *chunk = m_chunks[chunk_index].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = new Chunk();
+            m_chunks[chunk_index].store(chunk, std::memory_order_release);
+        }
+        std::string &slot = (*chunk)[id & (CHUNK_SIZE - 1)];
+        slot.assign(name);
+        // the view points into the slot, which never moves
+        m_ids.emplace(slot, static_cast<symbol_id_t>(id));
+        m_size.store(id + 1, std::memory_order_release);
+        return static_cast<symbol_id_t>(id);
+    }
+
+    std::optional<symbol_id_t> SymbolTable::find(std::string_view name) const {
+        std::shared_lock lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it == m_ids.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    const std::string &SymbolTable::name(symbol_id_t id) const {
+        static const std::string empty;
+        if (id >= m_size.load(std::memory_order_acquire)) {
+            return empty;
+        }
+        const Chunk *chunk = m_chunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+        return (*chunk)[id & (CHUNK_SIZE - 1)];
+    }
+
+    size_t SymbolTable::size() const {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    InternedSymbol::InternedSymbol(const std::shared_ptr<std::string> &name)
+            : m_id(name ? SymbolTable::global().intern(*name) : NULL_ID) {}
+
+    InternedSymbol::InternedSymbol(std::string_view name) : m_id(SymbolTable::global().intern(name)) {}
+
+    const std::string &InternedSymbol::str() const {
+        return SymbolTable::global().name(m_id);
+    }
+
+}
@@ -0,0 +1,374 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+#include <trading_common/wire_format.h>
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace trading::common::wire {
+
+    namespace {
+        constexpr uint8_t DOUBLE_PRICES = 255;
+
+        template<typename P>
+        constexpr uint8_t price_format() {
+            if constexpr (std::is_floating_point_v<P>) {
+                return DOUBLE_PRICES;
+            } else {
+                return P::DECIMAL_PLACES;
+            }
+        }
+
+        template<typename P>
+        uint64_t price_bits(P price) {
+            if constexpr (std::is_floating_point_v<P>) {
+                return std::bit_cast<uint64_t>(static_cast<double>(price));
+            } else {
+                return static_cast<uint64_t>(price.ticks());
+            }
+        }
+
+        template<typename P>
+        P price_from_bits(uint64_t bits) {
+            if constexpr (std::is_floating_point_v<P>) {
+                return std::bit_cast<double>(bits);
+            } else {
+                return P::from_ticks(static_cast<int64_t>(bits));
+            }
+        }
+
+        class Writer {
+        private:
+            unsigned char *m_out;
+
+        public:
+            explicit Writer(unsigned char *out) : m_out(out) {}
+
+            // unsigned integer of 1, 2, 4 or 8 bytes
+            template<typename T>
+            void put(T value) {
+                static_assert(std::is_unsigned_v<T>);
+                if constexpr (std::endian::native == std::endian::little) {
+                    std::memcpy(m_out, &value, sizeof(T));
+                } else {
+                    for (size_t i = 0; i < sizeof(T); ++i) {
+                        m_out[i] = static_cast<unsigned char>(value >> (8 * i));
+                    }
+                }
+                m_out += sizeof(T);
+            }
+
+            void put(std::string_view text) {
+                std::memcpy(m_out, text.data(), text.size());
+                m_out += text.size();
+            }
+
+            // formats a generated id straight into the message
+            void put(const Id &id) {
+                m_out = reinterpret_cast<unsigned char *>(id.format(reinterpret_cast<char *>(m_out)));
+            }
+        };
+
+        class Reader {
+        private:
+            const unsigned char *m_in;
+
+        public:
+            explicit Reader(const unsigned char *in) : m_in(in) {}
+
+            template<typename T>
+            T get() {
+                static_assert(std::is_unsigned_v<T>);
+                T value = 0;
+                if constexpr (std::endian::native == std::endian::little) {
+                    std::memcpy(&value, m_in, sizeof(T));
+                } else {
+                    for (size_t i = 0; i < sizeof(T); ++i) {
+                        value |= static_cast<T>(static_cast<T>(m_in[i]) << (8 * i));
+                    }
+                }
+                m_in += sizeof(T);
+                return value;
+            }
+
+            std::string_view text(size_t length) {
+                std::string_view view(reinterpret_cast<const char *>(m_in), length);
+                m_in += length;
+                return view;
+            }
+        };
+
+        // size of the fixed fields of each kind, after the header
+        constexpr size_t OHLCV_FIELDS = 6 * 8 + 2;
+        constexpr size_t ORDER_FIELDS = 5 * 8 + 3 + 2 * 2;
+        constexpr size_t POSITION_FIELDS = 5 * 8 + 1 + 2 * 2;
+
+        uint16_t string_length(size_t length, const char *what) {
+            if (length > UINT16_MAX) {
+                throw OHLCException(std::string(what) + " too long for the wire format");
+            }
+            return static_cast<uint16_t>(length);
+        }
+
+        uint16_t symbol_length(size_t length) {
+            if (length > MAX_SYMBOL_LENGTH) {
+                throw OHLCException("Symbol too long for the wire format");
+            }
+            return static_cast<uint16_t>(length);
+        }
+
+        Writer start(std::span<unsigned char> buffer, size_t size, Kind kind, uint8_t format) {
+            if (buffer.size() < size) {
+                throw OHLCException("Buffer too small for the message");
+            }
+            Writer writer(buffer.data());
+            writer.put(static_cast<uint8_t>(kind));
+            writer.put(VERSION);
+            writer.put(format);
+            writer.put(uint8_t{0});
+            writer.put(static_cast<uint32_t>(size));
+            return writer;
+        }
+
+        // Checks the header and returns a reader over the fields
+        Reader open(std::span<const unsigned char> buffer, Kind kind, uint8_t format, size_t fields, size_t &size) {
+            size = message_size(buffer);
+            if (buffer[0] != static_cast<uint8_t>(kind)) {
+                throw OHLCException("Wire message of another kind");
+            }
+            if (buffer[2] != format) {
+                throw OHLCException("Wire message with another price format");
+            }
+            if (size < HEADER_SIZE + fields) {
+                throw OHLCException("Wire message too short");
+            }
+            return Reader(buffer.data() + HEADER_SIZE);
+        }
+
+        void check_strings(size_t size, size_t fields, size_t strings) {
+            if (HEADER_SIZE + fields + strings != size) {
+                throw OHLCException("Wire message strings do not match its size");
+            }
+        }
+
+        template<typename E>
+        E get_enum(Reader &reader, E last) {
+            auto value = reader.get<uint8_t>();
+            if (value > static_cast<uint8_t>(last)) {
+                throw OHLCException("Wire message with an invalid enum value");
+            }
+            return static_cast<E>(value);
+        }
+
+        // interning is a table lookup, skipped when the symbol is the one the object already has
+        symbol_t read_symbol(const symbol_t &current, std::string_view name) {
+            if (current && current.view() == name) {
+                return current;
+            }
+            try {
+                return symbol_t(name);
+            } catch (const std::length_error &) {
+                throw OHLCException("Symbol table full, wire message symbol not interned");
+            }
+        }
+    }
+
+    Kind peek(std::span<const unsigned char> buffer) {
+        // checks the header
+        [[maybe_unused]] size_t size = message_size(buffer);
+        return static_cast<Kind>(buffer[0]);
+    }
+
+    size_t message_size(std::span<const unsigned char> buffer) {
+        if (buffer.size() < HEADER_SIZE) {
+            throw OHLCException("Wire message too short");
+        }
+        if (buffer[1] != VERSION) {
+            throw OHLCException("Unsupported wire format version " + std::to_string(buffer[1]));
+        }
+        if (buffer[3] != 0) {
+            throw OHLCException("Wire message with a reserved header byte set");
+        }
+        Reader reader(buffer.data() + 4);
+        auto size = reader.get<uint32_t>();
+        if (size > buffer.size()) {
+            throw OHLCException("Wire message truncated");
+        }
+        return size;
+    }
+
+    size_t encoded_size(const OHLCV &ohlcv) {
+        return HEADER_SIZE + OHLCV_FIELDS + ohlcv.symbol.view().size();
+    }
+
+    size_t encode(const OHLCV &ohlcv, std::span<unsigned char> buffer) {
+        std::string_view symbol = ohlcv.symbol.view();
+        uint16_t length = symbol_length(symbol.size());
+        size_t size = encoded_size(ohlcv);
+        Writer writer = start(buffer, size, Kind::OHLCV, DOUBLE_PRICES);
+        writer.put(static_cast<uint64_t>(ohlcv.timestamp));
+        writer.put(price_bits(ohlcv.open));
+        writer.put(price_bits(ohlcv.high));
+        writer.put(price_bits(ohlcv.low));
+        writer.put(price_bits(ohlcv.close));
+        writer.put(static_cast<uint64_t>(ohlcv.volume));
+        writer.put(length);
+        writer.put(symbol);
+        return size;
+    }
+
+    size_t decode(std::span<const unsigned char> buffer, OHLCV &ohlcv) {
+        size_t size = 0;
+        Reader reader = open(buffer, Kind::OHLCV, DOUBLE_PRICES, OHLCV_FIELDS, size);
+        // everything is read and checked before the bar is touched, so a bad message leaves it as it was
+        auto timestamp = reader.get<uint64_t>();
+        auto open = price_from_bits<double>(reader.get<uint64_t>());
+        auto high = price_from_bits<double>(reader.get<uint64_t>());
+        auto low = price_from_bits<double>(reader.get<uint64_t>());
+        auto close = price_from_bits<double>(reader.get<uint64_t>());
+        auto volume = reader.get<uint64_t>();
+        auto length = reader.get<uint16_t>();
+        check_strings(size, OHLCV_FIELDS, length);
+        symbol_t symbol = read_symbol(ohlcv.symbol, reader.text(symbol_length(length)));
+
+        ohlcv.timestamp = timestamp;
+        ohlcv.date.clear();
+        ohlcv.open = open;
+        ohlcv.high = high;
+        ohlcv.low = low;
+        ohlcv.close = close;
+        ohlcv.volume = volume;
+        ohlcv.symbol = symbol;
+        return size;
+    }
+
+    template<typename P>
+    size_t encoded_size(const trading::order::BasicOrder<P> &order) {
+        return HEADER_SIZE + ORDER_FIELDS + order.symbol.view().size() + order.id.size();
+    }
+
+    template<typename P>
+    size_t encode(const trading::order::BasicOrder<P> &order, std::span<unsigned char> buffer) {
+        std::string_view symbol = order.symbol.view();
+        uint16_t length = symbol_length(symbol.size());
+        uint16_t id_length = string_length(order.id.size(), "Order id");
+        size_t size = encoded_size(order);
+        Writer writer = start(buffer, size, Kind::ORDER, price_format<P>());
+        writer.put(static_cast<uint64_t>(order.timestamp));
+        writer.put(static_cast<uint64_t>(order.quantity));
+        writer.put(static_cast<uint64_t>(order.filled));
+        writer.put(price_bits(order.filled_at_price));
+        writer.put(price_bits(order.limit_price));
+        writer.put(static_cast<uint8_t>(order.side));
+        writer.put(static_cast<uint8_t>(order.type));
+        writer.put(static_cast<uint8_t>(order.status));
+        writer.put(length);
+        writer.put(id_length);
+        writer.put(symbol);
+        writer.put(order.id);
+        return size;
+    }
+
+    template<typename P>
+    size_t decode(std::span<const unsigned char> buffer, trading::order::BasicOrder<P> &order) {
+        size_t size = 0;
+        Reader reader = open(buffer, Kind::ORDER, price_format<P>(), ORDER_FIELDS, size);
+        auto timestamp = reader.get<uint64_t>();
+        auto quantity = reader.get<uint64_t>();
+        auto filled = reader.get<uint64_t>();
+        auto filled_at_price = price_from_bits<P>(reader.get<uint64_t>());
+        auto limit_price = price_from_bits<P>(reader.get<uint64_t>());
+        auto side = get_enum(reader, trading::order::Side::SELL);
+        auto type = get_enum(reader, trading::order::Type::LIMIT);
+        auto status = get_enum(reader, trading::order::Status::CANCELED);
+        auto length = reader.get<uint16_t>();
+        auto id_length = reader.get<uint16_t>();
+        check_strings(size, ORDER_FIELDS, length + id_length);
+        symbol_t symbol = read_symbol(order.symbol, reader.text(symbol_length(length)));
+        std::string_view id = reader.text(id_length);
+
+        order.timestamp = timestamp;
+        order.quantity = quantity;
+        order.filled = filled;
+        order.filled_at_price = filled_at_price;
+        order.limit_price = limit_price;
+        order.side = side;
+        order.type = type;
+        order.status = status;
+        order.symbol = symbol;
+        order.id.assign(id);
+        return size;
+    }
+
+    template<typename P>
+    size_t encoded_size(const trading::position::BasicPosition<P> &position) {
+        return HEADER_SIZE + POSITION_FIELDS + position.symbol.view().size() + position.id.size();
+    }
+
+    template<typename P>
+    size_t encode(const trading::position::BasicPosition<P> &position, std::span<unsigned char> buffer) {
+        std::string_view symbol = position.symbol.view();
+        uint16_t length = symbol_length(symbol.size());
+        uint16_t id_length = string_length(position.id.size(), "Position id");
+        size_t size = encoded_size(position);
+        Writer writer = start(buffer, size, Kind::POSITION, price_format<P>());
+        writer.put(static_cast<uint64_t>(position.timestamp));
+        writer.put(static_cast<uint64_t>(position.balance));
+        writer.put(price_bits(position.entry_price));
+        writer.put(price_bits(position.current_price));
+        writer.put(price_bits(position.pnl));
+        writer.put(static_cast<uint8_t>(position.side));
+        writer.put(length);
+        writer.put(id_length);
+        writer.put(symbol);
+        writer.put(position.id);
+        return size;
+    }
+
+    template<typename P>
+    size_t decode(std::span<const unsigned char> buffer, trading::position::BasicPosition<P> &position) {
+        size_t size = 0;
+        Reader reader = open(buffer, Kind::POSITION, price_format<P>(), POSITION_FIELDS, size);
+        auto timestamp = reader.get<uint64_t>();
+        auto balance = reader.get<uint64_t>();
+        auto entry_price = price_from_bits<P>(reader.get<uint64_t>());
+        auto current_price = price_from_bits<P>(reader.get<uint64_t>());
+        auto pnl = price_from_bits<P>(reader.get<uint64_t>());
+        auto side = get_enum(reader, trading::position::Side::SHORT);
+        auto length = reader.get<uint16_t>();
+        auto id_length = reader.get<uint16_t>();
+        check_strings(size, POSITION_FIELDS, length + id_length);
+        symbol_t symbol = read_symbol(position.symbol, reader.text(symbol_length(length)));
+        std::string_view id = reader.text(id_length);
+
+        position.timestamp = timestamp;
+        position.balance = balance;
+        position.entry_price = entry_price;
+        position.current_price = current_price;
+        position.pnl = pnl;
+        position.side = side;
+        position.symbol = symbol;
+        position.id.assign(id);
+        return size;
+    }
+
+#define TRADING_COMMON_WIRE_INSTANTIATE(P)                                                                     \
+    template size_t encoded_size(const trading::order::BasicOrder<P> &);                                      \
+    template size_t encode(const trading::order::BasicOrder<P> &, std::span<unsigned char>);                  \
+    template size_t decode(std::span<const unsigned char>, trading::order::BasicOrder<P> &);                  \
+    template size_t encoded_size(const trading::position::BasicPosition<P> &);                                \
+    template size_t encode(const trading::position::BasicPosition<P> &, std::span<unsigned char>);            \
+    template size_t decode(std::span<const unsigned char>, trading::position::BasicPosition<P> &);
+
+    TRADING_COMMON_WIRE_INSTANTIATE(price_t)
+    TRADING_COMMON_WIRE_INSTANTIATE(FixedPrice<2>)
+    TRADING_COMMON_WIRE_INSTANTIATE(FixedPrice<4>)
+    TRADING_COMMON_WIRE_INSTANTIATE(FixedPrice<8>)
+
+#undef TRADING_COMMON_WIRE_INSTANTIATE
+}
@@ -0,0 +1,156 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/aggregator.h"
+#include "nlohmann/json.hpp"
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+TEST_CASE("BarAggregator construction", "[BarAggregator]") {
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+
+    SECTION("Default timeframes") {
+        BarAggregator aggregator(symbol);
+        REQUIRE(aggregator.get_timeframes() == std::vector<timestamp_t>{1, 60, 300, 3600});
+        REQUIRE(aggregator.current(timeframes::MINUTE) == nullptr);
+    }
+
+    SECTION("Timeframes are sorted and deduplicated") {
+        BarAggregator aggregator(symbol, {60, 1, 60});
+        REQUIRE(aggregator.get_timeframes() == std::vector<timestamp_t>{1, 60});
+    }
+
+    SECTION("Invalid timeframes") {
+        REQUIRE_THROWS_AS(BarAggregator(symbol, {}), OHLCException);
+        REQUIRE_THROWS_AS(BarAggregator(symbol, {0, 60}), OHLCException);
+    }
+}
+
+TEST_CASE("BarAggregator builds bars from ticks", "[BarAggregator]") {
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    BarAggregator aggregator(symbol, {timeframes::MINUTE, timeframes::FIVE_MINUTES});
+    std::vector<std::pair<timestamp_t, BarAggregator::Bar>> emitted;
+    aggregator.on_bar([&](timestamp_t timeframe, const BarAggregator::Bar &bar) {
+        emitted.emplace_back(timeframe, bar);
+    });
+
+    SECTION("Updating the open bar") {
+        REQUIRE(aggregator.add(1704495600, 10.0, 5));
+        REQUIRE(aggregator.add(1704495610, 12.0, 1));
+        REQUIRE(aggregator.add(1704495620, 9.0, 2));
+        REQUIRE(aggregator.add(Tick{1704495659, 11.0, 3}));
+        REQUIRE(emitted.empty());
+
+        const auto *bar = aggregator.current(timeframes::MINUTE);
+        REQUIRE(bar != nullptr);
+        REQUIRE(bar->timestamp == 1704495600);
+        REQUIRE(bar->open == 10.0);
+        REQUIRE(bar->high == 12.0);
+        REQUIRE(bar->low == 9.0);
+        REQUIRE(bar->close == 11.0);
+        REQUIRE(bar->volume == 11);
+    }
+
+    SECTION("Completed bars are emitted once") {
+        aggregator.add(1704495600, 10.0, 5);
+        aggregator.add(1704495661, 11.0, 1);
+        REQUIRE(emitted.size() == 1);
+        REQUIRE(emitted[0].first == timeframes::MINUTE);
+        REQUIRE(emitted[0].second.close == 10.0);
+
+        // a gap of several minutes closes both timeframes and leaves no empty bars
+        aggregator.add(1704496200, 12.0, 1);
+        REQUIRE(emitted.size() == 3);
+        REQUIRE(emitted[1].first == timeframes::MINUTE);
+        REQUIRE(emitted[1].second.timestamp == 1704495660);
+        REQUIRE(emitted[2].first == timeframes::FIVE_MINUTES);
+        REQUIRE(emitted[2].second.timestamp == 1704495600);
+        REQUIRE(emitted[2].second.high == 11.0);
+        REQUIRE(emitted[2].second.volume == 6);
+    }
+
+    SECTION("Late ticks are rejected") {
+        aggregator.add(1704495661, 11.0, 1);
+        REQUIRE_FALSE(aggregator.add(1704495600, 10.0, 5));
+        REQUIRE(aggregator.rejected() == 1);
+        REQUIRE(aggregator.current(timeframes::MINUTE)->volume == 1);
+    }
+
+    SECTION("Flush emits the open bars") {
+        aggregator.add(1704495600, 10.0, 5);
+        aggregator.flush();
+        REQUIRE(emitted.size() == 2);
+        REQUIRE(aggregator.current(timeframes::MINUTE) == nullptr);
+    }
+
+    SECTION("A flush does not reopen the emitted buckets") {
+        aggregator.add(1704495600, 10.0, 5);
+        aggregator.flush();
+        REQUIRE_FALSE(aggregator.add(1704495630, 11.0, 1));
+        REQUIRE(aggregator.rejected() == 1);
+
+        // the next minute opens, its five minutes were already emitted
+        REQUIRE(aggregator.add(1704495660, 12.0, 1));
+        REQUIRE(aggregator.current(timeframes::MINUTE)->timestamp == 1704495660);
+        REQUIRE(aggregator.current(timeframes::FIVE_MINUTES) == nullptr);
+        REQUIRE(aggregator.truncated() == 1);
+        aggregator.flush();
+        REQUIRE(emitted.size() == 3);
+        REQUIRE(emitted[2].first == timeframes::MINUTE);
+
+        REQUIRE(aggregator.add(1704495900, 13.0, 1));
+        REQUIRE(aggregator.current(timeframes::FIVE_MINUTES)->timestamp == 1704495900);
+    }
+
+    SECTION("Flushing up to a time keeps the buckets that have not ended and conserves volume") {
+        aggregator.add(1704495600, 10.0, 5);
+        aggregator.add(1704495630, 11.0, 2);
+        aggregator.flush(1704495660);
+        REQUIRE(emitted.size() == 1);
+        REQUIRE(emitted[0].first == timeframes::MINUTE);
+        REQUIRE(aggregator.current(timeframes::MINUTE) == nullptr);
+        REQUIRE(aggregator.current(timeframes::FIVE_MINUTES)->volume == 7);
+
+        // the rest of the five minutes still reaches both timeframes
+        REQUIRE(aggregator.add(1704495670, 14.0, 3));
+        REQUIRE(aggregator.add(1704495910, 9.0, 4));
+        aggregator.flush();
+        REQUIRE(aggregator.truncated() == 0);
+
+        size_t minutes = 0;
+        size_t five_minutes = 0;
+        for (const auto &[timeframe, bar]: emitted) {
+            (timeframe == timeframes::MINUTE ? minutes : five_minutes) += bar.volume;
+        }
+        REQUIRE(minutes == 14);
+        REQUIRE(five_minutes == 14);
+        REQUIRE(emitted[2].first == timeframes::FIVE_MINUTES);
+        REQUIRE(emitted[2].second.high == 14.0);
+        REQUIRE(emitted[2].second.volume == 10);
+    }
+}
+
+TEST_CASE("BarAggregator into SeriesOHLCV", "[BarAggregator]") {
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    BarAggregator aggregator(symbol, {timeframes::MINUTE});
+    SeriesOHLCV series;
+    aggregator.emit_into(timeframes::MINUTE, series);
+    REQUIRE_THROWS_AS(aggregator.emit_into(timeframes::HOUR, series), OHLCException);
+
+    for (timestamp_t t = 0; t < 600; t += 10) {
+        aggregator.add(1704495600 + t, 100.0 + (double) t, 1);
+    }
+    aggregator.flush();
+
+    REQUIRE(series.size() == 10);
+    auto &bar = series[1704495660];
+    REQUIRE(*bar.symbol == "AAPL");
+    REQUIRE(bar.open == 160.0);
+    REQUIRE(bar.close == 210.0);
+    REQUIRE(bar.volume == 6);
+}
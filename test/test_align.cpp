@@ -0,0 +1,163 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/align.h"
+#include <random>
+#include <set>
+
+using namespace trading::common;
+
+namespace {
+    // bars at random multiples of a minute, so the series only partly overlap
+    ColumnarSeriesOHLCV random_series(const std::string &name, size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution present(0.7);
+        ColumnarSeriesOHLCV series{symbol_t(name)};
+        timestamp_t t = 1000 + 60 * (seed % 5);
+        for (size_t i = 0; i < count; ++i, t += 60) {
+            if (present(rng)) {
+                double close = static_cast<double>(seed * 1000 + i);
+                series.insert(ColumnarSeriesOHLCV::Bar{t, close - 1, close + 2, close - 2, close, i + 1});
+            }
+        }
+        return series;
+    }
+
+    // grid built with find() probes into every series, the way it was done by hand
+    std::vector<timestamp_t> naive_grid(const std::vector<ColumnarSeriesOHLCV> &series, AlignPolicy policy) {
+        std::set<timestamp_t> all;
+        timestamp_t start = 0;
+        for (const auto &s: series) {
+            all.insert(s.timestamps().begin(), s.timestamps().end());
+            start = std::max(start, s.timestamps().front());
+        }
+        std::vector<timestamp_t> grid;
+        for (timestamp_t t: all) {
+            bool everywhere = true;
+            for (const auto &s: series) {
+                everywhere = everywhere && s.find(t).has_value();
+            }
+            if (policy == AlignPolicy::DROP ? everywhere : t >= start) {
+                grid.push_back(t);
+            }
+        }
+        return grid;
+    }
+}
+
+TEST_CASE("Aligning series on a timestamp grid", "[AlignedSeries]") {
+    std::vector<ColumnarSeriesOHLCV> series;
+    std::vector<const ColumnarSeriesOHLCV *> pointers;
+    std::vector<ColumnsOHLCV> inputs;
+    for (unsigned s = 0; s < 6; ++s) {
+        series.push_back(random_series("S" + std::to_string(s), 300, s + 1));
+    }
+    for (const auto &s: series) {
+        pointers.push_back(&s);
+        inputs.push_back(s.columns());
+    }
+
+    for (auto policy: {AlignPolicy::FORWARD_FILL, AlignPolicy::DROP}) {
+        auto grid = naive_grid(series, policy);
+        REQUIRE(align_timestamps(inputs, policy) == grid);
+
+        for (size_t threads: {1, 4}) {
+            AlignedSeries aligned(pointers, policy, threads);
+            REQUIRE(aligned.width() == series.size());
+            REQUIRE(aligned.size() == grid.size());
+            for (size_t i = 0; i < series.size(); ++i) {
+                REQUIRE(aligned.symbol(i) == series[i].symbol());
+                auto columns = aligned.columns(i);
+                REQUIRE(columns.timestamp.data() == aligned.timestamps().data());
+                for (size_t r = 0; r < grid.size(); ++r) {
+                    auto exact = series[i].find(grid[r]);
+                    if (exact) {
+                        REQUIRE(columns.open[r] == exact->open);
+                        REQUIRE(columns.high[r] == exact->high);
+                        REQUIRE(columns.close[r] == exact->close);
+                        REQUIRE(columns.volume[r] == exact->volume);
+                    } else {
+                        REQUIRE(policy == AlignPolicy::FORWARD_FILL);
+                        auto previous = series[i].as_of(grid[r]);
+                        REQUIRE(columns.open[r] == previous->close);
+                        REQUIRE(columns.low[r] == previous->close);
+                        REQUIRE(columns.close[r] == previous->close);
+                        REQUIRE(columns.volume[r] == 0);
+                    }
+                }
+            }
+        }
+
+        SECTION("Cursor walks the same grid") {
+            AlignedSeries aligned(inputs, policy);
+            AlignmentCursor cursor(inputs, policy);
+            size_t row = 0;
+            while (cursor.next()) {
+                REQUIRE(cursor.timestamp() == aligned.timestamps()[row]);
+                REQUIRE(cursor.bars().size() == series.size());
+                for (size_t i = 0; i < series.size(); ++i) {
+                    REQUIRE(cursor.bar(i).timestamp == cursor.timestamp());
+                    REQUIRE(cursor.bar(i).close == aligned.columns(i).close[row]);
+                    REQUIRE(cursor.bar(i).volume == aligned.columns(i).volume[row]);
+                }
+                ++row;
+            }
+            REQUIRE(row == aligned.size());
+            REQUIRE_FALSE(cursor.next());
+        }
+    }
+}
+
+TEST_CASE("Aligning series edge cases", "[AlignedSeries]") {
+    ColumnarSeriesOHLCV a(symbol_t("A"), {100, 200, 300}, {1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {10, 20, 30});
+    ColumnarSeriesOHLCV b(symbol_t("B"), {150, 300, 400}, {5, 6, 7}, {5, 6, 7}, {5, 6, 7}, {5, 6, 7}, {50, 60, 70});
+    ColumnarSeriesOHLCV empty(symbol_t("E"));
+
+    SECTION("Forward fill starts once every series has a bar") {
+        AlignedSeries aligned(std::vector<const ColumnarSeriesOHLCV *>{&a, &b});
+        REQUIRE(std::vector<timestamp_t>(aligned.timestamps().begin(), aligned.timestamps().end()) ==
+                std::vector<timestamp_t>{150, 200, 300, 400});
+        // A at 150 is filled from its bar at 100, which is before the grid
+        REQUIRE(aligned.columns(0).close[0] == 1);
+        REQUIRE(aligned.columns(0).close[3] == 3);
+        REQUIRE(aligned.columns(1).close[1] == 5);
+        auto columnar = aligned.to_columnar(1);
+        REQUIRE(*columnar.symbol() == "B");
+        REQUIRE(columnar.size() == 4);
+        REQUIRE(columnar.volume()[1] == 0);
+    }
+
+    SECTION("Drop keeps the common timestamps") {
+        AlignedSeries aligned(std::vector<const ColumnarSeriesOHLCV *>{&a, &b}, AlignPolicy::DROP);
+        REQUIRE(aligned.size() == 1);
+        REQUIRE(aligned.timestamps()[0] == 300);
+        REQUIRE(aligned.columns(1).volume[0] == 60);
+    }
+
+    SECTION("An empty series gives an empty grid") {
+        AlignedSeries aligned(std::vector<const ColumnarSeriesOHLCV *>{&a, &empty});
+        REQUIRE(aligned.empty());
+        REQUIRE(aligned.width() == 2);
+        REQUIRE(aligned.columns(1).empty());
+        AlignmentCursor cursor({a.columns(), empty.columns()});
+        REQUIRE_FALSE(cursor.next());
+    }
+
+    SECTION("From SeriesOHLCV") {
+        SeriesOHLCV first = a.to_series();
+        SeriesOHLCV second = b.to_series();
+        AlignedSeries aligned(std::vector<const SeriesOHLCV *>{&first, &second}, AlignPolicy::DROP, 2);
+        REQUIRE(aligned.size() == 1);
+        REQUIRE(*aligned.symbol(0) == "A");
+        REQUIRE(aligned.columns(0).close[0] == 3);
+    }
+
+    SECTION("Bad arguments") {
+        std::vector<ColumnsOHLCV> inputs{a.columns(), b.columns()};
+        REQUIRE_THROWS_AS(AlignedSeries(inputs, AlignPolicy::DROP, 1, {symbol_t("A")}), OHLCException);
+        REQUIRE_THROWS_AS(AlignedSeries(inputs).columns(2), std::out_of_range);
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/binary_series.h"
+#include "nlohmann/json.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+namespace {
+    std::string temp_path(const std::string &name) {
+        return (std::filesystem::temp_directory_path() / ("trading_common_" + name)).string();
+    }
+}
+
+TEST_CASE("Binary series round trip", "[MappedSeriesOHLCV]") {
+    ColumnarSeriesOHLCV series(std::make_shared<std::string>("AAPL"));
+    for (size_t i = 0; i < 1000; ++i) {
+        series.insert(ColumnarSeriesOHLCV::Bar{1704495600 + i * 60, 1.0 + (double) i, 2.0 + (double) i,
+                                               0.5 + (double) i, 1.5 + (double) i, i * 10});
+    }
+    auto path = temp_path("round_trip.bin");
+    write_binary(path, series);
+
+    SECTION("Mapped columns match the written series") {
+        MappedSeriesOHLCV mapped(path);
+        REQUIRE(mapped.size() == 1000);
+        REQUIRE(*mapped.symbol() == "AAPL");
+        auto columns = mapped.columns();
+        REQUIRE(std::equal(columns.timestamp.begin(), columns.timestamp.end(), series.timestamps().begin()));
+        REQUIRE(std::equal(columns.close.begin(), columns.close.end(), series.close().begin()));
+        REQUIRE(std::equal(columns.volume.begin(), columns.volume.end(), series.volume().begin()));
+        REQUIRE(mapped.to_columnar().to_json() == series.to_json());
+    }
+
+    SECTION("Range queries over the mapped file") {
+        MappedSeriesOHLCV mapped(path);
+        auto range = mapped.range(1704495600 + 10 * 60, 1704495600 + 20 * 60);
+        REQUIRE(range.size() == 10);
+        REQUIRE(range.timestamp.front() == 1704495600 + 10 * 60);
+        REQUIRE(range.open.front() == 11.0);
+        REQUIRE(mapped.range(0, 1000).empty());
+        REQUIRE(mapped.range(1704495600 + 999 * 60, 1804495600).size() == 1);
+    }
+
+    SECTION("Iterating over the mapped file") {
+        MappedSeriesOHLCV mapped(path);
+        size_t count = 0;
+        for (auto it = mapped.begin(); it != mapped.end(); ++it) {
+            const auto &[timestamp, bar] = *it;
+            REQUIRE(timestamp == 1704495600 + count * 60);
+            ++count;
+        }
+        REQUIRE(count == 1000);
+    }
+
+    SECTION("Moving a mapped series") {
+        MappedSeriesOHLCV mapped(path);
+        MappedSeriesOHLCV moved(std::move(mapped));
+        REQUIRE(mapped.empty());
+        REQUIRE(moved.size() == 1000);
+        mapped = std::move(moved);
+        REQUIRE(mapped.size() == 1000);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary series errors", "[MappedSeriesOHLCV]") {
+    SECTION("Missing file") {
+        REQUIRE_THROWS_AS(MappedSeriesOHLCV(temp_path("missing.bin")), OHLCException);
+    }
+
+    SECTION("Not a binary series") {
+        auto path = temp_path("invalid.bin");
+        std::ofstream(path) << std::string(256, 'x');
+        REQUIRE_THROWS_AS(MappedSeriesOHLCV(path), OHLCException);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Truncated file") {
+        ColumnarSeriesOHLCV series;
+        series.insert(ColumnarSeriesOHLCV::Bar{100, 1, 2, 0.5, 1.5, 10});
+        auto path = temp_path("truncated.bin");
+        write_binary(path, series);
+        std::filesystem::resize_file(path, sizeof(BinarySeriesHeader) + 8);
+        REQUIRE_THROWS_AS(MappedSeriesOHLCV(path), OHLCException);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Empty series") {
+        auto path = temp_path("empty.bin");
+        write_binary(path, ColumnarSeriesOHLCV());
+        MappedSeriesOHLCV mapped(path);
+        REQUIRE(mapped.empty());
+        REQUIRE(mapped.symbol()->empty());
+        std::filesystem::remove(path);
+    }
+}
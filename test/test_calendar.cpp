@@ -0,0 +1,196 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/calendar.h"
+#include "trading_common/ohlc.h"
+#include <ctime>
+#include <random>
+
+using namespace trading::common;
+
+namespace {
+    // offset of the zone at the instant according to the C library
+    long libc_offset(const char *zone, int64_t utc) {
+        setenv("TZ", zone, 1);
+        tzset();
+        auto time = static_cast<std::time_t>(utc);
+        std::tm tm{};
+        localtime_r(&time, &tm);
+        return tm.tm_gmtoff;
+    }
+}
+
+TEST_CASE("Civil date arithmetic", "[Calendar]") {
+    STATIC_REQUIRE(days_from_civil(1970, 1, 1) == 0);
+    STATIC_REQUIRE(days_from_civil(2000, 3, 1) == 11017);
+    STATIC_REQUIRE(days_from_civil(1969, 12, 31) == -1);
+    STATIC_REQUIRE(civil_from_days(19728) == CivilDate{2024, 1, 6});
+    STATIC_REQUIRE(weekday_from_days(0) == 4);
+    STATIC_REQUIRE(weekday_from_days(-1) == 3);
+
+    SECTION("Round trip") {
+        for (int64_t day = -800000; day < 800000; day += 17) {
+            REQUIRE(days_from_civil(civil_from_days(day)) == day);
+        }
+    }
+
+    SECTION("Formatting") {
+        char text[10];
+        format_civil({2024, 1, 6}, text);
+        REQUIRE(std::string(text, 10) == "2024-01-06");
+        format_civil({987, 12, 31}, text);
+        REQUIRE(std::string(text, 10) == "0987-12-31");
+    }
+
+    SECTION("Parsing") {
+        REQUIRE(parse_civil("2024-02-29") == CivilDate{2024, 2, 29});
+        REQUIRE_FALSE(parse_civil("2023-02-29"));
+        REQUIRE_FALSE(parse_civil("2024-13-01"));
+        REQUIRE_FALSE(parse_civil("2024-1-06"));
+        REQUIRE_FALSE(parse_civil("2024/01/06"));
+        REQUIRE_FALSE(parse_civil("2024-01-06 "));
+    }
+}
+
+TEST_CASE("Time zones", "[Calendar]") {
+    SECTION("UTC and fixed offsets") {
+        auto utc = TimeZone::utc();
+        REQUIRE(utc.offset(1704495600) == 0);
+        REQUIRE(format_date(1704495600, utc) == "2024-01-05");
+
+        auto tokyo = TimeZone::fixed(9 * 3600, "JST");
+        REQUIRE(tokyo.offset(0) == 9 * 3600);
+        REQUIRE(format_date(1704495600, tokyo) == "2024-01-06");
+        REQUIRE(tokyo.midnight(days_from_civil(2024, 1, 6)) == 1704466800);
+    }
+
+    SECTION("POSIX rule") {
+        auto madrid = TimeZone::posix("CET-1CEST,M3.5.0,M10.5.0/3");
+        REQUIRE(madrid.offset(1704495600) == 3600);
+        // 2024-03-31 01:00 UTC is the switch to summer time
+        REQUIRE(madrid.offset(1711846799) == 3600);
+        REQUIRE(madrid.offset(1711846800) == 7200);
+        // 2024-10-27 01:00 UTC back to winter time
+        REQUIRE(madrid.offset(1729990799) == 7200);
+        REQUIRE(madrid.offset(1729990800) == 3600);
+
+        auto sydney = TimeZone::posix("AEST-10AEDT,M10.1.0,M4.1.0/3");
+        REQUIRE(sydney.offset(1704495600) == 11 * 3600);
+        REQUIRE(sydney.offset(1720000000) == 10 * 3600);
+
+        REQUIRE(TimeZone::posix("<-03>3").offset(0) == -3 * 3600);
+        REQUIRE_THROWS_AS(TimeZone::posix("Europe/Madrid"), CalendarException);
+    }
+
+    SECTION("Wall clock to UTC") {
+        auto madrid = TimeZone::posix("CET-1CEST,M3.5.0,M10.5.0/3");
+        int64_t day = days_from_civil(2024, 3, 31);
+        // 02:30 does not exist that day and moves past the gap
+        REQUIRE(madrid.from_local(day * SECONDS_PER_DAY + 2 * 3600 + 1800) == 1711848600);
+        // 02:30 on 2024-10-27 happens twice, the first one wins
+        day = days_from_civil(2024, 10, 27);
+        REQUIRE(madrid.from_local(day * SECONDS_PER_DAY + 2 * 3600 + 1800) == 1729989000);
+
+        auto bounds = madrid.day_bounds(1711900000);
+        REQUIRE(bounds.first == 1711839600);
+        REQUIRE(bounds.second - bounds.first == 23 * 3600);
+    }
+
+    SECTION("Zoneinfo files agree with the C library") {
+        const char *saved = std::getenv("TZ");
+        std::string previous = saved != nullptr ? saved : "";
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<int64_t> instant(-1000000000, 4000000000);
+        for (const char *name: {"Europe/Madrid", "America/New_York", "Australia/Sydney", "Asia/Kolkata"}) {
+            TimeZone zone = TimeZone::utc();
+            try {
+                zone = TimeZone::load(name);
+            } catch (CalendarException &) {
+                WARN("time zone data not installed: " << name);
+                continue;
+            }
+            for (int i = 0; i < 2000; ++i) {
+                int64_t t = instant(rng);
+                INFO(name << " at " << t);
+                REQUIRE(zone.offset(t) == libc_offset(name, t));
+            }
+        }
+        if (saved != nullptr) {
+            setenv("TZ", previous.c_str(), 1);
+        } else {
+            unsetenv("TZ");
+        }
+        tzset();
+        REQUIRE_THROWS_AS(TimeZone::load("Not/A_Zone"), CalendarException);
+        REQUIRE_THROWS_AS(TimeZone::load("../etc/passwd"), CalendarException);
+    }
+}
+
+TEST_CASE("Date strings", "[Calendar]") {
+    auto madrid = TimeZone::posix("CET-1CEST,M3.5.0,M10.5.0/3");
+
+    SECTION("Formatting uses the cached day") {
+        REQUIRE(format_date(1704495600, madrid) == "2024-01-06");
+        REQUIRE(format_date(1704495600 + 3600, madrid) == "2024-01-06");
+        REQUIRE(format_date(1704495600 - 1, madrid) == "2024-01-05");
+        REQUIRE(format_date(1704495600, TimeZone::utc()) == "2024-01-05");
+        REQUIRE(format_date(1704495600 + 86400, madrid) == "2024-01-07");
+    }
+
+    SECTION("Parsing gives local midnight") {
+        REQUIRE(parse_date("2024-01-06", madrid) == 1704495600);
+        // summer dates are midnight too, not one hour later
+        REQUIRE(parse_date("2024-07-01", madrid) == 1719784800);
+        REQUIRE_FALSE(parse_date("2024-02-30", madrid));
+    }
+
+    SECTION("OHLC helpers use the local zone") {
+        auto epoch = date_string_to_epoch("2024-01-06");
+        REQUIRE(epoch_to_date_string(static_cast<long long>(epoch)) == "2024-01-06");
+        REQUIRE(epoch_to_date_string(static_cast<long long>(epoch) * 1000) == "2024-01-06");
+        REQUIRE_THROWS_AS(date_string_to_epoch("06-01-2024"), OHLCException);
+    }
+}
+
+TEST_CASE("Trading calendar", "[Calendar]") {
+    auto new_york = TimeZone::posix("EST5EDT,M3.2.0,M11.1.0");
+    // 09:30 to 16:00, with 2024-01-15 a holiday
+    TradingCalendar calendar(new_york, 9 * 3600 + 1800, 16 * 3600, {2024, 1, 1}, {2024, 3, 31}, {{2024, 1, 15}});
+
+    SECTION("Weekends and holidays are skipped") {
+        REQUIRE(calendar.is_trading_day({2024, 1, 2}));
+        REQUIRE_FALSE(calendar.is_trading_day({2024, 1, 6}));
+        REQUIRE_FALSE(calendar.is_trading_day({2024, 1, 15}));
+        REQUIRE_FALSE(calendar.is_trading_day({2024, 4, 1}));
+        REQUIRE(calendar.sessions().size() == 64);
+    }
+
+    SECTION("Sessions follow the exchange clock") {
+        // 2024-01-02 14:30 UTC is 09:30 in New York
+        REQUIRE(calendar.is_open(1704205800));
+        REQUIRE_FALSE(calendar.is_open(1704205799));
+        REQUIRE_FALSE(calendar.is_open(1704229200));
+        // after the switch to summer time the session opens at 13:30 UTC
+        auto session = calendar.session_at(1710768600);
+        REQUIRE(session);
+        REQUIRE(session->open == 1710768600);
+        REQUIRE(format_date(session->open, new_york) == "2024-03-18");
+    }
+
+    SECTION("Next session") {
+        // friday after the close gives monday
+        auto next = calendar.next_session(1704488400);
+        REQUIRE(next);
+        REQUIRE(civil_from_days(next->day) == CivilDate{2024, 1, 8});
+        REQUIRE(calendar.next_session(1704465000)->day == days_from_civil(2024, 1, 5));
+        REQUIRE_FALSE(calendar.next_session(1800000000));
+    }
+
+    SECTION("Invalid sessions") {
+        REQUIRE_THROWS_AS(TradingCalendar(new_york, 16 * 3600, 9 * 3600, {2024, 1, 1}, {2024, 1, 2}),
+                          CalendarException);
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/clock.h"
+#include "trading_common/instructions.h"
+#include "trading_common/order.h"
+#include "trading_common/position.h"
+#include <cstdlib>
+#include <thread>
+
+using namespace trading::common;
+
+namespace {
+    struct Settings {
+        [[nodiscard]] json to_json() const { return json::object(); }
+
+        void from_json(const json &) {}
+
+        bool validate() { return true; }
+    };
+
+    bool near_system_time(int64_t ns, int64_t tolerance) {
+        return std::llabs(ns - system_now_ns()) < tolerance;
+    }
+}
+
+TEST_CASE("Clock sources", "[Clock]") {
+    constexpr int64_t MILLISECOND = 1'000'000;
+
+    SECTION("System") {
+        set_clock_source(ClockSource::SYSTEM);
+        REQUIRE(clock_source() == ClockSource::SYSTEM);
+        REQUIRE(near_system_time(now_ns(), 100 * MILLISECOND));
+        timestamp_t seconds = now_timestamp();
+        auto system_seconds = static_cast<timestamp_t>(system_now_ns() / 1'000'000'000);
+        REQUIRE((seconds == system_seconds || seconds + 1 == system_seconds));
+    }
+
+    SECTION("Coarse follows the system clock at its resolution") {
+        set_coarse_resolution(std::chrono::microseconds(500));
+        set_clock_source(ClockSource::COARSE);
+        int64_t first = now_ns();
+        REQUIRE(near_system_time(first, 100 * MILLISECOND));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(now_ns() > first);
+        REQUIRE(near_system_time(coarse_now_ns(), 100 * MILLISECOND));
+        set_clock_source(ClockSource::SYSTEM);
+    }
+
+    SECTION("The coarse clock does not sleep through a change of resolution") {
+        set_clock_source(ClockSource::COARSE);
+        set_coarse_resolution(std::chrono::hours(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int64_t before = now_ns();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(now_ns() == before);
+
+        set_coarse_resolution(std::chrono::microseconds(500));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(now_ns() > before);
+        set_clock_source(ClockSource::SYSTEM);
+    }
+
+    SECTION("TSC is monotonic and close to the system clock") {
+        set_clock_source(ClockSource::TSC);
+        int64_t previous = now_ns();
+        REQUIRE(near_system_time(previous, 100 * MILLISECOND));
+        bool monotonic = true;
+        for (int i = 0; i < 100'000; ++i) {
+            int64_t now = now_ns();
+            monotonic = monotonic && now >= previous;
+            previous = now;
+        }
+        REQUIRE(monotonic);
+        calibrate_tsc(std::chrono::milliseconds(1));
+        REQUIRE(near_system_time(tsc_now_ns(), 100 * MILLISECOND));
+        set_clock_source(ClockSource::SYSTEM);
+    }
+
+    SECTION("Simulated time only moves when told") {
+        set_simulated_time(1704495600LL * 1'000'000'000);
+        set_clock_source(ClockSource::SIMULATED);
+        REQUIRE(now_timestamp() == 1704495600);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        REQUIRE(now_ns() == 1704495600LL * 1'000'000'000);
+        advance_simulated_time(60LL * 1'000'000'000);
+        REQUIRE(now_timestamp() == 1704495660);
+        REQUIRE(simulated_now_ns() == now_ns());
+        set_clock_source(ClockSource::SYSTEM);
+    }
+}
+
+TEST_CASE("Default timestamps come from the clock", "[Clock]") {
+    set_simulated_time(1704495600LL * 1'000'000'000);
+    set_clock_source(ClockSource::SIMULATED);
+
+    trading::order::Order order;
+    trading::position::Position position;
+    trading::instructions::Instructions<Settings> instructions;
+    REQUIRE(order.timestamp == 1704495600);
+    REQUIRE(position.timestamp == 1704495600);
+    REQUIRE(instructions.timestamp == 1704495600);
+
+    json j = {{"quantity", 1}, {"symbol", "BTC"}, {"side", "buy"}, {"filled", 0}, {"filled_at_price", 0},
+              {"limit_price", 0}, {"type", "market"}, {"status", "open"}};
+    REQUIRE(trading::order::Order(j).timestamp == 1704495600);
+    j["timestamp"] = 100;
+    REQUIRE(trading::order::Order(j).timestamp == 100);
+    REQUIRE(timestamp_from_json(json::object()) == 1704495600);
+
+    set_clock_source(ClockSource::SYSTEM);
+}
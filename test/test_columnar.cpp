@@ -0,0 +1,260 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/columnar.h"
+#include "nlohmann/json.hpp"
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+TEST_CASE("ColumnarSeriesOHLCV Construction", "[ColumnarSeriesOHLCV]") {
+    SECTION("Default Constructor") {
+        ColumnarSeriesOHLCV series;
+        REQUIRE(series.empty());
+        REQUIRE(series.size() == 0);
+        REQUIRE(series.close().empty());
+    }
+
+    SECTION("Constructor from JSON") {
+        json j = R"([{"timestamp": 200, "open": 2.0, "high": 3.0, "low": 1.5, "close": 2.5, "volume": 200},
+                     {"timestamp": 100, "open": 1.0, "high": 2.0, "low": 0.5, "close": 1.5, "volume": 100}])"_json;
+        ColumnarSeriesOHLCV series(j);
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.timestamps()[0] == 100);
+        REQUIRE(series.timestamps()[1] == 200);
+    }
+
+    SECTION("Constructor from JSON exception") {
+        json j = R"([{"timestamp": 100, "open": 1.0}])"_json;
+        REQUIRE_THROWS_AS(ColumnarSeriesOHLCV(j), OHLCException);
+    }
+
+    SECTION("Constructor from SeriesOHLCV") {
+        symbol_t symbol = std::make_shared<std::string>("AAPL");
+        SeriesOHLCV map_series;
+        map_series.insert(OHLCV(symbol, 300, 3.5, 4.5, 2.5, 3.0, 300));
+        map_series.insert(OHLCV(symbol, 100, 1.5, 2.5, 0.5, 1.0, 100));
+        map_series.insert(OHLCV(symbol, 200, 2.5, 3.5, 1.5, 2.0, 200));
+
+        ColumnarSeriesOHLCV series(map_series);
+        REQUIRE(series.size() == 3);
+        REQUIRE(*series.symbol() == "AAPL");
+        REQUIRE(series.to_json() == map_series.to_json());
+        REQUIRE(series.to_series().to_json() == map_series.to_json());
+    }
+
+    SECTION("Constructor from columns") {
+        ColumnarSeriesOHLCV series(symbol_t("AAPL"), {100, 200}, {1.5, 2.5}, {2.5, 3.5}, {0.5, 1.5}, {1.0, 2.0},
+                                   {100, 200});
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.at(1).high == 3.5);
+        REQUIRE(series.at(1).volume == 200);
+        REQUIRE_THROWS_AS(ColumnarSeriesOHLCV(symbol_t("AAPL"), {100, 200}, {1.5}, {2.5, 3.5}, {0.5, 1.5},
+                                              {1.0, 2.0}, {100, 200}), OHLCException);
+        REQUIRE_THROWS_AS(ColumnarSeriesOHLCV(symbol_t("AAPL"), {200, 200}, {1.5, 2.5}, {2.5, 3.5}, {0.5, 1.5},
+                                              {1.0, 2.0}, {100, 200}), OHLCException);
+    }
+}
+
+TEST_CASE("ColumnarSeriesOHLCV Insertion and Access", "[ColumnarSeriesOHLCV]") {
+    ColumnarSeriesOHLCV series;
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    OHLCV ohlcv1(symbol, 1704495600, 1.5, 2.5, 0.5, 1.0, 100);
+    OHLCV ohlcv2(symbol, 1704525353, 2.5, 3.5, 1.5, 2.0, 200);
+
+    SECTION("Inserting OHLCV") {
+        REQUIRE(series.insert(ohlcv2));
+        REQUIRE(series.insert(ohlcv1));
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.timestamps()[0] == ohlcv1.timestamp);
+        REQUIRE(series.close()[1] == ohlcv2.close);
+    }
+
+    SECTION("Inserting OHLCV with same timestamp keeps the first bar") {
+        series.insert(ohlcv1);
+        OHLCV other(symbol, 1704495600, 9, 9, 9, 9, 9);
+        REQUIRE(series.insert(other));
+        REQUIRE(series.size() == 1);
+        REQUIRE(series.open()[0] == 1.5);
+    }
+
+    SECTION("Accessing OHLCV by timestamp") {
+        series.insert(ohlcv1);
+        auto bar = series[ohlcv1.timestamp];
+        REQUIRE(bar.timestamp == ohlcv1.timestamp);
+        REQUIRE(bar.open == ohlcv1.open);
+        REQUIRE(bar.high == ohlcv1.high);
+        REQUIRE(bar.low == ohlcv1.low);
+        REQUIRE(bar.close == ohlcv1.close);
+        REQUIRE(bar.volume == ohlcv1.volume);
+
+        bar.close = 42;
+        REQUIRE(series.close()[0] == 42);
+    }
+
+    SECTION("Accessing a missing timestamp creates an empty bar") {
+        series.insert(ohlcv2);
+        auto bar = series[ohlcv1.timestamp];
+        REQUIRE(bar.volume == 0);
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.timestamps()[0] == ohlcv1.timestamp);
+    }
+
+    SECTION("Accessing OHLCV by date") {
+        series.insert(ohlcv1);
+        auto bar = series["2024-01-06"];
+        REQUIRE(bar.timestamp == ohlcv1.timestamp);
+        REQUIRE_THROWS_AS(series["06/01/2024"], OHLCException);
+    }
+
+    SECTION("Merging series") {
+        ColumnarSeriesOHLCV other;
+        other.insert(ohlcv2);
+        series.insert(ohlcv1);
+        REQUIRE(series.insert(other));
+        REQUIRE(series.size() == 2);
+    }
+}
+
+TEST_CASE("ColumnarSeriesOHLCV columns and iteration", "[ColumnarSeriesOHLCV]") {
+    ColumnarSeriesOHLCV series;
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    for (int i = 5; i > 0; --i) {
+        series.insert(OHLCV(symbol, 1704500000 + i * 10000, i + 0.5, i + 1.5, i - 0.5, i, i * 100));
+    }
+
+    SECTION("Columns are contiguous and sorted") {
+        auto columns = series.columns();
+        REQUIRE(columns.size() == 5);
+        REQUIRE(columns.close.data() == series.close().data());
+        for (size_t i = 1; i < columns.size(); ++i) {
+            REQUIRE(columns.timestamp[i - 1] < columns.timestamp[i]);
+        }
+        auto tail = columns.subspan(3, 2);
+        REQUIRE(tail.size() == 2);
+        REQUIRE(tail.timestamp[0] == 1704540000);
+        REQUIRE(tail.volume[1] == 500);
+    }
+
+    SECTION("Iterating over all elements and check order") {
+        timestamp_t count = 0;
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            count++;
+            const auto &[timestamp, bar] = *it;
+            REQUIRE(timestamp == 1704500000 + (count * 10000));
+            REQUIRE(bar.close == count);
+        }
+        REQUIRE(count == 5);
+    }
+
+    SECTION("Reverse iterating over all elements") {
+        timestamp_t count = 0;
+        for (auto it = series.rbegin(); it != series.rend(); --it) {
+            const auto &[timestamp, bar] = *it;
+            REQUIRE(bar.timestamp == 1704550000 - (count * 10000));
+            count++;
+        }
+        REQUIRE(count == 5);
+    }
+
+    SECTION("to_json matches OHLCV::to_json") {
+        auto j = series.to_json();
+        REQUIRE(j.size() == 5);
+        REQUIRE(j[0] == OHLCV(symbol, 1704510000, 1.5, 2.5, 0.5, 1, 100).to_json());
+    }
+}
+
+TEST_CASE("ColumnarSeriesOHLCV range queries", "[ColumnarSeriesOHLCV]") {
+    ColumnarSeriesOHLCV series;
+    for (int i = 1; i <= 5; ++i) {
+        series.insert(ColumnarSeriesOHLCV::Bar{static_cast<timestamp_t>(1704500000 + i * 10000), i + 0.5, i + 1.5,
+                                               i - 0.5, static_cast<double>(i), static_cast<size_t>(i * 100)});
+    }
+
+    SECTION("find and as_of do not insert on a miss") {
+        REQUIRE(series.find(1704530000)->volume == 300);
+        REQUIRE_FALSE(series.find(1704535000));
+        REQUIRE(series.as_of(1704539999)->timestamp == 1704530000);
+        REQUIRE(series.as_of(1704999999)->timestamp == 1704550000);
+        REQUIRE_FALSE(series.as_of(1704509999));
+        REQUIRE(series.size() == 5);
+    }
+
+    SECTION("Column indexes") {
+        auto columns = series.columns();
+        REQUIRE(columns.find(1704510000) == 0u);
+        REQUIRE_FALSE(columns.find(1704500000));
+        REQUIRE(columns.as_of(1704525000) == 1u);
+        REQUIRE_FALSE(ColumnsOHLCV{}.as_of(1704525000));
+    }
+
+    SECTION("range and last are views into the columns") {
+        auto range = series.range(1704520000, 1704540000);
+        REQUIRE(range.size() == 2);
+        REQUIRE(range.timestamp[0] == 1704520000);
+        REQUIRE(range.close.data() == series.close().data() + 1);
+
+        auto last = series.last(2);
+        REQUIRE(last.size() == 2);
+        REQUIRE(last.volume[1] == 500);
+        REQUIRE(series.last(10).size() == 5);
+        REQUIRE(series.last(0).empty());
+    }
+}
+
+TEST_CASE("ColumnarSeriesOHLCV duplicate policies and bulk insert", "[ColumnarSeriesOHLCV]") {
+    using Bar = ColumnarSeriesOHLCV::Bar;
+    ColumnarSeriesOHLCV series;
+    for (timestamp_t t: {100, 200, 300}) {
+        series.insert(Bar{t, 10, 12, 9, 11, 100});
+    }
+
+    SECTION("Single bars") {
+        REQUIRE(series.insert(Bar{200, 11, 14, 8, 13, 50}, DuplicatePolicy::KEEP));
+        REQUIRE(series.close()[1] == 11);
+        REQUIRE(series.insert(Bar{200, 11, 14, 8, 13, 50}, DuplicatePolicy::AGGREGATE));
+        REQUIRE(series.at(1).open == 10);
+        REQUIRE(series.at(1).high == 14);
+        REQUIRE(series.at(1).low == 8);
+        REQUIRE(series.at(1).close == 13);
+        REQUIRE(series.at(1).volume == 150);
+        REQUIRE(series.insert(Bar{200, 1, 2, 0.5, 1.5, 1}, DuplicatePolicy::REPLACE));
+        REQUIRE(series.at(1).open == 1);
+        REQUIRE(series.at(1).volume == 1);
+    }
+
+    SECTION("Sorted batch appended after the last bar") {
+        std::vector<Bar> batch{{300, 0, 20, 0, 5, 1}, {400, 1, 1, 1, 1, 1}, {400, 2, 2, 2, 2, 2}};
+        REQUIRE(series.insert(batch, DuplicatePolicy::AGGREGATE));
+        REQUIRE(series.size() == 4);
+        REQUIRE(series.at(2).high == 20);
+        REQUIRE(series.at(2).close == 5);
+        REQUIRE(series.at(3).open == 1);
+        REQUIRE(series.at(3).close == 2);
+        REQUIRE(series.at(3).volume == 3);
+    }
+
+    SECTION("Unsorted batch interleaved with the series") {
+        std::vector<Bar> batch{{250, 1, 1, 1, 1, 1}, {50, 2, 2, 2, 2, 2}, {200, 3, 3, 3, 3, 3}, {250, 4, 4, 4, 4, 4}};
+        REQUIRE(series.insert(batch, DuplicatePolicy::REPLACE, 2));
+        REQUIRE(std::vector<timestamp_t>(series.timestamps().begin(), series.timestamps().end())
+                == std::vector<timestamp_t>{50, 100, 200, 250, 300});
+        REQUIRE(series.at(2).close == 3);
+        REQUIRE(series.at(3).close == 4);
+        REQUIRE(series.at(4).close == 11);
+    }
+
+    SECTION("Merging another series") {
+        ColumnarSeriesOHLCV other;
+        other.insert(Bar{150, 1, 1, 1, 1, 1});
+        other.insert(Bar{300, 1, 30, 1, 1, 1});
+        REQUIRE(series.insert(other, DuplicatePolicy::AGGREGATE));
+        REQUIRE(series.size() == 4);
+        REQUIRE(series.at(3).high == 30);
+        REQUIRE(series.at(3).volume == 101);
+    }
+}
@@ -0,0 +1,132 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/compressed_series.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace trading::common;
+
+namespace {
+    // minute bars on a tick grid with gaps, like a real feed
+    ColumnarSeriesOHLCV random_series(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0, 3);
+        std::uniform_int_distribution<int> spread(0, 5);
+        std::uniform_int_distribution<size_t> volume(0, 1'000'000);
+        std::bernoulli_distribution gap(0.02);
+        ColumnarSeriesOHLCV series(symbol_t("AAPL"));
+        timestamp_t t = 1'700'000'000;
+        double close = 150;
+        for (size_t i = 0; i < count; ++i) {
+            t += gap(rng) ? 60 * (1 + rng() % 1000) : 60;
+            double open = close;
+            close = std::max(0.01, std::round((close + step(rng) * 0.01) * 100) / 100);
+            double high = std::max(open, close) + spread(rng) * 0.01;
+            double low = std::min(open, close) - spread(rng) * 0.01;
+            series.insert(ColumnarSeriesOHLCV::Bar{t, open, high, low, close, volume(rng)});
+        }
+        return series;
+    }
+
+    bool same(const ColumnarSeriesOHLCV::Bar &a, const ColumnarSeriesOHLCV::Bar &b) {
+        return a.timestamp == b.timestamp && a.open == b.open && a.high == b.high && a.low == b.low &&
+               a.close == b.close && a.volume == b.volume;
+    }
+}
+
+TEST_CASE("Compressed series round trip", "[CompressedSeriesOHLCV]") {
+    auto series = random_series(5000, 1);
+    CompressedSeriesOHLCV compressed(series, 256);
+    REQUIRE(compressed.size() == series.size());
+    REQUIRE(compressed.blocks() == 20);
+    REQUIRE(*compressed.symbol() == "AAPL");
+
+    SECTION("Decoding restores every bit") {
+        auto decoded = compressed.to_columnar();
+        REQUIRE(decoded.size() == series.size());
+        for (size_t i = 0; i < series.size(); ++i) {
+            REQUIRE(same(decoded.at(i), series.at(i)));
+        }
+        REQUIRE(same(compressed.back(), series.at(series.size() - 1)));
+    }
+
+    SECTION("Blocks decode on their own") {
+        CompressedSeriesOHLCV::Buffer buffer;
+        for (size_t b = compressed.blocks(); b-- > 0;) {
+            auto columns = compressed.decode(b, buffer);
+            size_t last = std::min<size_t>(series.size(), (b + 1) * 256) - 1;
+            REQUIRE(columns.size() == last - b * 256 + 1);
+            REQUIRE(columns.timestamp[0] == series.timestamps()[b * 256]);
+            REQUIRE(columns.close.back() == series.close()[last]);
+        }
+    }
+
+    SECTION("Random access") {
+        REQUIRE(same(compressed.at(0), series.at(0)));
+        REQUIRE(same(compressed.at(1234), series.at(1234)));
+        REQUIRE_THROWS_AS(compressed.at(5000), OHLCException);
+
+        timestamp_t t = series.timestamps()[3000];
+        REQUIRE(same(*compressed.find(t), series.at(3000)));
+        REQUIRE_FALSE(compressed.find(t + 1));
+        REQUIRE_FALSE(compressed.find(series.timestamps()[0] - 1));
+        REQUIRE(same(*compressed.as_of(t + 1), series.at(3000)));
+        REQUIRE(same(*compressed.as_of(series.timestamps()[4999] + 100), series.at(4999)));
+        REQUIRE_FALSE(compressed.as_of(series.timestamps()[0] - 1));
+    }
+
+    SECTION("Ranges decode only the blocks they need") {
+        timestamp_t from = series.timestamps()[250];
+        timestamp_t to = series.timestamps()[700];
+        auto range = compressed.range(from, to);
+        REQUIRE(range.size() == 450);
+        REQUIRE(same(range.at(0), series.at(250)));
+        REQUIRE(same(range.at(449), series.at(699)));
+        REQUIRE(compressed.range(to, from).empty());
+    }
+
+    SECTION("Smaller than the columns") {
+        REQUIRE(compressed.bytes() * 2 < series.size() * 6 * sizeof(double));
+    }
+}
+
+TEST_CASE("Compressed series edge values", "[CompressedSeriesOHLCV]") {
+    CompressedSeriesOHLCV compressed(symbol_t("X"), 4);
+    std::vector<CompressedSeriesOHLCV::Bar> bars{
+            {0, 0.0, 0.0, 0.0, 0.0, 0},
+            {1, -1.5, std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min(), -0.0, 1},
+            {1ull << 40, std::numeric_limits<double>::infinity(), 1e-300, -1e300, 3.0,
+             std::numeric_limits<size_t>::max()},
+            {(1ull << 40) + 1, 1.0, 2.0, 0.5, 1.0, 127},
+            {(1ull << 40) + 2, 1.0, 2.0, 0.5, 1.0, 128},
+            {std::numeric_limits<timestamp_t>::max() / 2, 1.0, 2.0, 0.5, 1.0, 16384},
+    };
+    for (auto &bar: bars) {
+        REQUIRE(compressed.append(bar));
+    }
+    REQUIRE_FALSE(compressed.append(bars.back()));
+    REQUIRE(compressed.size() == bars.size());
+    auto decoded = compressed.to_columnar();
+    for (size_t i = 0; i < bars.size(); ++i) {
+        REQUIRE(std::memcmp(&decoded.close()[i], &bars[i].close, sizeof(double)) == 0);
+        REQUIRE(same(decoded.at(i), bars[i]));
+    }
+
+    SECTION("Appending OHLCV takes its symbol") {
+        CompressedSeriesOHLCV empty;
+        REQUIRE(empty.to_columnar().empty());
+        REQUIRE_FALSE(empty.find(0));
+        REQUIRE_THROWS_AS(empty.back(), OHLCException);
+        REQUIRE(empty.append(OHLCV(symbol_t("MSFT"), 60, 1, 2, 0.5, 1.5, 10)));
+        REQUIRE(*empty.symbol() == "MSFT");
+        REQUIRE(empty.find(60)->volume == 10);
+        REQUIRE(empty.back().timestamp == 60);
+        REQUIRE_THROWS_AS(CompressedSeriesOHLCV(symbol_t("X"), 0), OHLCException);
+    }
+}
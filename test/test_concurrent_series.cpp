@@ -0,0 +1,137 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/concurrent_series.h"
+#include "nlohmann/json.hpp"
+#include <thread>
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+TEST_CASE("ConcurrentSeriesOHLCV append", "[ConcurrentSeriesOHLCV]") {
+    ConcurrentSeriesOHLCV series(std::make_shared<std::string>("AAPL"));
+
+    SECTION("Default state") {
+        REQUIRE(series.empty());
+        REQUIRE(series.snapshot().empty());
+        REQUIRE_FALSE(series.last());
+        REQUIRE(*series.snapshot().symbol() == "AAPL");
+    }
+
+    SECTION("Appending in order") {
+        REQUIRE(series.append(ConcurrentSeriesOHLCV::Bar{100, 1, 2, 0.5, 1.5, 10}));
+        REQUIRE(series.append(ConcurrentSeriesOHLCV::Bar{200, 2, 3, 1.5, 2.5, 20}));
+        REQUIRE(series.size() == 2);
+        auto snapshot = series.snapshot();
+        REQUIRE(snapshot.at(0).timestamp == 100);
+        REQUIRE(snapshot.back().close == 2.5);
+        REQUIRE(series.last()->close == 2.5);
+    }
+
+    SECTION("Appending an older or equal timestamp is rejected") {
+        REQUIRE(series.append(ConcurrentSeriesOHLCV::Bar{200, 2, 3, 1.5, 2.5, 20}));
+        REQUIRE_FALSE(series.append(ConcurrentSeriesOHLCV::Bar{200, 2, 3, 1.5, 2.5, 20}));
+        REQUIRE_FALSE(series.append(ConcurrentSeriesOHLCV::Bar{100, 1, 2, 0.5, 1.5, 10}));
+        REQUIRE(series.size() == 1);
+    }
+
+    SECTION("Appending OHLCV") {
+        symbol_t symbol = std::make_shared<std::string>("AAPL");
+        REQUIRE(series.append(OHLCV(symbol, 1704495600, 1.5, 2.5, 0.5, 1.0, 100)));
+        auto snapshot = series.snapshot();
+        REQUIRE(snapshot.to_json()[0] == OHLCV(symbol, 1704495600, 1.5, 2.5, 0.5, 1.0, 100).to_json());
+    }
+}
+
+TEST_CASE("ConcurrentSeriesOHLCV snapshots", "[ConcurrentSeriesOHLCV]") {
+    ConcurrentSeriesOHLCV series;
+    const size_t count = ConcurrentSeriesOHLCV::CHUNK_SIZE * 3 + 17;
+    for (size_t i = 0; i < count / 2; ++i) {
+        series.append(ConcurrentSeriesOHLCV::Bar{i + 1, 1, 2, 0.5, (double) i, i});
+    }
+
+    SECTION("A snapshot does not see later appends") {
+        auto snapshot = series.snapshot();
+        for (size_t i = count / 2; i < count; ++i) {
+            series.append(ConcurrentSeriesOHLCV::Bar{i + 1, 1, 2, 0.5, (double) i, i});
+        }
+        REQUIRE(snapshot.size() == count / 2);
+        REQUIRE(snapshot.version() < series.snapshot().version());
+        REQUIRE(series.snapshot().size() == count);
+        REQUIRE(snapshot.back().timestamp == count / 2);
+    }
+
+    SECTION("Segments cover the snapshot in order") {
+        for (size_t i = count / 2; i < count; ++i) {
+            series.append(ConcurrentSeriesOHLCV::Bar{i + 1, 1, 2, 0.5, (double) i, i});
+        }
+        auto snapshot = series.snapshot();
+        auto segments = snapshot.segments();
+        REQUIRE(segments.size() == 4);
+        size_t index = 0;
+        for (const auto &segment: segments) {
+            for (size_t i = 0; i < segment.size(); ++i, ++index) {
+                REQUIRE(segment.timestamp[i] == index + 1);
+                REQUIRE(segment.close[i] == (double) index);
+            }
+        }
+        REQUIRE(index == count);
+        REQUIRE(snapshot.to_columnar().size() == count);
+    }
+
+    SECTION("Iterating over a snapshot") {
+        auto snapshot = series.snapshot();
+        size_t visited = 0;
+        for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+            const auto &[timestamp, bar] = *it;
+            REQUIRE(timestamp == ++visited);
+        }
+        REQUIRE(visited == snapshot.size());
+        for (auto it = snapshot.rbegin(); it != snapshot.rend(); --it) {
+            const auto &[timestamp, bar] = *it;
+            REQUIRE(timestamp == visited--);
+        }
+        REQUIRE(visited == 0);
+    }
+}
+
+TEST_CASE("ConcurrentSeriesOHLCV one writer many readers", "[ConcurrentSeriesOHLCV]") {
+    ConcurrentSeriesOHLCV series;
+    const size_t count = ConcurrentSeriesOHLCV::CHUNK_SIZE * 8;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> errors{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            size_t last_size = 0;
+            while (!done.load()) {
+                auto snapshot = series.snapshot();
+                if (snapshot.size() < last_size) {
+                    ++errors;
+                }
+                last_size = snapshot.size();
+                if (!snapshot.empty()) {
+                    auto bar = snapshot.back();
+                    if (bar.timestamp != snapshot.size() || bar.volume != snapshot.size()) {
+                        ++errors;
+                    }
+                }
+            }
+        });
+    }
+
+    for (size_t i = 1; i <= count; ++i) {
+        series.append(ConcurrentSeriesOHLCV::Bar{i, 1, 2, 0.5, 1.5, i});
+    }
+    done = true;
+    for (auto &reader: readers) {
+        reader.join();
+    }
+    REQUIRE(errors == 0);
+    REQUIRE(series.size() == count);
+}
@@ -0,0 +1,111 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/enum_names.h"
+#include "trading_common/instructions.h"
+#include "trading_common/order.h"
+#include "trading_common/position.h"
+
+using namespace trading::common;
+
+namespace {
+    enum class Color {
+        NONE = 0,
+        RED = 1,
+        GREEN = 2,
+        BLUE = 3
+    };
+
+    constexpr EnumNames<Color, 4> ColorNames{{{
+            {Color::NONE, "NONE"},
+            {Color::RED, "Red"},
+            {Color::GREEN, "green"},
+            {Color::BLUE, "BLUE"}
+    }}};
+
+    enum class Execution {
+        NONE = 0,
+        PARTIALLY_FILLED = 1,
+        PARTIALLY_CANCELED = 2,
+        PENDING_CANCEL = 3
+    };
+
+    constexpr EnumNames<Execution, 4> ExecutionNames{{{
+            {Execution::NONE, "NONE"},
+            {Execution::PARTIALLY_FILLED, "PARTIALLY_FILLED"},
+            {Execution::PARTIALLY_CANCELED, "PARTIALLY_CANCELED"},
+            {Execution::PENDING_CANCEL, "PENDING_CANCEL"}
+    }}};
+}
+
+// the tables are built, and usable, at compile time
+static_assert(ColorNames.name(Color::GREEN) == "green");
+static_assert(ColorNames.parse("bLuE", Color::NONE) == Color::BLUE);
+static_assert(trading::order::StatusNames.parse("canceled", trading::order::Status::NONE) ==
+              trading::order::Status::CANCELED);
+
+TEST_CASE("EnumNames", "[EnumNames]") {
+    SECTION("Names") {
+        REQUIRE(ColorNames.size() == 4);
+        REQUIRE(ColorNames.name(Color::RED) == "Red");
+        REQUIRE(ColorNames.name(static_cast<Color>(42)) == "NONE");
+        size_t count = 0;
+        for (const auto &[value, name]: ColorNames) {
+            REQUIRE(ColorNames.name(value) == name);
+            ++count;
+        }
+        REQUIRE(count == 4);
+    }
+
+    SECTION("Parsing ignores case and falls back on unknown names") {
+        REQUIRE(ColorNames.parse("red", Color::NONE) == Color::RED);
+        REQUIRE(ColorNames.parse("GREEN", Color::NONE) == Color::GREEN);
+        REQUIRE(ColorNames.parse("none", Color::BLUE) == Color::NONE);
+        REQUIRE(ColorNames.parse("", Color::BLUE) == Color::BLUE);
+        REQUIRE(ColorNames.parse("redd", Color::NONE) == Color::NONE);
+        REQUIRE(ColorNames.parse("purple", Color::BLUE) == Color::BLUE);
+        // as long as a name, with the difference of lengths hidden in its last byte
+        REQUIRE(ColorNames.parse(std::string_view("blue\0\0\0\x0c", 8), Color::NONE) == Color::NONE);
+        REQUIRE(ColorNames.parse("gr\xc3\xa9" "en", Color::NONE) == Color::NONE);
+    }
+
+    SECTION("Names longer than eight characters") {
+        REQUIRE(ExecutionNames.parse("partially_filled", Execution::NONE) == Execution::PARTIALLY_FILLED);
+        REQUIRE(ExecutionNames.parse("Partially_Canceled", Execution::NONE) == Execution::PARTIALLY_CANCELED);
+        REQUIRE(ExecutionNames.parse("PENDING_CANCEL", Execution::NONE) == Execution::PENDING_CANCEL);
+        REQUIRE(ExecutionNames.parse("PARTIALLY_XILLED", Execution::NONE) == Execution::NONE);
+        REQUIRE(ExecutionNames.parse("PARTIALLY", Execution::NONE) == Execution::NONE);
+    }
+
+    SECTION("Domain enums") {
+        using namespace trading::order;
+        for (const auto &[value, name]: StatusNames) {
+            REQUIRE(StatusNames.parse(name, Status::NONE) == value);
+        }
+        REQUIRE(SideNames.parse("sell", Side::NONE) == Side::SELL);
+        REQUIRE(TypeNames.parse("Limit", Type::NONE) == Type::LIMIT);
+        REQUIRE(trading::position::SideNames.parse("short", trading::position::Side::NONE) ==
+                trading::position::Side::SHORT);
+        REQUIRE(trading::instructions::get_type_from_string("EMA") == trading::instructions::Type::EMA);
+        REQUIRE(trading::instructions::get_selector_from_string("") == trading::instructions::Selector::NONE);
+    }
+
+    SECTION("Orders and positions parse names in any case") {
+        json j = {{"quantity", 10}, {"symbol", "BTC"}, {"side", "Sell"}, {"filled", 0},
+                  {"filled_at_price", 0}, {"limit_price", 100.5}, {"type", "limit"}, {"status", "open"}};
+        trading::order::Order order(j);
+        REQUIRE(order.side == trading::order::Side::SELL);
+        REQUIRE(order.type == trading::order::Type::LIMIT);
+        REQUIRE(order.status == trading::order::Status::OPEN);
+        REQUIRE(order.to_json()["status"] == "OPEN");
+
+        json p = {{"balance", 1}, {"symbol", "BTC"}, {"side", "long"}, {"entry_price", 1.0},
+                  {"current_price", 1.0}, {"pnl", 0.0}};
+        trading::position::Position position(p);
+        REQUIRE(position.side == trading::position::Side::LONG);
+        REQUIRE(position.to_json()["side"] == "LONG");
+    }
+}
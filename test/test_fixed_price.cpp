@@ -0,0 +1,113 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/fixed_price.h"
+#include "trading_common/order.h"
+#include "trading_common/position.h"
+#include "trading_common/pnl.h"
+#include <limits>
+
+using namespace trading::common;
+using Cents = FixedPrice<2>;
+
+TEST_CASE("FixedPrice arithmetic", "[FixedPrice]") {
+    SECTION("Conversions round to the nearest tick") {
+        REQUIRE(Cents::SCALE == 100);
+        REQUIRE(Cents::from_double(1.006).ticks() == 101);
+        REQUIRE(Cents::from_double(1.004).ticks() == 100);
+        REQUIRE(Cents::from_double(-2.499).ticks() == -250);
+        REQUIRE(Cents::from_double(0.1).to_double() == 0.1);
+        REQUIRE(FixedPrice<8>::from_double(0.00000001).ticks() == 1);
+        REQUIRE(Cents() == Cents::from_ticks(0));
+    }
+
+    SECTION("Sums are exact where doubles drift") {
+        Cents sum;
+        double drift = 0;
+        for (int i = 0; i < 1000; ++i) {
+            sum += Cents::from_double(0.1);
+            drift += 0.1;
+        }
+        REQUIRE(sum == Cents::from_ticks(10'000));
+        REQUIRE(drift != 100.0);
+        REQUIRE(sum - Cents::from_double(100) == Cents());
+        REQUIRE(-sum < Cents());
+    }
+
+    SECTION("Products and quotients with quantities") {
+        auto price = Cents::from_double(12.34);
+        REQUIRE((price * size_t{3}).ticks() == 3702);
+        REQUIRE((size_t{3} * price) == price * 3);
+        REQUIRE((Cents::from_ticks(10) / 4).ticks() == 3);
+        REQUIRE((Cents::from_ticks(10) / 3).ticks() == 3);
+        REQUIRE((Cents::from_ticks(-10) / 4).ticks() == -3);
+        REQUIRE((Cents::from_ticks(-11) / 4).ticks() == -3);
+        REQUIRE_THROWS_AS(price / 0, std::domain_error);
+    }
+
+    SECTION("Overflow throws instead of wrapping") {
+        auto max = Cents::from_ticks(std::numeric_limits<int64_t>::max());
+        REQUIRE_THROWS_AS(max + Cents::from_ticks(1), std::overflow_error);
+        REQUIRE_THROWS_AS(Cents::from_ticks(std::numeric_limits<int64_t>::min()) - Cents::from_ticks(1),
+                          std::overflow_error);
+        REQUIRE_THROWS_AS(-Cents::from_ticks(std::numeric_limits<int64_t>::min()), std::overflow_error);
+        REQUIRE_THROWS_AS(max * 2, std::overflow_error);
+        REQUIRE_THROWS_AS(Cents::from_double(1e300), std::overflow_error);
+        REQUIRE_THROWS_AS(Cents::from_double(std::numeric_limits<double>::quiet_NaN()), std::overflow_error);
+    }
+
+    SECTION("Prices are plain numbers in JSON") {
+        json j = Cents::from_double(101.25);
+        REQUIRE(j.get<double>() == 101.25);
+        REQUIRE(j.get<Cents>() == Cents::from_ticks(10125));
+        REQUIRE(price_to_double(Cents::from_ticks(5)) == 0.05);
+        REQUIRE(price_from_double<Cents>(0.05) == Cents::from_ticks(5));
+        REQUIRE(price_from_double<price_t>(0.05) == 0.05);
+    }
+}
+
+TEST_CASE("Orders and positions on a FixedPrice", "[FixedPrice]") {
+    using Order = trading::order::BasicOrder<Cents>;
+    using Position = trading::position::BasicPosition<Cents>;
+    using trading::order::Side;
+    using trading::order::Type;
+    using trading::order::Status;
+    symbol_t symbol("BTC");
+
+    SECTION("Orders parse and validate like their double counterpart") {
+        json j = {{"quantity", 10}, {"symbol", "BTC"}, {"side", "buy"}, {"filled", 10},
+                  {"filled_at_price", 100.1}, {"limit_price", 0}, {"type", "market"}, {"status", "filled"}};
+        Order order(j);
+        REQUIRE(order.filled_at_price == Cents::from_ticks(10010));
+        REQUIRE(order.validate().success);
+        REQUIRE(order.to_json()["filled_at_price"].get<double>() == 100.1);
+
+        Order limit(1, 10, symbol, Side::BUY, 0, Cents(), Cents(), "1", Type::LIMIT, Status::OPEN);
+        REQUIRE_FALSE(limit.validate().success);
+    }
+
+    SECTION("The entry price averages exactly") {
+        Position position;
+        // three fills at 0.10, 0.20 and 0.30 average to exactly 0.20, which doubles miss
+        for (int64_t ticks: {10, 20, 30}) {
+            Order fill(1, 1, symbol, Side::BUY, 1, Cents::from_ticks(ticks), Cents(), "1", Type::MARKET,
+                       Status::FILLED);
+            position.current_price = Cents::from_ticks(ticks);
+            REQUIRE(position.apply_order(fill).success);
+        }
+        REQUIRE(position.balance == 3);
+        REQUIRE(position.entry_price == Cents::from_ticks(20));
+        REQUIRE((0.1 + 0.2 + 0.3) / 3 != 0.2);
+
+        position.set_current_price(Cents::from_double(0.25));
+        REQUIRE(position.pnl == Cents::from_ticks(15));
+
+        trading::pnl::BasicPnL<Cents> pnl;
+        pnl.add_position(position);
+        pnl.add_cash(Cents::from_double(1000.01));
+        REQUIRE(pnl.calculate_total_value() == Cents::from_ticks(100'016));
+    }
+}
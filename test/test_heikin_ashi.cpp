@@ -0,0 +1,180 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/heikin_ashi.h"
+#include <random>
+#include <vector>
+
+using namespace trading::common;
+
+namespace {
+    SeriesOHLCV random_series(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0, 1);
+        SeriesOHLCV series;
+        double close = 100;
+        for (size_t i = 0; i < count; ++i) {
+            double open = close;
+            close += step(rng);
+            series.insert(OHLCV(symbol_t("HA"), 1'700'000'000 + i * 60, open, std::max(open, close) + 0.3,
+                                std::min(open, close) - 0.3, close, 10 + i));
+        }
+        return series;
+    }
+
+    // chains the single candle constructors over the series, the reference for every other path
+    std::vector<HeikinAshi> chained(const SeriesOHLCV &series) {
+        std::vector<HeikinAshi> candles;
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            const OHLCV &bar = (*it).second;
+            candles.push_back(candles.empty() ? HeikinAshi(bar) : HeikinAshi(bar, candles.back()));
+        }
+        return candles;
+    }
+
+    void require_same(const OHLC &actual, const OHLC &expected) {
+        REQUIRE(actual.open == expected.open);
+        REQUIRE(actual.high == expected.high);
+        REQUIRE(actual.low == expected.low);
+        REQUIRE(actual.close == expected.close);
+    }
+}
+
+TEST_CASE("Batch Heikin-Ashi matches chained candles", "[HeikinAshi]") {
+    SeriesOHLCV series = random_series(1000, 1);
+    auto expected = chained(series);
+    ColumnarSeriesOHLCV columnar(series);
+
+    SECTION("Into separate columns") {
+        size_t n = columnar.size();
+        std::vector<double> open(n), high(n), low(n), close(n);
+        heikin_ashi(columnar.columns(), open, high, low, close);
+        for (size_t i = 0; i < n; ++i) {
+            INFO("bar " << i);
+            require_same(OHLC(open[i], high[i], low[i], close[i]), expected[i]);
+        }
+    }
+
+    SECTION("In place") {
+        size_t n = columnar.size();
+        std::vector<double> open(columnar.open().begin(), columnar.open().end());
+        std::vector<double> high(columnar.high().begin(), columnar.high().end());
+        std::vector<double> low(columnar.low().begin(), columnar.low().end());
+        std::vector<double> close(columnar.close().begin(), columnar.close().end());
+        ColumnsOHLCV in = columnar.columns();
+        in.open = open;
+        in.high = high;
+        in.low = low;
+        in.close = close;
+        heikin_ashi(in, open, high, low, close);
+        for (size_t i = 0; i < n; ++i) {
+            INFO("bar " << i);
+            require_same(OHLC(open[i], high[i], low[i], close[i]), expected[i]);
+        }
+    }
+
+    SECTION("As a new series") {
+        ColumnarSeriesOHLCV ha = heikin_ashi(columnar);
+        REQUIRE(ha.size() == columnar.size());
+        REQUIRE(ha.symbol() == columnar.symbol());
+        for (size_t i = 0; i < ha.size(); ++i) {
+            auto bar = ha.at(i);
+            REQUIRE(bar.timestamp == columnar.at(i).timestamp);
+            REQUIRE(bar.volume == columnar.at(i).volume);
+            require_same(OHLC(bar.open, bar.high, bar.low, bar.close), expected[i]);
+        }
+    }
+
+    SECTION("Wrong output size") {
+        std::vector<double> shorter(columnar.size() - 1), out(columnar.size());
+        REQUIRE_THROWS_AS(heikin_ashi(columnar.columns(), out, out, shorter, out), OHLCException);
+    }
+
+    SECTION("Empty series") {
+        ColumnarSeriesOHLCV empty;
+        REQUIRE(heikin_ashi(empty).empty());
+    }
+}
+
+TEST_CASE("HeikinAshiState extends a series bar by bar", "[HeikinAshi]") {
+    SeriesOHLCV series = random_series(200, 2);
+    auto expected = chained(series);
+    ColumnarSeriesOHLCV columnar(series);
+
+    SECTION("Update") {
+        HeikinAshiState state;
+        REQUIRE_FALSE(state.ready());
+        size_t i = 0;
+        for (auto it = series.begin(); it != series.end(); ++it, ++i) {
+            require_same(state.update((*it).second), expected[i]);
+        }
+        REQUIRE(state.count() == expected.size());
+        require_same(state.last(), expected.back());
+    }
+
+    SECTION("Revise replaces the last candle") {
+        HeikinAshiState state;
+        for (size_t i = 0; i < columnar.size(); ++i) {
+            auto bar = columnar.at(i);
+            auto forming = bar;
+            forming.close = bar.open;
+            state.update(forming);
+            state.revise(forming);
+            require_same(state.revise(bar), expected[i]);
+        }
+        REQUIRE(state.count() == columnar.size());
+    }
+
+    SECTION("Revise before any update starts the series") {
+        HeikinAshiState state;
+        OHLC bar(100, 101, 99, 100.5);
+        require_same(state.revise(bar), HeikinAshi(bar));
+        REQUIRE(state.count() == 1);
+    }
+
+    SECTION("Continues a batch transform") {
+        ColumnarSeriesOHLCV head;
+        for (size_t i = 0; i < 150; ++i) {
+            head.insert(columnar.at(i));
+        }
+        ColumnarSeriesOHLCV ha = heikin_ashi(head);
+        HeikinAshiState state(ha.columns());
+        REQUIRE(state.count() == 150);
+        for (size_t i = 150; i < columnar.size(); ++i) {
+            require_same(state.update(columnar.at(i)), expected[i]);
+        }
+        auto bar = columnar.at(columnar.size() - 1);
+        require_same(state.revise(bar), expected.back());
+    }
+
+    SECTION("Reset") {
+        HeikinAshiState state;
+        state.update(columnar.at(0));
+        state.update(columnar.at(1));
+        state.reset();
+        REQUIRE_FALSE(state.ready());
+        require_same(state.update(columnar.at(0)), expected[0]);
+    }
+}
+
+TEST_CASE("HeikinAshiView iterates without copying the series", "[HeikinAshi]") {
+    SeriesOHLCV series = random_series(300, 3);
+    auto expected = chained(series);
+
+    HeikinAshiView view(series);
+    size_t i = 0;
+    for (const auto &[timestamp, candle]: view) {
+        INFO("bar " << i);
+        REQUIRE(timestamp == 1'700'000'000 + i * 60);
+        require_same(candle, expected[i]);
+        ++i;
+    }
+    REQUIRE(i == expected.size());
+
+    SeriesOHLCV empty;
+    HeikinAshiView empty_view(empty);
+    REQUIRE_FALSE(empty_view.begin() != empty_view.end());
+}
@@ -0,0 +1,131 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/id.h"
+#include "trading_common/order.h"
+#include "trading_common/position.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace trading::common;
+
+namespace {
+    size_t generated = 0;
+
+    Id counting_generator() {
+        ++generated;
+        return Id::from_number(generated);
+    }
+}
+
+TEST_CASE("Id", "[Id]") {
+    SECTION("Numbers and text") {
+        Id number = Id::from_number(1234567890123);
+        REQUIRE(number.is_number());
+        REQUIRE(number.text().empty());
+        REQUIRE(number.size() == 13);
+        REQUIRE(number.str() == "1234567890123");
+        REQUIRE(Id::from_number(UINT64_MAX).size() == Id::MAX_DIGITS);
+        REQUIRE(Id::from_number(0).empty());
+
+        Id text("order-1");
+        REQUIRE_FALSE(text.is_number());
+        REQUIRE(text.size() == 7);
+        REQUIRE(std::string(text) == "order-1");
+        text.assign("2");
+        REQUIRE(text == Id("2"));
+        REQUIRE(Id().empty());
+    }
+
+    SECTION("A number equals its digits") {
+        Id number = Id::from_number(42);
+        REQUIRE(number == Id("42"));
+        REQUIRE(Id("42") == number);
+        REQUIRE(number != Id("042"));
+        REQUIRE(number != Id::from_number(43));
+        REQUIRE(number == "42");
+    }
+
+    SECTION("Equal ids hash alike") {
+        std::hash<Id> hash;
+        REQUIRE(hash(Id::from_number(42)) == hash(Id("42")));
+        REQUIRE(hash(Id::from_number(UINT64_MAX)) == hash(Id("18446744073709551615")));
+        REQUIRE(hash(Id("042")) == std::hash<std::string>{}("042"));
+        REQUIRE(hash(Id("18446744073709551616")) == std::hash<std::string>{}("18446744073709551616"));
+        REQUIRE(hash(Id("order-1")) == std::hash<std::string>{}("order-1"));
+    }
+
+    SECTION("JSON strings") {
+        json j = Id::from_number(42);
+        REQUIRE(j == "42");
+        Id parsed = j.get<Id>();
+        REQUIRE(parsed == Id::from_number(42));
+        REQUIRE_THROWS_AS(json(7).get<Id>(), json::type_error);
+    }
+}
+
+TEST_CASE("Id generation", "[Id]") {
+    SECTION("Ids of a thread increase and no two threads share one") {
+        constexpr size_t PER_THREAD = 100'000;
+        std::vector<std::vector<uint64_t>> ids(4);
+        std::vector<std::thread> threads;
+        for (auto &list: ids) {
+            threads.emplace_back([&list] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    list.push_back(next_id().number());
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        std::vector<uint64_t> all;
+        for (auto &list: ids) {
+            REQUIRE(std::is_sorted(list.begin(), list.end()));
+            all.insert(all.end(), list.begin(), list.end());
+        }
+        std::sort(all.begin(), all.end());
+        REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+        REQUIRE(all.front() != 0);
+    }
+
+    SECTION("The node is in the top bits") {
+        set_node_id(5);
+        uint64_t number = 0;
+        // a fresh thread takes a new block, with the new node
+        std::thread([&number] { number = next_id().number(); }).join();
+        set_node_id(0);
+        REQUIRE(number >> 54 == 5);
+    }
+
+    SECTION("Pluggable generator, not called for ids read from JSON") {
+        set_id_generator(counting_generator);
+        generated = 0;
+        trading::order::Order order;
+        REQUIRE(generated == 1);
+        REQUIRE(order.id == Id::from_number(1));
+
+        json j = {{"id", "exchange-7"}, {"quantity", 1}, {"symbol", "BTC"}, {"side", "buy"}, {"filled", 0},
+                  {"filled_at_price", 0}, {"limit_price", 0}, {"type", "market"}, {"status", "open"}};
+        trading::order::Order parsed(j);
+        REQUIRE(parsed.id == "exchange-7");
+        REQUIRE(generated == 1);
+
+        j.erase("id");
+        trading::order::Order without_id(j);
+        REQUIRE(generated == 2);
+
+        json p = {{"id", "p-1"}, {"balance", 1}, {"symbol", "BTC"}, {"side", "LONG"}, {"entry_price", 1.0},
+                  {"current_price", 1.0}, {"pnl", 0.0}};
+        trading::position::Position position(p);
+        REQUIRE(position.id == "p-1");
+        REQUIRE(generated == 2);
+
+        set_id_generator(nullptr);
+        REQUIRE(generate_id().number() > (uint64_t{1} << 16));
+    }
+}
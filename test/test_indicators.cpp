@@ -0,0 +1,238 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/indicators.h"
+#include <cmath>
+#include <random>
+
+using namespace trading::indicators;
+using namespace trading::common;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+    std::vector<Bar> random_bars(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0, 1);
+        std::uniform_real_distribution<double> spread(0, 2);
+        std::vector<Bar> bars;
+        double close = 100;
+        for (size_t i = 0; i < count; ++i) {
+            double open = close;
+            close = std::max(1.0, close + step(rng));
+            double high = std::max(open, close) + spread(rng);
+            double low = std::min(open, close) - spread(rng);
+            bars.push_back({1000 + i * 60, open, high, low, close, 100 + i});
+        }
+        return bars;
+    }
+
+    double naive_sma(const std::vector<Bar> &bars, size_t end, size_t period) {
+        double sum = 0;
+        for (size_t i = end - period; i < end; ++i) {
+            sum += bars[i].close;
+        }
+        return sum / static_cast<double>(period);
+    }
+
+    double naive_ema(const std::vector<double> &values, size_t end, size_t period) {
+        double value = 0;
+        for (size_t i = 0; i < period; ++i) {
+            value += values[i];
+        }
+        value /= static_cast<double>(period);
+        double alpha = 2.0 / (static_cast<double>(period) + 1);
+        for (size_t i = period; i < end; ++i) {
+            value += alpha * (values[i] - value);
+        }
+        return value;
+    }
+}
+
+TEST_CASE("Simple moving average", "[Indicators]") {
+    auto bars = random_bars(500, 1);
+    SMA sma(20);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        sma.update(bars[i]);
+        REQUIRE(sma.ready() == (i + 1 >= 20));
+        if (sma.ready()) {
+            REQUIRE_THAT(sma.value(), WithinAbs(naive_sma(bars, i + 1, 20), 1e-9));
+        }
+    }
+    REQUIRE_THROWS_AS(SMA(0), IndicatorException);
+}
+
+TEST_CASE("Exponential moving average and MACD", "[Indicators]") {
+    auto bars = random_bars(300, 2);
+    std::vector<double> closes;
+    for (auto &bar: bars) {
+        closes.push_back(bar.close);
+    }
+
+    SECTION("EMA matches a full recomputation") {
+        EMA ema(10);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            ema.update(bars[i]);
+            if (i + 1 == 10) {
+                REQUIRE_THAT(ema.value(), WithinAbs(naive_sma(bars, 10, 10), 1e-9));
+            }
+            if (ema.ready()) {
+                REQUIRE_THAT(ema.value(), WithinAbs(naive_ema(closes, i + 1, 10), 1e-9));
+            }
+        }
+    }
+
+    SECTION("MACD") {
+        MACD macd(12, 26, 9);
+        std::vector<double> lines;
+        for (size_t i = 0; i < bars.size(); ++i) {
+            macd.update(bars[i]);
+            if (i + 1 >= 26) {
+                double line = naive_ema(closes, i + 1, 12) - naive_ema(closes, i + 1, 26);
+                REQUIRE_THAT(macd.value(), WithinAbs(line, 1e-9));
+                lines.push_back(line);
+            }
+            REQUIRE(macd.ready() == (lines.size() >= 9));
+            if (macd.ready()) {
+                REQUIRE_THAT(macd.signal(), WithinAbs(naive_ema(lines, lines.size(), 9), 1e-9));
+                REQUIRE_THAT(macd.histogram(), WithinAbs(macd.value() - macd.signal(), 1e-12));
+            }
+        }
+        REQUIRE_THROWS_AS(MACD(26, 12, 9), IndicatorException);
+    }
+}
+
+TEST_CASE("RSI and ATR", "[Indicators]") {
+    SECTION("RSI of a known series") {
+        RSI rsi(3);
+        for (double close: {10.0, 11.0, 12.0, 11.0}) {
+            rsi.update(close);
+        }
+        REQUIRE(rsi.ready());
+        // gains 1, 1, 0 and losses 0, 0, 1
+        REQUIRE_THAT(rsi.value(), WithinAbs(100.0 - 100.0 / 3.0, 1e-9));
+        rsi.update(13.0);
+        // gain (2/3 * 2 + 2) / 3, loss (1/3 * 2) / 3
+        REQUIRE_THAT(rsi.value(), WithinAbs(100.0 - 100.0 / (1.0 + (10.0 / 9.0) / (2.0 / 9.0)), 1e-9));
+    }
+
+    SECTION("RSI of a flat or rising series") {
+        RSI flat(2);
+        RSI rising(2);
+        for (int i = 0; i < 5; ++i) {
+            flat.update(10.0);
+            rising.update(10.0 + i);
+        }
+        REQUIRE(flat.value() == 50.0);
+        REQUIRE(rising.value() == 100.0);
+    }
+
+    SECTION("ATR of a known series") {
+        ATR atr(2);
+        atr.update(Bar{1, 10, 12, 9, 11, 0});
+        atr.update(Bar{2, 11, 15, 11, 14, 0});
+        REQUIRE(atr.ready());
+        // true ranges 3 and max(4, |15-11|, |11-11|) = 4
+        REQUIRE_THAT(atr.value(), WithinAbs(3.5, 1e-12));
+        atr.update(Bar{3, 14, 14, 8, 9, 0});
+        REQUIRE_THAT(atr.value(), WithinAbs((3.5 + 6) / 2, 1e-12));
+    }
+}
+
+TEST_CASE("Bollinger bands", "[Indicators]") {
+    auto bars = random_bars(200, 3);
+    Bollinger bands(20, 2.0);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        bands.update(bars[i]);
+        if (bands.ready()) {
+            double mean = naive_sma(bars, i + 1, 20);
+            double variance = 0;
+            for (size_t k = i + 1 - 20; k <= i; ++k) {
+                variance += (bars[k].close - mean) * (bars[k].close - mean);
+            }
+            double deviation = std::sqrt(variance / 20);
+            REQUIRE_THAT(bands.middle(), WithinAbs(mean, 1e-9));
+            REQUIRE_THAT(bands.deviation(), WithinAbs(deviation, 1e-6));
+            REQUIRE_THAT(bands.upper(), WithinAbs(mean + 2 * deviation, 1e-6));
+        }
+    }
+
+    SECTION("Tiny spread on a large price") {
+        Bollinger narrow(4, 2.0);
+        for (double close: {50000.00, 50000.01, 50000.00, 50000.01}) {
+            narrow.update(close);
+        }
+        REQUIRE_THAT(narrow.deviation(), WithinAbs(0.005, 1e-9));
+    }
+}
+
+TEST_CASE("Revising the last bar", "[Indicators]") {
+    auto bars = random_bars(400, 4);
+    auto revised = random_bars(400, 5);
+
+    // feed a wrong version of every bar first and then revise it; the result must match a clean run
+    IndicatorEngine clean;
+    IndicatorEngine live;
+    for (auto *engine: {&clean, &live}) {
+        engine->add_sma(15);
+        engine->add_ema(15);
+        engine->add_macd();
+        engine->add_rsi();
+        engine->add_atr();
+        engine->add_bollinger();
+    }
+    for (size_t i = 0; i < bars.size(); ++i) {
+        REQUIRE(clean.on_bar(bars[i]));
+        Bar draft = revised[i];
+        draft.timestamp = bars[i].timestamp;
+        REQUIRE(live.on_bar(draft));
+        REQUIRE(live.on_bar(draft));
+        REQUIRE(live.on_bar(bars[i]));
+    }
+    REQUIRE(live.count() == clean.count());
+    REQUIRE_THAT(live.sma(0).value(), WithinAbs(clean.sma(0).value(), 1e-9));
+    REQUIRE_THAT(live.ema(0).value(), WithinAbs(clean.ema(0).value(), 1e-9));
+    REQUIRE_THAT(live.macd(0).value(), WithinAbs(clean.macd(0).value(), 1e-9));
+    REQUIRE_THAT(live.macd(0).signal(), WithinAbs(clean.macd(0).signal(), 1e-9));
+    REQUIRE_THAT(live.rsi(0).value(), WithinAbs(clean.rsi(0).value(), 1e-9));
+    REQUIRE_THAT(live.atr(0).value(), WithinAbs(clean.atr(0).value(), 1e-9));
+    REQUIRE_THAT(live.bollinger(0).upper(), WithinAbs(clean.bollinger(0).upper(), 1e-6));
+
+    SECTION("Older bars are rejected") {
+        REQUIRE_FALSE(live.on_bar(bars[10]));
+        REQUIRE(live.count() == bars.size());
+    }
+}
+
+TEST_CASE("Indicator engine inputs", "[Indicators]") {
+    auto bars = random_bars(120, 6);
+    ColumnarSeriesOHLCV series(symbol_t("IDX"));
+    for (auto &bar: bars) {
+        series.insert(bar);
+    }
+
+    IndicatorEngine from_columns;
+    IndicatorEngine from_map;
+    from_columns.add_ema(10);
+    from_map.add_ema(10);
+    from_columns.replay(series);
+    from_map.replay(series.to_series());
+    REQUIRE(from_columns.count() == bars.size());
+    REQUIRE(from_map.ema(0).value() == from_columns.ema(0).value());
+
+    SECTION("Aggregator callback") {
+        IndicatorEngine engine;
+        engine.add_sma(3);
+        BarAggregator aggregator(symbol_t("IDX"), {timeframes::SECOND, timeframes::MINUTE});
+        aggregator.on_bar(engine.callback(timeframes::MINUTE));
+        for (timestamp_t t = 0; t < 5 * 60; t += 10) {
+            aggregator.add(t, static_cast<price_t>(t / 60), 1);
+        }
+        aggregator.flush();
+        REQUIRE(engine.count() == 5);
+        REQUIRE(engine.sma(0).value() == 3.0);
+    }
+}
@@ -0,0 +1,88 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/json_stream.h"
+#include "nlohmann/json.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+TEST_CASE("Streaming JSON into a columnar series", "[JsonStream]") {
+    ColumnarSeriesOHLCV series;
+
+    SECTION("Array of bars") {
+        std::istringstream in(R"([{"timestamp": 200, "open": 2.0, "high": 3.0, "low": 1.5, "close": 2.5, "volume": 200},
+                                  {"timestamp": 100, "open": 1, "high": 2, "low": 0.5, "close": 1.5, "volume": 100}])");
+        REQUIRE(load_json(in, series) == 2);
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.timestamps()[0] == 100);
+        REQUIRE(series.open()[0] == 1.0);
+        REQUIRE(series.volume()[1] == 200);
+    }
+
+    SECTION("Unknown keys are skipped") {
+        std::istringstream in(R"([{"timestamp": 100, "symbol": "AAPL", "extra": {"nested": [1, 2, {"a": null}]},
+                                   "open": 1, "high": 2, "low": 0.5, "close": 1.5, "volume": 100}])");
+        REQUIRE(load_json(in, series) == 1);
+        REQUIRE(series.close()[0] == 1.5);
+    }
+
+    SECTION("Empty documents") {
+        std::istringstream empty_array("[]");
+        REQUIRE(load_json(empty_array, series) == 0);
+        std::istringstream null_document(SeriesOHLCV().to_json().dump());
+        REQUIRE(load_json(null_document, series) == 0);
+    }
+
+    SECTION("Errors") {
+        std::istringstream missing(R"([{"timestamp": 100, "open": 1.0}])");
+        REQUIRE_THROWS_AS(load_json(missing, series), OHLCException);
+        std::istringstream not_number(R"([{"timestamp": "100", "open": 1, "high": 2, "low": 0.5, "close": 1.5, "volume": 1}])");
+        REQUIRE_THROWS_AS(load_json(not_number, series), OHLCException);
+        std::istringstream not_array(R"({"timestamp": 100})");
+        REQUIRE_THROWS_AS(load_json(not_array, series), OHLCException);
+        std::istringstream truncated(R"([{"timestamp": 100, "open": 1)");
+        REQUIRE_THROWS_AS(load_json(truncated, series), OHLCException);
+    }
+}
+
+TEST_CASE("Streaming JSON round trip", "[JsonStream]") {
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    SeriesOHLCV original;
+    for (timestamp_t i = 0; i < 100; ++i) {
+        original.insert(OHLCV(symbol, 1704495600 + i * 60, 1.25 + (double) i, 2.5, 0.5, 1.0 / 3.0, i));
+    }
+    auto text = original.to_json().dump();
+
+    SECTION("Into SeriesOHLCV") {
+        std::istringstream in(text);
+        SeriesOHLCV series;
+        REQUIRE(load_json(in, series, symbol) == 100);
+        REQUIRE(series.to_json() == original.to_json());
+        REQUIRE(*series[1704495600].symbol == "AAPL");
+    }
+
+    SECTION("Into a callback") {
+        std::istringstream in(text);
+        size_t volume = 0;
+        REQUIRE(load_json(in, [&](const ColumnarSeriesOHLCV::Bar &bar) { volume += bar.volume; }) == 100);
+        REQUIRE(volume == 99 * 100 / 2);
+    }
+
+    SECTION("From a file") {
+        auto path = (std::filesystem::temp_directory_path() / "trading_common_stream.json").string();
+        std::ofstream(path) << text;
+        ColumnarSeriesOHLCV series;
+        REQUIRE(load_json_file(path, series) == 100);
+        REQUIRE(series.to_json() == original.to_json());
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(load_json_file(path, series), OHLCException);
+    }
+}
@@ -0,0 +1,157 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/json_writer.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace trading::common;
+using Order = trading::order::Order;
+using Position = trading::position::Position;
+
+namespace {
+    struct Settings {
+        int period = 14;
+
+        [[nodiscard]] json to_json() const { return {{"period", period}}; }
+
+        void from_json(const json &j) { period = j.at("period"); }
+
+        bool validate() { return period > 0; }
+    };
+
+    struct StreamedSettings : Settings {
+        void write_json(JsonWriter &writer) const {
+            writer.raw("{\"period\":");
+            writer.number(period);
+            writer.raw("}");
+        }
+    };
+
+    template<typename T>
+    std::string written(const T &value) {
+        JsonWriter writer;
+        writer.write(value);
+        return std::string(writer.view());
+    }
+}
+
+TEST_CASE("JsonWriter matches to_json().dump()", "[JsonWriter]") {
+    symbol_t symbol("AAPL");
+
+    SECTION("Doubles") {
+        std::mt19937_64 random(7);
+        std::uniform_real_distribution<double> prices(0, 10'000);
+        std::uniform_int_distribution<uint64_t> bits;
+        JsonWriter writer;
+        for (int i = 0; i < 200'000; ++i) {
+            double value = i % 2 ? prices(random) : 0;
+            if (i % 2 == 0) {
+                uint64_t pattern = bits(random);
+                std::memcpy(&value, &pattern, sizeof(value));
+            }
+            writer.clear();
+            writer.number(value);
+            REQUIRE(writer.view() == json(value).dump());
+        }
+        for (double value: {0.0, -0.0, 1e-5, 1e-4, 1e15, 1e16, 1e17, 0.1, 100.0, -2.5,
+                            std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min(),
+                            std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                            std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()}) {
+            writer.clear();
+            writer.number(value);
+            REQUIRE(writer.view() == json(value).dump());
+        }
+    }
+
+    SECTION("Strings") {
+        std::string all;
+        for (int c = 1; c < 128; ++c) {
+            all += static_cast<char>(c);
+        }
+        for (const std::string &text: {std::string(), std::string("plain"), all,
+                                       std::string("caf\xc3\xa9 \xe2\x82\xac"), std::string("a\0b", 3)}) {
+            JsonWriter writer;
+            writer.string(text);
+            REQUIRE(writer.view() == json(text).dump());
+        }
+    }
+
+    SECTION("Bars and series") {
+        OHLCV bar(symbol, 1704495600, 187.15, 188.44, -0.0, 1.0 / 3, std::numeric_limits<size_t>::max());
+        REQUIRE(written(bar) == bar.to_json().dump());
+
+        SeriesOHLCV series;
+        REQUIRE(written(series) == "null");
+        REQUIRE(written(series) == series.to_json().dump());
+        series.insert(bar);
+        series.insert(OHLCV(symbol, 60, 1, 2, 0.5, std::numeric_limits<double>::quiet_NaN(), 10));
+        REQUIRE(written(series) == series.to_json().dump());
+
+        ColumnarSeriesOHLCV columnar(symbol);
+        REQUIRE(written(columnar) == columnar.to_json().dump());
+        ColumnarSeriesOHLCV filled(series);
+        REQUIRE(written(filled) == filled.to_json().dump());
+    }
+
+    SECTION("Orders and positions") {
+        Order order(1704495600, 200, symbol, trading::order::Side::SELL, 150, 101.25, 101.3, "order \"1\"\n",
+                    trading::order::Type::LIMIT, trading::order::Status::CANCELED);
+        REQUIRE(written(order) == order.to_json().dump());
+        Order empty;
+        REQUIRE(written(empty) == empty.to_json().dump());
+
+        using Cents = FixedPrice<2>;
+        trading::order::BasicOrder<Cents> cents(1, 5, symbol, trading::order::Side::BUY, 5, Cents::from_ticks(10125),
+                                                Cents(), "1", trading::order::Type::MARKET,
+                                                trading::order::Status::FILLED);
+        REQUIRE(written(cents) == cents.to_json().dump());
+
+        Position position("position-1", 1704495600, 10, symbol, trading::position::Side::SHORT, 100.5, 99.25,
+                          12.5);
+        REQUIRE(written(position) == position.to_json().dump());
+        Position flat;
+        REQUIRE(written(flat) == flat.to_json().dump());
+    }
+
+    SECTION("Instructions") {
+        trading::instructions::Instructions<Settings> instructions;
+        REQUIRE(written(instructions) == instructions.to_json().dump());
+        instructions.type = trading::instructions::Type::SMA;
+        instructions.selector = trading::instructions::Selector::SET;
+        instructions.tickers = {"AAPL", "MSFT"};
+        REQUIRE(written(instructions) == instructions.to_json().dump());
+
+        trading::instructions::Instructions<StreamedSettings> streamed;
+        streamed.tickers = {"AAPL"};
+        streamed.timestamp = instructions.timestamp;
+        streamed.other.period = 50;
+        REQUIRE(written(streamed) == streamed.to_json().dump());
+    }
+}
+
+TEST_CASE("JsonWriter reuses its buffer", "[JsonWriter]") {
+    Order order(1704495600, 200, symbol_t("AAPL"), trading::order::Side::BUY, 200, 185.64, 185.7, "order-1",
+                trading::order::Type::LIMIT, trading::order::Status::FILLED);
+    JsonWriter writer(16);
+    writer.write(order);
+    writer.raw("\n");
+    writer.write(order);
+    REQUIRE(writer.view() == order.to_json().dump() + "\n" + order.to_json().dump());
+
+    writer.clear();
+    REQUIRE(writer.empty());
+    writer.write(order);
+    const char *data = writer.view().data();
+    for (int i = 0; i < 100; ++i) {
+        writer.clear();
+        writer.write(order);
+    }
+    REQUIRE(writer.view().data() == data);
+    REQUIRE(writer.view() == order.to_json().dump());
+}
@@ -0,0 +1,204 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/kernels.h"
+#include "trading_common/indicators.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace trading::kernels;
+
+namespace {
+    std::vector<double> random_prices(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0, 1);
+        std::vector<double> prices(count);
+        double price = 1000;
+        for (auto &p: prices) {
+            price = std::max(1.0, price + step(rng));
+            p = price;
+        }
+        return prices;
+    }
+
+    void require_close(const std::vector<double> &actual, const std::vector<double> &expected, double tolerance) {
+        REQUIRE(actual.size() == expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            INFO("index " << i);
+            if (std::isnan(expected[i])) {
+                REQUIRE(std::isnan(actual[i]));
+            } else {
+                REQUIRE_THAT(actual[i], Catch::Matchers::WithinRel(expected[i], tolerance)
+                                        || Catch::Matchers::WithinAbs(expected[i], tolerance));
+            }
+        }
+    }
+
+    std::vector<Isa> available_isas() {
+        std::vector<Isa> isas;
+        for (auto isa: {Isa::SCALAR, Isa::AVX2, Isa::AVX512}) {
+            if (isa <= supported_isa()) {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+}
+
+TEST_CASE("Kernels match naive loops on every code path", "[Kernels]") {
+    // odd sizes and windows so every vector loop leaves a tail
+    auto prices = random_prices(20'011, 1);
+    auto high = prices, low = prices, close = random_prices(prices.size(), 2);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        high[i] = std::max(prices[i], close[i]) + 0.5;
+        low[i] = std::min(prices[i], close[i]) - 0.5;
+    }
+    const size_t n = prices.size();
+
+    for (auto isa: available_isas()) {
+        REQUIRE(set_isa(isa) == isa);
+        INFO("isa " << isa_name(isa));
+        std::vector<double> out(n), expected(n);
+
+        for (size_t window: {1, 3, 20, 50, 257}) {
+            INFO("window " << window);
+            for (size_t i = 0; i < n; ++i) {
+                if (i + 1 < window) {
+                    expected[i] = NaN;
+                    continue;
+                }
+                double sum = 0;
+                for (size_t k = i + 1 - window; k <= i; ++k) {
+                    sum += prices[k];
+                }
+                expected[i] = sum;
+            }
+            rolling_sum(prices, window, out);
+            require_close(out, expected, 1e-9);
+            for (auto &e: expected) {
+                e /= static_cast<double>(window);
+            }
+            rolling_mean(prices, window, out);
+            require_close(out, expected, 1e-9);
+
+            for (bool is_max: {true, false}) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (i + 1 < window) {
+                        expected[i] = NaN;
+                        continue;
+                    }
+                    double extreme = prices[i];
+                    for (size_t k = i + 1 - window; k <= i; ++k) {
+                        extreme = is_max ? std::max(extreme, prices[k]) : std::min(extreme, prices[k]);
+                    }
+                    expected[i] = extreme;
+                }
+                is_max ? rolling_max(prices, window, out) : rolling_min(prices, window, out);
+                require_close(out, expected, 0);
+            }
+        }
+
+        expected[0] = high[0] - low[0];
+        for (size_t i = 1; i < n; ++i) {
+            expected[i] = std::max({high[i] - low[i], std::abs(high[i] - close[i - 1]),
+                                    std::abs(low[i] - close[i - 1])});
+        }
+        true_range(high, low, close, out);
+        require_close(out, expected, 0);
+
+        expected[0] = NaN;
+        for (size_t i = 1; i < n; ++i) {
+            expected[i] = prices[i] / prices[i - 1] - 1;
+        }
+        returns(prices, out);
+        require_close(out, expected, 1e-15);
+
+        for (size_t i = 1; i < n; ++i) {
+            expected[i] = std::log(prices[i] / prices[i - 1]);
+        }
+        log_returns(prices, out);
+        require_close(out, expected, 1e-14);
+    }
+    set_isa(supported_isa());
+}
+
+TEST_CASE("Vector log handles every range", "[Kernels]") {
+    std::vector<double> values = {1, 2, 1e-300, 1e300, 0.5, 3, 1e-310, 5, 7, 0, -1, 4, 1, 1, 1, 1,
+                                  std::numeric_limits<double>::infinity(), 2, NaN, 8};
+    std::vector<double> out(values.size());
+    for (auto isa: available_isas()) {
+        set_isa(isa);
+        INFO("isa " << isa_name(isa));
+        log_returns(values, out);
+        for (size_t i = 1; i < values.size(); ++i) {
+            double expected = std::log(values[i] / values[i - 1]);
+            INFO("index " << i);
+            if (std::isnan(expected)) {
+                REQUIRE(std::isnan(out[i]));
+            } else if (std::isinf(expected)) {
+                REQUIRE(out[i] == expected);
+            } else {
+                REQUIRE_THAT(out[i], Catch::Matchers::WithinRel(expected, 1e-14)
+                                     || Catch::Matchers::WithinAbs(expected, 1e-15));
+            }
+        }
+    }
+    set_isa(supported_isa());
+}
+
+TEST_CASE("Batch EMA matches the streaming indicator", "[Kernels]") {
+    auto prices = random_prices(1000, 3);
+    std::vector<double> out(prices.size());
+    ema(prices, 10, out);
+    trading::indicators::EMA streaming(10);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        streaming.update(prices[i]);
+        if (streaming.ready()) {
+            REQUIRE(out[i] == streaming.value());
+        } else {
+            REQUIRE(std::isnan(out[i]));
+        }
+    }
+}
+
+TEST_CASE("Kernel edge cases", "[Kernels]") {
+    std::vector<double> prices = {1, 2, 3};
+    std::vector<double> out(3);
+
+    SECTION("Window longer than the input") {
+        rolling_sum(prices, 5, out);
+        rolling_max(prices, 5, out);
+        for (double v: out) {
+            REQUIRE(std::isnan(v));
+        }
+    }
+
+    SECTION("Empty input") {
+        std::vector<double> empty;
+        rolling_sum(empty, 3, empty);
+        rolling_min(empty, 3, empty);
+        returns(empty, empty);
+        true_range(empty, empty, empty, empty);
+    }
+
+    SECTION("Bad arguments") {
+        std::vector<double> shorter(2);
+        REQUIRE_THROWS_AS(rolling_sum(prices, 2, shorter), KernelException);
+        REQUIRE_THROWS_AS(rolling_mean(prices, 0, out), KernelException);
+        REQUIRE_THROWS_AS(true_range(prices, prices, shorter, out), KernelException);
+    }
+
+    SECTION("ISA selection is clamped") {
+        REQUIRE(set_isa(Isa::AVX512) == supported_isa());
+        REQUIRE(active_isa() == supported_isa());
+        REQUIRE(set_isa(Isa::SCALAR) == Isa::SCALAR);
+        set_isa(supported_isa());
+    }
+}
@@ -0,0 +1,159 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/market_data_store.h"
+#include <unordered_set>
+#include <thread>
+
+using namespace trading::common;
+
+namespace {
+    OHLCV bar_of(const std::string &symbol, timestamp_t timestamp) {
+        auto price = static_cast<double>(timestamp % 1000);
+        return {symbol_t(symbol), timestamp, price, price + 1, price - 1, price + 0.5, timestamp};
+    }
+}
+
+TEST_CASE("MarketDataStore appends and retrieves per symbol", "[MarketDataStore]") {
+    MarketDataStore store(3);
+    REQUIRE(store.shards() == 4);
+    REQUIRE(store.size() == 0);
+
+    REQUIRE(store.append(bar_of("MDS_A", 100)));
+    REQUIRE(store.append(bar_of("MDS_A", 200)));
+    REQUIRE(store.append(bar_of("MDS_B", 100)));
+    REQUIRE_FALSE(store.append(bar_of("MDS_A", 150)));
+    REQUIRE(store.size() == 2);
+
+    SECTION("Snapshots") {
+        auto a = store.snapshot(symbol_t("MDS_A"));
+        REQUIRE(a);
+        REQUIRE(a->size() == 2);
+        REQUIRE(*a->symbol() == "MDS_A");
+        REQUIRE(a->back().timestamp == 200);
+        REQUIRE(store.last(symbol_t("MDS_A"))->timestamp == 200);
+        REQUIRE_FALSE(store.last(symbol_t("MDS_MISSING")));
+        REQUIRE_FALSE(store.snapshot(symbol_t("MDS_MISSING")));
+        REQUIRE_FALSE(store.contains(symbol_t("MDS_MISSING")));
+        REQUIRE(store.size() == 2);
+    }
+
+    SECTION("Series pointers stay valid") {
+        const ConcurrentSeriesOHLCV *series = store.series(symbol_t("MDS_B"));
+        REQUIRE(series != nullptr);
+        for (int i = 0; i < 100; ++i) {
+            store.append(bar_of("MDS_NEW_" + std::to_string(i), 1));
+        }
+        REQUIRE(series == store.series(symbol_t("MDS_B")));
+        REQUIRE(series->size() == 1);
+    }
+
+    SECTION("Symbols and for_each") {
+        auto symbols = store.symbols();
+        REQUIRE(std::unordered_set<symbol_t>(symbols.begin(), symbols.end())
+                == std::unordered_set<symbol_t>{symbol_t("MDS_A"), symbol_t("MDS_B")});
+        size_t bars = 0;
+        store.for_each([&](const symbol_t &symbol, const MarketDataStore::Snapshot &snapshot) {
+            REQUIRE(snapshot.symbol() == symbol);
+            bars += snapshot.size();
+        });
+        REQUIRE(bars == 3);
+    }
+
+    SECTION("Null symbol") {
+        REQUIRE_FALSE(store.contains(symbol_t(nullptr)));
+        REQUIRE_THROWS_AS(store.append(symbol_t(nullptr), MarketDataStore::Bar{}), OHLCException);
+    }
+}
+
+TEST_CASE("MarketDataStore bulk ingest and concurrent use", "[MarketDataStore]") {
+    constexpr size_t SYMBOLS = 200;
+    constexpr size_t BARS = 50;
+    std::vector<OHLCV> bars;
+    // interleaved like a feed: every symbol gets its bars in timestamp order
+    for (size_t b = 0; b < BARS; ++b) {
+        for (size_t s = 0; s < SYMBOLS; ++s) {
+            bars.push_back(bar_of("MDS_BULK_" + std::to_string(s), 1000 + b));
+        }
+    }
+
+    MarketDataStore store(16);
+    REQUIRE(store.ingest(bars, 4) == SYMBOLS * BARS);
+    REQUIRE(store.size() == SYMBOLS);
+    for (size_t s = 0; s < SYMBOLS; ++s) {
+        auto snapshot = store.snapshot(symbol_t("MDS_BULK_" + std::to_string(s)));
+        REQUIRE(snapshot->size() == BARS);
+        REQUIRE(snapshot->at(0).timestamp == 1000);
+        REQUIRE(snapshot->back().timestamp == 1000 + BARS - 1);
+    }
+    // a second ingest of the same bars appends nothing
+    REQUIRE(store.ingest(bars, 3) == 0);
+
+    SECTION("Parallel for_each visits every symbol once") {
+        std::atomic<size_t> visited{0}, total{0};
+        store.for_each([&](const symbol_t &, const MarketDataStore::Snapshot &snapshot) {
+            visited.fetch_add(1);
+            total.fetch_add(snapshot.size());
+        }, 4);
+        REQUIRE(visited == SYMBOLS);
+        REQUIRE(total == SYMBOLS * BARS);
+    }
+
+    SECTION("A throwing visitor reaches the caller once every thread is joined") {
+        std::atomic<size_t> visited{0};
+        REQUIRE_THROWS_AS(store.for_each([&](const symbol_t &symbol, const MarketDataStore::Snapshot &) {
+            visited.fetch_add(1);
+            if (*symbol == "MDS_BULK_7" || *symbol == "MDS_BULK_8") {
+                throw OHLCException("visitor failed on " + *symbol);
+            }
+        }, 4), OHLCException);
+        REQUIRE(visited > 0);
+        REQUIRE(store.size() == SYMBOLS);
+    }
+
+    SECTION("A bar ingest cannot store fails after every thread is joined") {
+        std::vector<OHLCV> mixed(bars.begin(), bars.begin() + SYMBOLS);
+        for (auto &bar: mixed) {
+            bar.timestamp += BARS;
+        }
+        mixed.push_back({symbol_t(nullptr), 1, 1, 1, 1, 1, 1});
+        REQUIRE_THROWS_AS(store.ingest(mixed, 4), OHLCException);
+        REQUIRE(store.size() == SYMBOLS);
+    }
+
+    SECTION("Writers on new symbols while readers look up") {
+        std::atomic<bool> done{false};
+        std::atomic<size_t> seen{0};
+        std::thread reader([&] {
+            while (!done.load()) {
+                for (size_t s = 0; s < SYMBOLS; ++s) {
+                    if (auto snapshot = store.snapshot(symbol_t("MDS_BULK_" + std::to_string(s)))) {
+                        seen.fetch_add(snapshot->size() == BARS);
+                    }
+                }
+            }
+        });
+        std::vector<std::thread> writers;
+        for (size_t w = 0; w < 4; ++w) {
+            writers.emplace_back([&store, w] {
+                for (size_t i = 0; i < 100; ++i) {
+                    std::string name = "MDS_W" + std::to_string(w) + "_" + std::to_string(i);
+                    for (timestamp_t t = 1; t <= 5; ++t) {
+                        store.append(bar_of(name, t));
+                    }
+                }
+            });
+        }
+        for (auto &writer: writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        REQUIRE(store.size() == SYMBOLS + 400);
+        REQUIRE(store.snapshot(symbol_t("MDS_W3_99"))->size() == 5);
+        REQUIRE(seen > 0);
+    }
+}
@@ -327,3 +327,154 @@ TEST_CASE("SeriesOHLCV iterator Functionality", "[SeriesOHLCV]") {
 
 
 }
+
+TEST_CASE("SeriesOHLCV iterator locking", "[SeriesOHLCV]") {
+    SeriesOHLCV series;
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    series.insert(OHLCV(symbol, 1704510000, 1.5, 2.5, 0.5, 1.0, 100));
+    series.insert(OHLCV(symbol, 1704520000, 2.5, 3.5, 1.5, 2.0, 200));
+
+    SECTION("Copied iterators release the lock once") {
+        {
+            auto it = series.begin();
+            auto copy = it;
+            ++copy;
+            const auto &[timestamp, ohlc] = *copy;
+            REQUIRE(timestamp == 1704520000);
+        }
+        REQUIRE(series.insert(OHLCV(symbol, 1704530000, 3.5, 4.5, 2.5, 3.0, 300)));
+        REQUIRE(series.size() == 3);
+    }
+}
+
+TEST_CASE("SeriesOHLCV range queries", "[SeriesOHLCV]") {
+    SeriesOHLCV series;
+    symbol_t symbol("AAPL");
+    for (int i = 1; i <= 5; ++i) {
+        series.insert(OHLCV(symbol, 1704500000 + i * 10000, i + 0.5, i + 1.5, i - 0.5, i, i * 100));
+    }
+
+    auto timestamps = [](const SeriesOHLCV::Range &range) {
+        std::vector<timestamp_t> result;
+        for (auto it = range.begin(); it != range.end(); ++it) {
+            result.push_back((*it).first);
+        }
+        return result;
+    };
+
+    SECTION("find does not insert on a miss") {
+        REQUIRE(series.find(1704530000)->volume == 300);
+        REQUIRE_FALSE(series.find(1704535000));
+        REQUIRE(series.size() == 5);
+    }
+
+    SECTION("as_of returns the last bar at or before the time") {
+        REQUIRE(series.as_of(1704530000)->timestamp == 1704530000);
+        REQUIRE(series.as_of(1704539999)->timestamp == 1704530000);
+        REQUIRE(series.as_of(1704999999)->timestamp == 1704550000);
+        REQUIRE_FALSE(series.as_of(1704509999));
+        REQUIRE(series.size() == 5);
+    }
+
+    SECTION("range is half open") {
+        REQUIRE(timestamps(series.range(1704520000, 1704540000))
+                == std::vector<timestamp_t>{1704520000, 1704530000});
+        REQUIRE(timestamps(series.range(1704515000, 1704999999))
+                == std::vector<timestamp_t>{1704520000, 1704530000, 1704540000, 1704550000});
+        REQUIRE(series.range(1704520000, 1704520000).empty());
+        REQUIRE(series.range(1704540000, 1704520000).empty());
+        REQUIRE(series.range(1704600000, 1704700000).empty());
+    }
+
+    SECTION("last") {
+        REQUIRE(timestamps(series.last(2)) == std::vector<timestamp_t>{1704540000, 1704550000});
+        REQUIRE(timestamps(series.last(10)).size() == 5);
+        REQUIRE(series.last(0).empty());
+    }
+
+    SECTION("A range holds the lock until it is destroyed") {
+        {
+            auto range = series.last(1);
+            const auto &[timestamp, ohlc] = *range.begin();
+            REQUIRE(ohlc.volume == 500);
+        }
+        REQUIRE(series.insert(OHLCV(symbol, 1704560000, 6.5, 7.5, 5.5, 6.0, 600)));
+        REQUIRE(series.size() == 6);
+    }
+}
+
+TEST_CASE("SeriesOHLCV duplicate policies and bulk insert", "[SeriesOHLCV]") {
+    SeriesOHLCV series;
+    symbol_t symbol = std::make_shared<std::string>("AAPL");
+    series.insert(OHLCV(symbol, 100, 10, 12, 9, 11, 100));
+    OHLCV later(symbol, 100, 11, 14, 10, 13, 50);
+
+    SECTION("Keep") {
+        REQUIRE(series.insert(later, DuplicatePolicy::KEEP));
+        REQUIRE(series.find(100)->close == 11);
+    }
+
+    SECTION("Replace") {
+        REQUIRE(series.insert(later, DuplicatePolicy::REPLACE));
+        REQUIRE(series.find(100)->open == 11);
+        REQUIRE(series.find(100)->volume == 50);
+    }
+
+    SECTION("Aggregate") {
+        REQUIRE(series.insert(later, DuplicatePolicy::AGGREGATE));
+        auto bar = *series.find(100);
+        REQUIRE(bar.open == 10);
+        REQUIRE(bar.high == 14);
+        REQUIRE(bar.low == 9);
+        REQUIRE(bar.close == 13);
+        REQUIRE(bar.volume == 150);
+    }
+
+    SECTION("Sorted batches are merged around the existing bars") {
+        std::vector<OHLCV> batch;
+        for (timestamp_t t: {40, 100, 100, 160, 220}) {
+            batch.emplace_back(symbol, t, 1, 20, 1, static_cast<double>(t), 1);
+        }
+        REQUIRE(series.insert(batch, DuplicatePolicy::AGGREGATE));
+        REQUIRE(series.size() == 4);
+        REQUIRE(series.find(100)->volume == 102);
+        REQUIRE(series.find(100)->high == 20);
+        REQUIRE(series.find(220)->close == 220);
+        REQUIRE(series.begin() != series.end());
+        REQUIRE((*series.begin()).first == 40);
+    }
+
+    SECTION("Unsorted batches match inserting one bar at a time") {
+        std::vector<OHLCV> batch;
+        for (size_t i = 0; i < 50'000; ++i) {
+            // many repeated timestamps, each one seen in a known order
+            auto t = static_cast<timestamp_t>((i * 7919) % 20'000);
+            batch.emplace_back(symbol, t, 1, static_cast<double>(i), 1, static_cast<double>(i), 1);
+        }
+        SeriesOHLCV one_by_one;
+        one_by_one.insert(OHLCV(symbol, 100, 10, 12, 9, 11, 100));
+        for (const auto &bar: batch) {
+            one_by_one.insert(bar, DuplicatePolicy::AGGREGATE);
+        }
+        REQUIRE(series.insert(batch, DuplicatePolicy::AGGREGATE, 4));
+        REQUIRE(series.size() == one_by_one.size());
+        for (timestamp_t t = 0; t < 20'000; ++t) {
+            auto expected = one_by_one.find(t);
+            auto bar = series.find(t);
+            REQUIRE(bar->close == expected->close);
+            REQUIRE(bar->high == expected->high);
+            REQUIRE(bar->volume == expected->volume);
+        }
+    }
+
+    SECTION("Merging another series replaces its duplicates") {
+        SeriesOHLCV other;
+        other.insert(later);
+        other.insert(OHLCV(symbol, 50, 1, 1, 1, 1, 1));
+        REQUIRE(series.insert(other, DuplicatePolicy::REPLACE));
+        REQUIRE(series.size() == 2);
+        REQUIRE(series.find(100)->close == 13);
+        REQUIRE(series.insert(series, DuplicatePolicy::AGGREGATE));
+        REQUIRE(series.find(100)->volume == 50);
+    }
+}
@@ -246,5 +246,22 @@ TEST_CASE("Order Validation Tests", "[Order]") {
         REQUIRE(canceled_order.validate().success == true);
     }
 
-}
+    SECTION("A LIMIT order matches a bar only if its price is in the range") {
+        symbol_t symbol = std::make_shared<std::string>("BTC");
+        Order above(100, 10, symbol, Side::BUY, 0, 0, 120, "1", Type::LIMIT, Status::OPEN);
+        OHLCV bar(symbol, 100, 100, 110, 90, 105, 4);
+        above.check_match_price(bar);
+        REQUIRE(above.status == Status::OPEN);
+
+        Order inside(100, 10, symbol, Side::BUY, 0, 0, 95, "2", Type::LIMIT, Status::OPEN);
+        inside.check_match_price(bar);
+        REQUIRE(inside.status == Status::FILLED);
+        REQUIRE(inside.filled == 4);
+        REQUIRE(inside.filled_at_price == 95);
 
+        OHLC range(100, 110, 90, 105);
+        Order below(100, 10, symbol, Side::BUY, 0, 0, 80, "3", Type::LIMIT, Status::OPEN);
+        below.check_match_price(range);
+        REQUIRE(below.status == Status::OPEN);
+    }
+}
@@ -0,0 +1,291 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/order_book.h"
+#include "trading_common/position.h"
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace trading::order;
+
+namespace {
+    struct Execution {
+        std::string taker;
+        std::string maker;
+        size_t quantity = 0;
+        price_t price = 0;
+    };
+
+    symbol_t btc() {
+        return std::make_shared<std::string>("BTC");
+    }
+
+    Order limit(Side side, size_t quantity, price_t price, const char *id) {
+        return {100, quantity, btc(), side, 0, 0, price, id, Type::LIMIT, Status::OPEN};
+    }
+
+    Order market(Side side, size_t quantity, const char *id) {
+        return {100, quantity, btc(), side, 0, 0, 0, id, Type::MARKET, Status::OPEN};
+    }
+
+    size_t generated = 0;
+
+    Id counting_generator() {
+        return Id::from_number(++generated);
+    }
+}
+
+TEST_CASE("Order book", "[OrderBook]") {
+    OrderBook book(btc());
+    std::vector<Execution> executions;
+    book.on_fill([&executions](const Fill &fill) {
+        executions.push_back({fill.taker->id.str(), fill.maker->id.str(), fill.quantity, fill.price});
+    });
+
+    SECTION("Resting orders make the levels of each side") {
+        REQUIRE(book.add(limit(Side::BUY, 10, 99, "b1")).resting);
+        REQUIRE(book.add(limit(Side::BUY, 5, 100, "b2")).resting);
+        REQUIRE(book.add(limit(Side::BUY, 7, 99, "b3")).resting);
+        REQUIRE(book.add(limit(Side::SELL, 4, 102, "a1")).resting);
+        REQUIRE(book.add(limit(Side::SELL, 6, 101, "a2")).resting);
+
+        REQUIRE(book.best_bid() == 100);
+        REQUIRE(book.best_ask() == 101);
+        REQUIRE(book.levels(Side::BUY) == 2);
+        REQUIRE(book.levels(Side::SELL) == 2);
+        REQUIRE(book.volume_at(Side::BUY, 99) == 17);
+        REQUIRE(book.volume_at(Side::SELL, 99) == 0);
+        REQUIRE(book.size() == 5);
+        REQUIRE(executions.empty());
+        REQUIRE(book.find("b3")->quantity == 7);
+        REQUIRE(book.find("missing") == nullptr);
+    }
+
+    SECTION("Price-time priority with partial fills") {
+        book.add(limit(Side::SELL, 5, 101, "a1"));
+        book.add(limit(Side::SELL, 5, 100, "a2"));
+        book.add(limit(Side::SELL, 5, 100, "a3"));
+
+        auto result = book.add(limit(Side::BUY, 12, 101, "b1"));
+        REQUIRE(result.success);
+        REQUIRE(result.filled == 12);
+        REQUIRE(result.canceled == 0);
+        REQUIRE_FALSE(result.resting);
+        REQUIRE(executions.size() == 3);
+        REQUIRE(executions[0].maker == "a2");
+        REQUIRE(executions[0].price == 100);
+        REQUIRE(executions[1].maker == "a3");
+        REQUIRE(executions[2].maker == "a1");
+        REQUIRE(executions[2].quantity == 2);
+        REQUIRE(executions[2].price == 101);
+        REQUIRE(book.find("a2") == nullptr);
+        REQUIRE(book.find("a1")->filled == 2);
+        REQUIRE(book.volume_at(Side::SELL, 101) == 3);
+        REQUIRE(book.levels(Side::SELL) == 1);
+    }
+
+    SECTION("A limit order only takes prices up to its limit and rests the rest") {
+        book.add(limit(Side::SELL, 5, 100, "a1"));
+        book.add(limit(Side::SELL, 5, 102, "a2"));
+
+        auto result = book.add(limit(Side::BUY, 8, 101, "b1"));
+        REQUIRE(result.filled == 5);
+        REQUIRE(result.resting);
+        REQUIRE(result.canceled == 0);
+        REQUIRE(book.best_bid() == 101);
+        REQUIRE(book.best_ask() == 102);
+        const Order *resting = book.find("b1");
+        REQUIRE(resting->filled == 5);
+        REQUIRE(resting->filled_at_price == 100);
+        REQUIRE(resting->status == Status::OPEN);
+        REQUIRE(book.volume_at(Side::BUY, 101) == 3);
+    }
+
+    SECTION("What a market order cannot fill is canceled") {
+        book.add(limit(Side::BUY, 5, 100, "b1"));
+        book.add(limit(Side::BUY, 5, 99, "b2"));
+
+        auto result = book.add(market(Side::SELL, 20, "s1"));
+        REQUIRE(result.success);
+        REQUIRE(result.filled == 10);
+        REQUIRE(result.canceled == 10);
+        REQUIRE_FALSE(result.resting);
+        REQUIRE(book.empty());
+        REQUIRE(book.best_bid() == 0);
+        auto unfilled = book.add(market(Side::BUY, 1, "m2"));
+        REQUIRE(unfilled.filled == 0);
+        REQUIRE(unfilled.canceled == 1);
+    }
+
+    SECTION("Cancel") {
+        book.add(limit(Side::BUY, 5, 100, "b1"));
+        book.add(limit(Side::BUY, 5, 100, "b2"));
+        book.add(limit(Side::BUY, 5, 100, "b3"));
+        book.add(limit(Side::BUY, 5, 98, "b4"));
+
+        REQUIRE(book.cancel("b2"));
+        REQUIRE_FALSE(book.cancel("b2"));
+        REQUIRE(book.volume_at(Side::BUY, 100) == 10);
+        REQUIRE(book.cancel("b4"));
+        REQUIRE(book.levels(Side::BUY) == 1);
+
+        book.add(market(Side::SELL, 6, "s1"));
+        REQUIRE(executions.size() == 2);
+        REQUIRE(executions[0].maker == "b1");
+        REQUIRE(executions[1].maker == "b3");
+
+        REQUIRE(book.cancel("b3"));
+        REQUIRE(book.empty());
+        REQUIRE(book.levels(Side::BUY) == 0);
+    }
+
+    SECTION("Amend") {
+        book.add(limit(Side::SELL, 5, 101, "a1"));
+        book.add(limit(Side::SELL, 5, 101, "a2"));
+
+        // a smaller quantity at the same price keeps the place in the queue
+        REQUIRE(book.amend("a1", 3, 101));
+        REQUIRE(book.volume_at(Side::SELL, 101) == 8);
+        book.add(market(Side::BUY, 1, "m1"));
+        REQUIRE(executions.back().maker == "a1");
+
+        // a larger one goes to the back
+        REQUIRE(book.amend("a1", 10, 101));
+        book.add(market(Side::BUY, 1, "m2"));
+        REQUIRE(executions.back().maker == "a2");
+        REQUIRE(book.find("a1")->filled == 1);
+        REQUIRE(book.volume_at(Side::SELL, 101) == 13);
+
+        // a new price that crosses matches
+        book.add(limit(Side::BUY, 4, 100, "b1"));
+        REQUIRE(book.amend("a2", 5, 100));
+        REQUIRE(executions.back().maker == "b1");
+        REQUIRE(executions.back().taker == "a2");
+        REQUIRE(executions.back().quantity == 4);
+        REQUIRE(book.find("b1") == nullptr);
+        REQUIRE(book.find("a2") == nullptr);
+        REQUIRE(book.best_ask() == 101);
+
+        // down to what is filled cancels
+        REQUIRE(book.amend("a1", 1, 101));
+        REQUIRE(book.empty());
+        REQUIRE_FALSE(book.amend("a1", 5, 101));
+    }
+
+    SECTION("Rejected orders") {
+        book.add(limit(Side::BUY, 5, 100, "b1"));
+        REQUIRE_FALSE(book.add(limit(Side::BUY, 5, 100, "b1")).success);
+        REQUIRE_FALSE(book.add(limit(Side::BUY, 0, 100, "b2")).success);
+        REQUIRE_FALSE(book.add(limit(Side::BUY, 5, 0, "b3")).success);
+
+        Order other = limit(Side::BUY, 5, 100, "b4");
+        other.symbol = std::make_shared<std::string>("ETH");
+        REQUIRE_FALSE(book.add(other).success);
+
+        Order filled = limit(Side::BUY, 5, 100, "b5");
+        filled.status = Status::FILLED;
+        REQUIRE_FALSE(book.add(filled).success);
+        REQUIRE(book.size() == 1);
+        REQUIRE(executions.empty());
+    }
+}
+
+TEST_CASE("Order book index under many adds and cancels", "[OrderBook]") {
+    OrderBook book(btc());
+    std::mt19937_64 random(7);
+    std::map<std::string, std::pair<Side, price_t>> live;
+    std::vector<std::string> ids;
+    bool consistent = true;
+    for (size_t i = 0; i < 20'000; ++i) {
+        if (random() % 3 == 0 && !ids.empty()) {
+            size_t at = random() % ids.size();
+            consistent = consistent && book.cancel(ids[at]) == (live.erase(ids[at]) == 1);
+            ids[at] = ids.back();
+            ids.pop_back();
+        } else {
+            // number ids from the generator and text ids, some of them digits
+            Id id = i % 2 == 0 ? next_id() : Id(i % 4 == 1 ? "order-" + std::to_string(i) : std::to_string(i));
+            Side side = random() % 2 == 0 ? Side::BUY : Side::SELL;
+            price_t price = side == Side::BUY ? 90 + static_cast<price_t>(random() % 10)
+                                              : 101 + static_cast<price_t>(random() % 10);
+            Order order(1, 1 + random() % 10, btc(), side, 0, 0, price, id, Type::LIMIT, Status::OPEN);
+            consistent = consistent && book.add(order).resting;
+            live[id.str()] = {side, price};
+            ids.push_back(id.str());
+        }
+    }
+    REQUIRE(consistent);
+    REQUIRE(book.size() == live.size());
+    std::map<std::pair<Side, price_t>, size_t> volumes;
+    for (const auto &[id, level]: live) {
+        const Order *order = book.find(id);
+        REQUIRE(order != nullptr);
+        volumes[level] += order->quantity;
+    }
+    for (const auto &[level, volume]: volumes) {
+        REQUIRE(book.volume_at(level.first, level.second) == volume);
+    }
+    REQUIRE(book.levels(Side::BUY) + book.levels(Side::SELL) == volumes.size());
+}
+
+TEST_CASE("Order book pool does not generate ids", "[OrderBook]") {
+    OrderBook book(btc());
+    std::vector<Order> orders;
+    for (size_t i = 0; i < 100; ++i) {
+        orders.push_back(limit(Side::BUY, 1, 90 + static_cast<price_t>(i % 10), std::to_string(i).c_str()));
+    }
+    set_id_generator(counting_generator);
+    generated = 0;
+    for (auto &order: orders) {
+        book.add(std::move(order));
+    }
+    REQUIRE(book.cancel("5"));
+    book.add(limit(Side::BUY, 1, 95, "again"));
+    set_id_generator(nullptr);
+    REQUIRE(generated == 0);
+    REQUIRE(book.size() == 100);
+    REQUIRE(book.find("again")->limit_price == 95);
+    REQUIRE(book.volume_at(Side::BUY, 95) == 10);
+}
+
+TEST_CASE("Order book executions feed positions", "[OrderBook]") {
+    OrderBook book(btc());
+    trading::position::Position buyer;
+    trading::position::Position seller;
+    book.on_fill([&buyer, &seller](const Fill &fill) {
+        buyer.set_current_price(fill.price);
+        seller.set_current_price(fill.price);
+        REQUIRE(buyer.apply_order(fill.taker_execution()).success);
+        REQUIRE(seller.apply_order(fill.maker_execution()).success);
+    });
+
+    book.add(limit(Side::SELL, 3, 100, "a1"));
+    book.add(limit(Side::SELL, 3, 110, "a2"));
+    book.add(market(Side::BUY, 4, "b1"));
+
+    REQUIRE(buyer.side == trading::position::Side::LONG);
+    REQUIRE(buyer.balance == 4);
+    REQUIRE(buyer.entry_price == (100.0 * 3 + 110.0) / 4);
+    REQUIRE(seller.side == trading::position::Side::SHORT);
+    REQUIRE(seller.balance == 4);
+}
+
+TEST_CASE("Order book with fixed prices", "[OrderBook]") {
+    using Price = FixedPrice<2>;
+    BasicOrderBook<Price> book(btc());
+    auto order = [](Side side, size_t quantity, double price, const char *id) {
+        return BasicOrder<Price>(100, quantity, btc(), side, 0, Price{}, Price::from_double(price), id,
+                                 Type::LIMIT, Status::OPEN);
+    };
+
+    book.add(order(Side::SELL, 1, 100.01, "a1"));
+    book.add(order(Side::SELL, 2, 100.02, "a2"));
+    auto result = book.add(order(Side::BUY, 3, 100.02, "b1"));
+    REQUIRE(result.filled == 3);
+    REQUIRE(book.empty());
+    REQUIRE(book.best_ask() == Price{});
+}
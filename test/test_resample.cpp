@@ -0,0 +1,106 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/resample.h"
+#include "trading_common/aggregator.h"
+#include "nlohmann/json.hpp"
+
+using namespace trading::common;
+using json = nlohmann::json;
+
+namespace {
+    ColumnarSeriesOHLCV minute_series(timestamp_t start, size_t count) {
+        ColumnarSeriesOHLCV series(std::make_shared<std::string>("AAPL"));
+        for (size_t i = 0; i < count; ++i) {
+            double base = 100.0 + (double) (i % 17);
+            series.insert(ColumnarSeriesOHLCV::Bar{start + i * 60, base, base + 1 + (double) (i % 5),
+                                                   base - 1 - (double) (i % 3), base + 0.5, i + 1});
+        }
+        return series;
+    }
+}
+
+TEST_CASE("Resample to coarser timeframes", "[Resample]") {
+    auto series = minute_series(1704495600, 1000);
+
+    SECTION("Minute to five minutes") {
+        auto result = resample(series, timeframes::FIVE_MINUTES);
+        REQUIRE(result.size() == 200);
+        REQUIRE(*result.symbol() == "AAPL");
+        for (size_t b = 0; b < result.size(); ++b) {
+            auto bar = result.at(b);
+            REQUIRE(bar.timestamp == 1704495600 + b * 300);
+            REQUIRE(bar.open == series.open()[b * 5]);
+            REQUIRE(bar.close == series.close()[b * 5 + 4]);
+            double high = series.high()[b * 5], low = series.low()[b * 5];
+            size_t volume = 0;
+            for (size_t i = b * 5; i < b * 5 + 5; ++i) {
+                high = std::max(high, series.high()[i]);
+                low = std::min(low, series.low()[i]);
+                volume += series.volume()[i];
+            }
+            REQUIRE(bar.high == high);
+            REQUIRE(bar.low == low);
+            REQUIRE(bar.volume == volume);
+        }
+    }
+
+    SECTION("Long buckets use the vector reductions") {
+        auto result = resample(series, timeframes::HOUR);
+        REQUIRE(result.size() == 17);
+        auto columns = series.columns();
+        REQUIRE(result.at(0).high == *std::max_element(columns.high.begin(), columns.high.begin() + 60));
+        REQUIRE(result.at(0).low == *std::min_element(columns.low.begin(), columns.low.begin() + 60));
+        REQUIRE(result.at(0).volume == 60 * 61 / 2);
+    }
+
+    SECTION("Gaps produce no empty bars") {
+        ColumnarSeriesOHLCV sparse;
+        sparse.insert(ColumnarSeriesOHLCV::Bar{0, 1, 2, 0.5, 1.5, 1});
+        sparse.insert(ColumnarSeriesOHLCV::Bar{3600, 2, 3, 1.5, 2.5, 2});
+        auto result = resample(sparse, timeframes::FIVE_MINUTES);
+        REQUIRE(result.size() == 2);
+        REQUIRE(result.timestamps()[1] == 3600);
+    }
+
+    SECTION("Invalid timeframes") {
+        REQUIRE_THROWS_AS(resample(series, 0), OHLCException);
+        REQUIRE_THROWS_AS(resample(series, timeframes::HOUR, Alignment::CALENDAR_DAY), OHLCException);
+    }
+
+    SECTION("Empty series") {
+        REQUIRE(resample(ColumnarSeriesOHLCV(), timeframes::HOUR).empty());
+    }
+}
+
+TEST_CASE("Resample to calendar days", "[Resample]") {
+    auto series = minute_series(1704495600, 60 * 24 * 3 + 30);
+    auto result = resample(series, timeframes::DAY, Alignment::CALENDAR_DAY);
+
+    SECTION("One bar per local date") {
+        REQUIRE(result.size() == 4);
+        size_t index = 0;
+        size_t total_volume = 0;
+        for (size_t b = 0; b < result.size(); ++b) {
+            auto day = epoch_to_date_string((long long) result.timestamps()[b]);
+            size_t volume = 0;
+            while (index < series.size() && epoch_to_date_string((long long) series.timestamps()[index]) == day) {
+                volume += series.volume()[index++];
+            }
+            REQUIRE(result.volume()[b] == volume);
+            total_volume += volume;
+        }
+        REQUIRE(index == series.size());
+        REQUIRE(total_volume == (series.size() * (series.size() + 1)) / 2);
+    }
+
+    SECTION("SeriesOHLCV overload") {
+        SeriesOHLCV map_series = series.to_series();
+        auto map_result = resample(map_series, timeframes::DAY, Alignment::CALENDAR_DAY);
+        REQUIRE(map_result.to_json() == result.to_json());
+    }
+}
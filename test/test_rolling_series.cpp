@@ -0,0 +1,129 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/rolling_series.h"
+
+using namespace trading::common;
+
+namespace {
+    RollingSeriesOHLCV::Bar bar_at(timestamp_t timestamp) {
+        auto price = static_cast<double>(timestamp);
+        return {timestamp, price, price + 1, price - 1, price + 0.5, static_cast<size_t>(timestamp * 10)};
+    }
+
+    std::vector<timestamp_t> timestamps(const RollingSeriesOHLCV &series) {
+        std::vector<timestamp_t> result;
+        for (auto it = series.begin(); it != series.end(); ++it) {
+            result.push_back((*it).first);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("RollingSeriesOHLCV keeps the last bars", "[RollingSeriesOHLCV]") {
+    RollingSeriesOHLCV series(4, symbol_t("ROLL"));
+    REQUIRE(series.capacity() == 4);
+    REQUIRE(series.empty());
+    REQUIRE(*series.symbol() == "ROLL");
+
+    SECTION("Filling up") {
+        for (timestamp_t t = 1; t <= 3; ++t) {
+            REQUIRE(series.insert(bar_at(t)));
+        }
+        REQUIRE(series.size() == 3);
+        REQUIRE_FALSE(series.full());
+        REQUIRE(timestamps(series) == std::vector<timestamp_t>{1, 2, 3});
+        REQUIRE(series.segments()[1].empty());
+    }
+
+    SECTION("Eviction") {
+        for (timestamp_t t = 1; t <= 10; ++t) {
+            REQUIRE(series.insert(bar_at(t)));
+        }
+        REQUIRE(series.size() == 4);
+        REQUIRE(series.full());
+        REQUIRE(timestamps(series) == std::vector<timestamp_t>{7, 8, 9, 10});
+        REQUIRE(series.front().timestamp == 7);
+        REQUIRE(series.back().close == 10.5);
+        REQUIRE(series.at(1).volume == 80);
+    }
+
+    SECTION("Same bar semantics as SeriesOHLCV") {
+        for (timestamp_t t = 10; t <= 50; t += 10) {
+            series.insert(bar_at(t));
+        }
+        auto changed = bar_at(30);
+        changed.close = -1;
+        REQUIRE(series.insert(changed));
+        REQUIRE(series.find(30)->close == 30.5);
+        // older than the window, or a gap inside it, cannot be inserted in O(1)
+        REQUIRE_FALSE(series.insert(bar_at(5)));
+        REQUIRE_FALSE(series.insert(bar_at(35)));
+        REQUIRE(series.size() == 4);
+    }
+
+    SECTION("Reverse iteration") {
+        for (timestamp_t t = 1; t <= 6; ++t) {
+            series.insert(bar_at(t));
+        }
+        std::vector<timestamp_t> reversed;
+        for (auto it = series.rbegin(); it != series.rend(); --it) {
+            reversed.push_back((*it).first);
+        }
+        REQUIRE(reversed == std::vector<timestamp_t>{6, 5, 4, 3});
+    }
+
+    SECTION("Clear") {
+        series.insert(bar_at(1));
+        series.clear();
+        REQUIRE(series.empty());
+        REQUIRE_THROWS_AS(series.front(), OHLCException);
+        REQUIRE_THROWS_AS(series.back(), OHLCException);
+        REQUIRE(series.insert(bar_at(1)));
+        REQUIRE(series.back().timestamp == 1);
+    }
+
+    SECTION("Zero capacity") {
+        REQUIRE_THROWS_AS(RollingSeriesOHLCV(0), OHLCException);
+    }
+}
+
+TEST_CASE("RollingSeriesOHLCV segments and lookups", "[RollingSeriesOHLCV]") {
+    RollingSeriesOHLCV series(5);
+    for (timestamp_t t = 100; t <= 800; t += 100) {
+        series.insert(OHLCV(symbol_t("SEG"), t, 1, 2, 0.5, 1.5, t));
+    }
+    REQUIRE(*series.symbol() == "SEG");
+
+    SECTION("Two segments in order") {
+        auto [older, newer] = series.segments();
+        REQUIRE(older.size() + newer.size() == 5);
+        REQUIRE(older.size() == 2);
+        REQUIRE(older.timestamp[0] == 400);
+        REQUIRE(newer.timestamp[0] == 600);
+        REQUIRE(newer.timestamp[2] == 800);
+        REQUIRE(newer.volume[2] == 800);
+    }
+
+    SECTION("find and as_of across the wrap") {
+        for (timestamp_t t = 400; t <= 800; t += 100) {
+            REQUIRE(series.find(t)->timestamp == t);
+            REQUIRE(series.as_of(t + 50)->timestamp == t);
+        }
+        REQUIRE_FALSE(series.find(300));
+        REQUIRE_FALSE(series.find(650));
+        REQUIRE_FALSE(series.as_of(399));
+        REQUIRE(series.as_of(10'000)->timestamp == 800);
+    }
+
+    SECTION("Conversions") {
+        auto columnar = series.to_columnar();
+        REQUIRE(columnar.size() == 5);
+        REQUIRE(columnar.timestamps()[0] == 400);
+        REQUIRE(columnar.timestamps()[4] == 800);
+        REQUIRE(columnar.to_json() == series.to_json());
+    }
+}
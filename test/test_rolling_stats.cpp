@@ -0,0 +1,265 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "trading_common/rolling_stats.h"
+#include <cmath>
+#include <random>
+
+using namespace trading::indicators;
+using namespace trading::common;
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+    std::vector<Bar> random_bars(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0, 1);
+        std::uniform_real_distribution<double> spread(0, 2);
+        std::uniform_int_distribution<size_t> volume(0, 1000);
+        std::vector<Bar> bars;
+        double close = 100;
+        for (size_t i = 0; i < count; ++i) {
+            double open = close;
+            close = std::max(1.0, close + step(rng));
+            double high = std::max(open, close) + spread(rng);
+            double low = std::min(open, close) - spread(rng);
+            bars.push_back({1000 + i * 60, open, high, low, close, volume(rng)});
+        }
+        return bars;
+    }
+
+    // window of the bars [end - period, end), shorter at the start
+    size_t window_begin(size_t end, size_t period) {
+        return end > period ? end - period : 0;
+    }
+
+    double naive_variance(const std::vector<double> &values, size_t end, size_t period, size_t correction = 0) {
+        size_t begin = window_begin(end, period);
+        double mean = 0;
+        for (size_t i = begin; i < end; ++i) {
+            mean += values[i];
+        }
+        mean /= static_cast<double>(end - begin);
+        double sum = 0;
+        for (size_t i = begin; i < end; ++i) {
+            sum += (values[i] - mean) * (values[i] - mean);
+        }
+        return sum / static_cast<double>(end - begin - correction);
+    }
+
+    double naive_vwap(const std::vector<Bar> &bars, size_t end, size_t period) {
+        double value = 0;
+        double volume = 0;
+        for (size_t i = window_begin(end, period); i < end; ++i) {
+            value += (bars[i].high + bars[i].low + bars[i].close) / 3 * static_cast<double>(bars[i].volume);
+            volume += static_cast<double>(bars[i].volume);
+        }
+        return value / volume;
+    }
+}
+
+TEST_CASE("Rolling variance", "[RollingStats]") {
+    auto bars = random_bars(500, 1);
+    std::vector<double> closes;
+    for (auto &bar: bars) {
+        closes.push_back(bar.close);
+    }
+    RollingVariance variance(20);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        variance.update(bars[i]);
+        REQUIRE(variance.ready() == (i + 1 >= 20));
+        REQUIRE_THAT(variance.variance(), WithinAbs(naive_variance(closes, i + 1, 20), 1e-9));
+        if (i > 0) {
+            REQUIRE_THAT(variance.sample_variance(), WithinAbs(naive_variance(closes, i + 1, 20, 1), 1e-9));
+        }
+    }
+    REQUIRE(variance.count() == bars.size());
+    REQUIRE_THAT(variance.stddev(), WithinAbs(std::sqrt(naive_variance(closes, bars.size(), 20)), 1e-9));
+
+    SECTION("Tiny spread on a large price") {
+        RollingVariance stable(10);
+        std::vector<double> values;
+        for (int i = 0; i < 1005; ++i) {
+            values.push_back(1e9 + (i % 2) * 1e-3);
+            stable.update(values.back());
+        }
+        REQUIRE_THAT(stable.variance(), WithinRel(naive_variance(values, values.size(), 10), 1e-6));
+        REQUIRE(stable.variance() > 0);
+    }
+
+    SECTION("Zero period") {
+        REQUIRE_THROWS_AS(RollingVariance(0), IndicatorException);
+    }
+}
+
+TEST_CASE("Rolling extremes and Donchian channel", "[RollingStats]") {
+    auto bars = random_bars(500, 2);
+    for (size_t period: {1, 2, 7, 50}) {
+        RollingMax highest(period);
+        RollingMin lowest(period);
+        Donchian channel(period);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            highest.update(bars[i]);
+            lowest.update(bars[i].low);
+            channel.update(bars[i]);
+            double high = bars[i].high;
+            double low = bars[i].low;
+            for (size_t j = window_begin(i + 1, period); j <= i; ++j) {
+                high = std::max(high, bars[j].high);
+                low = std::min(low, bars[j].low);
+            }
+            REQUIRE(highest.value() == high);
+            REQUIRE(lowest.value() == low);
+            REQUIRE(channel.upper() == high);
+            REQUIRE(channel.lower() == low);
+            REQUIRE(channel.middle() == (high + low) / 2);
+        }
+    }
+
+    SECTION("Monotonic input keeps the deque bounded") {
+        RollingMin lowest(3);
+        for (int i = 0; i < 100; ++i) {
+            lowest.update(static_cast<price_t>(i));
+        }
+        REQUIRE(lowest.value() == 97);
+        RollingMax highest(3);
+        for (int i = 100; i > 0; --i) {
+            highest.update(static_cast<price_t>(i));
+        }
+        REQUIRE(highest.value() == 3);
+    }
+}
+
+TEST_CASE("Volume weighted average price", "[RollingStats]") {
+    auto bars = random_bars(300, 3);
+
+    SECTION("Rolling window") {
+        VWAP vwap(30);
+        for (size_t i = 0; i < bars.size(); ++i) {
+            vwap.update(bars[i]);
+            REQUIRE_THAT(vwap.value(), WithinAbs(naive_vwap(bars, i + 1, 30), 1e-9));
+        }
+        REQUIRE(vwap.ready());
+    }
+
+    SECTION("No volume falls back to the typical price") {
+        VWAP vwap(3);
+        vwap.update(Bar{60, 1, 4, 1, 4, 0});
+        REQUIRE(vwap.value() == 3);
+        REQUIRE(vwap.volume() == 0);
+    }
+
+    SECTION("Session restarts at local midnight") {
+        // UTC+2: the local day of 2024-01-06 starts at 2024-01-05T22:00:00Z
+        SessionVWAP vwap(TimeZone::fixed(2 * 3600));
+        timestamp_t midnight = 1704492000;
+        vwap.update(Bar{midnight - 60, 10, 10, 10, 10, 100});
+        vwap.update(Bar{midnight - 30, 20, 20, 20, 20, 300});
+        REQUIRE(vwap.value() == 17.5);
+        REQUIRE(vwap.count() == 2);
+        vwap.update(Bar{midnight, 30, 30, 30, 30, 50});
+        REQUIRE(vwap.value() == 30);
+        REQUIRE(vwap.count() == 1);
+        REQUIRE(vwap.volume() == 50);
+
+        // revising the first bar of a session keeps the session
+        vwap.revise(Bar{midnight, 40, 40, 40, 40, 50});
+        REQUIRE(vwap.value() == 40);
+        vwap.reset();
+        REQUIRE_FALSE(vwap.ready());
+    }
+}
+
+TEST_CASE("Realized volatility", "[RollingStats]") {
+    auto bars = random_bars(300, 4);
+    std::vector<double> returns;
+    for (size_t i = 1; i < bars.size(); ++i) {
+        returns.push_back(std::log(bars[i].close / bars[i - 1].close));
+    }
+    RealizedVolatility volatility(20, 252);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        volatility.update(bars[i]);
+        REQUIRE(volatility.ready() == (i >= 20));
+        if (i >= 2) {
+            REQUIRE_THAT(volatility.value(), WithinAbs(std::sqrt(naive_variance(returns, i, 20, 1) * 252), 1e-9));
+        }
+    }
+    REQUIRE_THROWS_AS(RealizedVolatility(1), IndicatorException);
+}
+
+TEST_CASE("Revising the last bar of rolling statistics", "[RollingStats]") {
+    auto bars = random_bars(400, 5);
+    auto revised = random_bars(400, 6);
+
+    // feed a wrong version of every bar first and then revise it; the result must match a clean run
+    RollingVariance variance[2]{RollingVariance(15), RollingVariance(15)};
+    RollingMax highest[2]{RollingMax(15), RollingMax(15)};
+    RollingMin lowest[2]{RollingMin(15), RollingMin(15)};
+    VWAP vwap[2]{VWAP(15), VWAP(15)};
+    SessionVWAP session[2]{SessionVWAP(), SessionVWAP()};
+    RealizedVolatility volatility[2]{RealizedVolatility(15), RealizedVolatility(15)};
+    auto feed = [&](size_t k, const Bar &bar, bool revise) {
+        if (revise) {
+            variance[k].revise(bar);
+            highest[k].revise(bar);
+            lowest[k].revise(bar);
+            vwap[k].revise(bar);
+            session[k].revise(bar);
+            volatility[k].revise(bar);
+        } else {
+            variance[k].update(bar);
+            highest[k].update(bar);
+            lowest[k].update(bar);
+            vwap[k].update(bar);
+            session[k].update(bar);
+            volatility[k].update(bar);
+        }
+    };
+    for (size_t i = 0; i < bars.size(); ++i) {
+        feed(0, bars[i], false);
+        Bar draft = revised[i];
+        draft.timestamp = bars[i].timestamp;
+        feed(1, draft, false);
+        feed(1, draft, true);
+        feed(1, bars[i], true);
+
+        REQUIRE_THAT(variance[1].variance(), WithinAbs(variance[0].variance(), 1e-9));
+        REQUIRE(highest[1].value() == highest[0].value());
+        REQUIRE(lowest[1].value() == lowest[0].value());
+        REQUIRE_THAT(vwap[1].value(), WithinAbs(vwap[0].value(), 1e-9));
+        REQUIRE_THAT(session[1].value(), WithinAbs(session[0].value(), 1e-9));
+        REQUIRE_THAT(volatility[1].value(), WithinAbs(volatility[0].value(), 1e-9));
+    }
+}
+
+TEST_CASE("Rolling statistics inputs", "[RollingStats]") {
+    auto bars = random_bars(120, 7);
+    ColumnarSeriesOHLCV series(symbol_t("IDX"));
+    for (auto &bar: bars) {
+        series.insert(bar);
+    }
+
+    VWAP from_columns(10);
+    VWAP from_map(10);
+    replay(from_columns, series.columns());
+    replay(from_map, series.to_series());
+    REQUIRE(from_columns.value() == from_map.value());
+    REQUIRE_THAT(from_columns.value(), WithinAbs(naive_vwap(bars, bars.size(), 10), 1e-9));
+
+    SECTION("Aggregator callback") {
+        RollingMax highest(2);
+        BarAggregator aggregator(symbol_t("IDX"), {timeframes::SECOND, timeframes::MINUTE});
+        aggregator.on_bar(callback(highest, timeframes::MINUTE));
+        for (timestamp_t t = 0; t < 5 * 60; t += 10) {
+            aggregator.add(t, static_cast<price_t>(10 - t / 60), 1);
+        }
+        aggregator.flush();
+        // highs of the minutes are 10, 9, 8, 7, 6
+        REQUIRE(highest.ready());
+        REQUIRE(highest.value() == 7);
+    }
+}
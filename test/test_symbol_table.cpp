@@ -0,0 +1,140 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/symbol_table.h"
+#include "trading_common/ohlc.h"
+#include "trading_common/pnl.h"
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace trading::common;
+
+TEST_CASE("Interning symbols", "[SymbolTable]") {
+    SymbolTable table;
+
+    SECTION("Empty symbol is id 0") {
+        REQUIRE(table.size() == 1);
+        REQUIRE(table.intern("") == 0);
+        REQUIRE(table.name(0).empty());
+    }
+
+    SECTION("Same name gives the same id") {
+        symbol_id_t aapl = table.intern("AAPL");
+        symbol_id_t msft = table.intern("MSFT");
+        REQUIRE(aapl == 1);
+        REQUIRE(msft == 2);
+        REQUIRE(table.intern(std::string("AAPL")) == aapl);
+        REQUIRE(table.name(aapl) == "AAPL");
+        REQUIRE(table.name(msft) == "MSFT");
+        REQUIRE(table.size() == 3);
+    }
+
+    SECTION("Find does not intern") {
+        REQUIRE_FALSE(table.find("BTC").has_value());
+        REQUIRE(table.size() == 1);
+        symbol_id_t btc = table.intern("BTC");
+        REQUIRE(table.find("BTC") == btc);
+    }
+
+    SECTION("Unknown id has an empty name") {
+        REQUIRE(table.name(1000).empty());
+    }
+
+    SECTION("Names stay valid while the table grows") {
+        const std::string &first = table.name(table.intern("FIRST"));
+        for (size_t i = 0; i < 3 * SymbolTable::CHUNK_SIZE; ++i) {
+            table.intern("SYM" + std::to_string(i));
+        }
+        REQUIRE(first == "FIRST");
+        REQUIRE(table.name(*table.find("SYM2000")) == "SYM2000");
+    }
+}
+
+TEST_CASE("Interning from several threads", "[SymbolTable]") {
+    SymbolTable table;
+    constexpr size_t THREADS = 4;
+    constexpr size_t NAMES = 2000;
+    std::vector<std::vector<symbol_id_t>> ids(THREADS, std::vector<symbol_id_t>(NAMES));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < NAMES; ++i) {
+                ids[t][i] = table.intern("SYM" + std::to_string(i));
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    REQUIRE(table.size() == NAMES + 1);
+    for (size_t t = 1; t < THREADS; ++t) {
+        REQUIRE(ids[t] == ids[0]);
+    }
+    for (size_t i = 0; i < NAMES; ++i) {
+        REQUIRE(table.name(ids[0][i]) == "SYM" + std::to_string(i));
+    }
+}
+
+TEST_CASE("Interned symbol handle", "[SymbolTable]") {
+    SECTION("Default is the empty symbol") {
+        symbol_t symbol;
+        REQUIRE(symbol.id() == 0);
+        REQUIRE(symbol->empty());
+        REQUIRE(symbol);
+        REQUIRE(symbol != nullptr);
+    }
+
+    SECTION("Null handle") {
+        symbol_t symbol = nullptr;
+        REQUIRE_FALSE(symbol);
+        REQUIRE(symbol == nullptr);
+        REQUIRE(symbol->empty());
+        REQUIRE(symbol_t(std::shared_ptr<std::string>()) == nullptr);
+    }
+
+    SECTION("Compares by id") {
+        symbol_t a("ETH");
+        symbol_t b = std::make_shared<std::string>("ETH");
+        symbol_t c(std::string("SOL"));
+        REQUIRE(a == b);
+        REQUIRE(a != c);
+        REQUIRE(*a == "ETH");
+        REQUIRE(a->size() == 3);
+        REQUIRE(symbol_t::from_id(a.id()) == a);
+        REQUIRE(sizeof(symbol_t) == sizeof(symbol_id_t));
+    }
+
+    SECTION("Hashes by id") {
+        std::unordered_set<symbol_t> set{symbol_t("ETH"), symbol_t("SOL"), symbol_t("ETH")};
+        REQUIRE(set.size() == 2);
+        REQUIRE(set.count(symbol_t("SOL")) == 1);
+    }
+
+    SECTION("Json round trip keeps the id") {
+        Symbol symbol(symbol_t("ADA"));
+        json j = symbol.to_json();
+        REQUIRE(j["symbol"] == "ADA");
+        Symbol parsed(j);
+        REQUIRE(parsed.symbol == symbol.symbol);
+    }
+}
+
+TEST_CASE("PnL positions keyed by symbol id", "[SymbolTable]") {
+    trading::pnl::PnL pnl;
+    trading::position::Position position;
+    position.symbol = symbol_t("XRP");
+    position.side = trading::position::Side::LONG;
+    position.balance = 10;
+    position.entry_price = 1;
+    position.current_price = 2;
+    pnl.add_position(position);
+    double total = pnl.calculate_total_value();
+    pnl.delete_position(symbol_value_t("NEVER_SEEN"));
+    REQUIRE(pnl.calculate_total_value() == total);
+    pnl.delete_position(symbol_value_t("XRP"));
+    REQUIRE(pnl.calculate_total_value() == 0);
+}
@@ -0,0 +1,196 @@
+//
+// Created by Joaquin Bejar Garcia on 17/10/26.
+//
+
+
+#include <catch2/catch_test_macros.hpp>
+#include "trading_common/wire_format.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace trading::common;
+using Order = trading::order::Order;
+using Position = trading::position::Position;
+
+TEST_CASE("Wire format round trips", "[wire]") {
+    std::vector<unsigned char> buffer(256);
+    symbol_t symbol("AAPL");
+
+    SECTION("OHLCV") {
+        OHLCV bar(symbol, 1704495600, 1.5, std::numeric_limits<double>::infinity(), -0.0, 1.0 / 3,
+                  std::numeric_limits<size_t>::max());
+        size_t size = wire::encode(bar, buffer);
+        REQUIRE(size == wire::encoded_size(bar));
+        REQUIRE(size == wire::HEADER_SIZE + 50 + 4);
+        REQUIRE(wire::peek(buffer) == wire::Kind::OHLCV);
+        REQUIRE(wire::message_size(buffer) == size);
+        // little-endian whatever the host: the timestamp starts with its low byte
+        REQUIRE(buffer[wire::HEADER_SIZE] == (1704495600 & 0xff));
+
+        OHLCV decoded(symbol_t("MSFT"), 1, 0, 0, 0, 0, 0);
+        REQUIRE(wire::decode(std::span<const unsigned char>(buffer.data(), size), decoded) == size);
+        REQUIRE(decoded.symbol == symbol);
+        REQUIRE(decoded.timestamp == bar.timestamp);
+        REQUIRE(decoded.date.empty());
+        REQUIRE(decoded.open == 1.5);
+        REQUIRE(std::isinf(decoded.high));
+        REQUIRE(std::signbit(decoded.low));
+        REQUIRE(decoded.close == bar.close);
+        REQUIRE(decoded.volume == bar.volume);
+    }
+
+    SECTION("Order") {
+        Order order(1704495600, 200, symbol, trading::order::Side::SELL, 150, 101.25, 101.25, "order-1",
+                    trading::order::Type::LIMIT, trading::order::Status::FILLED);
+        size_t size = wire::encode(order, buffer);
+        REQUIRE(wire::peek(buffer) == wire::Kind::ORDER);
+        Order decoded;
+        REQUIRE(wire::decode(buffer, decoded) == size);
+        REQUIRE(decoded.to_json() == order.to_json());
+    }
+
+    SECTION("Position") {
+        Position position("position-1", 1704495600, 10, symbol, trading::position::Side::SHORT, 100.5, 99.25,
+                          12.5);
+        size_t size = wire::encode(position, buffer);
+        REQUIRE(wire::peek(buffer) == wire::Kind::POSITION);
+        Position decoded;
+        REQUIRE(wire::decode(buffer, decoded) == size);
+        REQUIRE(decoded.to_json() == position.to_json());
+    }
+
+    SECTION("Messages follow each other in one buffer") {
+        OHLCV bar(symbol, 60, 1, 2, 0.5, 1.5, 10);
+        Order order;
+        order.symbol = symbol;
+        size_t first = wire::encode(bar, buffer);
+        size_t second = wire::encode(order, std::span<unsigned char>(buffer).subspan(first));
+        std::span<const unsigned char> rest(buffer.data(), first + second);
+        REQUIRE(wire::peek(rest) == wire::Kind::OHLCV);
+        rest = rest.subspan(wire::message_size(rest));
+        REQUIRE(wire::peek(rest) == wire::Kind::ORDER);
+        Order decoded;
+        REQUIRE(wire::decode(rest, decoded) == second);
+        REQUIRE(decoded.id == order.id);
+    }
+
+    SECTION("FixedPrice prices travel as ticks") {
+        using Cents = FixedPrice<2>;
+        trading::order::BasicOrder<Cents> order(1, 5, symbol, trading::order::Side::BUY, 5,
+                                                Cents::from_ticks(10125), Cents(), "1",
+                                                trading::order::Type::MARKET, trading::order::Status::FILLED);
+        size_t size = wire::encode(order, buffer);
+        trading::order::BasicOrder<Cents> decoded;
+        REQUIRE(wire::decode(buffer, decoded) == size);
+        REQUIRE(decoded.filled_at_price == Cents::from_ticks(10125));
+
+        Order as_double;
+        REQUIRE_THROWS_AS(wire::decode(buffer, as_double), OHLCException);
+    }
+}
+
+TEST_CASE("Wire format rejects bad input", "[wire]") {
+    std::vector<unsigned char> buffer(256);
+    OHLCV bar(symbol_t("AAPL"), 60, 1, 2, 0.5, 1.5, 10);
+    size_t size = wire::encode(bar, buffer);
+
+    SECTION("Buffers that are too small") {
+        std::vector<unsigned char> small(size - 1);
+        REQUIRE_THROWS_AS(wire::encode(bar, small), OHLCException);
+        OHLCV decoded;
+        REQUIRE_THROWS_AS(wire::decode(std::span<const unsigned char>(buffer.data(), size - 1), decoded),
+                          OHLCException);
+        REQUIRE_THROWS_AS(wire::peek(std::span<const unsigned char>(buffer.data(), 4)), OHLCException);
+    }
+
+    SECTION("Another kind or version") {
+        Order order;
+        REQUIRE_THROWS_AS(wire::decode(buffer, order), OHLCException);
+        buffer[1] = wire::VERSION + 1;
+        OHLCV decoded;
+        REQUIRE_THROWS_AS(wire::decode(buffer, decoded), OHLCException);
+    }
+
+    SECTION("Reserved header byte") {
+        buffer[3] = 1;
+        OHLCV decoded;
+        REQUIRE_THROWS_AS(wire::decode(buffer, decoded), OHLCException);
+        REQUIRE_THROWS_AS(wire::peek(buffer), OHLCException);
+    }
+
+    SECTION("Symbols longer than the cap") {
+        std::string longest(wire::MAX_SYMBOL_LENGTH, 'S');
+        OHLCV too_long(symbol_t(longest + "S"), 60, 1, 2, 0.5, 1.5, 10);
+        REQUIRE_THROWS_AS(wire::encode(too_long, buffer), OHLCException);
+
+        // a message from elsewhere with one byte more than the cap
+        OHLCV longest_bar(symbol_t(longest), 60, 1, 2, 0.5, 1.5, 10);
+        size = wire::encode(longest_bar, buffer);
+        buffer[size] = 'S';
+        buffer[wire::HEADER_SIZE + 48] = static_cast<unsigned char>(wire::MAX_SYMBOL_LENGTH + 1);
+        buffer[4] = static_cast<unsigned char>(size + 1);
+        OHLCV decoded(symbol_t("MSFT"), 120, 3, 4, 2, 3.5, 20);
+        REQUIRE_THROWS_AS(wire::decode(buffer, decoded), OHLCException);
+        REQUIRE(*decoded.symbol == "MSFT");
+        REQUIRE(decoded.timestamp == 120);
+
+        buffer[wire::HEADER_SIZE + 48] = static_cast<unsigned char>(wire::MAX_SYMBOL_LENGTH);
+        buffer[4] = static_cast<unsigned char>(size);
+        REQUIRE(wire::decode(buffer, decoded) == size);
+        REQUIRE(decoded.symbol == longest_bar.symbol);
+    }
+
+    SECTION("Corrupt fields") {
+        Order order;
+        order.symbol = symbol_t("AAPL");
+        size = wire::encode(order, buffer);
+        // side, type and status follow the header and the five 8 byte fields
+        buffer[wire::HEADER_SIZE + 40] = 7;
+        REQUIRE_THROWS_AS(wire::decode(buffer, order), OHLCException);
+
+        size = wire::encode(bar, buffer);
+        // a symbol length past the end of the message
+        buffer[wire::HEADER_SIZE + 48] = 200;
+        OHLCV decoded;
+        REQUIRE_THROWS_AS(wire::decode(buffer, decoded), OHLCException);
+    }
+
+    SECTION("A failed decode leaves the target as it was") {
+        size = wire::encode(bar, buffer);
+        buffer[wire::HEADER_SIZE + 48] = 200;
+        OHLCV decoded(symbol_t("MSFT"), 120, 3, 4, 2, 3.5, 20);
+        REQUIRE_THROWS_AS(wire::decode(buffer, decoded), OHLCException);
+        REQUIRE(decoded.timestamp == 120);
+        REQUIRE(decoded.open == 3);
+        REQUIRE(decoded.volume == 20);
+        REQUIRE(*decoded.symbol == "MSFT");
+
+        using namespace trading::order;
+        Order sent(60, 5, symbol_t("AAPL"), Side::BUY, 0, 0, 100, "o-1", Type::LIMIT, Status::OPEN);
+        wire::encode(sent, buffer);
+        // a valid side, then an invalid status
+        buffer[wire::HEADER_SIZE + 42] = 9;
+        Order order(7, 1, symbol_t("MSFT"), Side::SELL, 0, 0, 0, "o-2", Type::MARKET, Status::OPEN);
+        REQUIRE_THROWS_AS(wire::decode(buffer, order), OHLCException);
+        REQUIRE(order.timestamp == 7);
+        REQUIRE(order.quantity == 1);
+        REQUIRE(order.side == Side::SELL);
+        REQUIRE(order.type == Type::MARKET);
+        REQUIRE(order.id == "o-2");
+
+        Position position;
+        position.balance = 3;
+        position.side = trading::position::Side::LONG;
+        wire::encode(position, buffer);
+        // the side follows the header and five 8 byte fields; the string lengths are checked after it
+        buffer[wire::HEADER_SIZE + 41] = 0xff;
+        buffer[wire::HEADER_SIZE + 42] = 0xff;
+        Position target;
+        target.balance = 9;
+        REQUIRE_THROWS_AS(wire::decode(buffer, target), OHLCException);
+        REQUIRE(target.balance == 9);
+        REQUIRE(target.side == trading::position::Side::NONE);
+    }
+}